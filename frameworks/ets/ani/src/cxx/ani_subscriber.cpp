@@ -57,17 +57,17 @@ void AniPublishedObserver::OnChange(DataShare::PublishedDataChangeNode &changeNo
     rust::Box<PublishedDataChangeNode> node = rust_create_published_data_change_node(
         rust::String(changeNode.ownerBundleName_));
     for (const auto &data : changeNode.datas_) {
-        DataShare::PublishedDataItem::DataType dataItem = data.GetData();
-        if (dataItem.index() == 0) {
-            std::vector std_vec = std::get<std::vector<uint8_t>>(dataItem);
+        if (data.IsAshmem()) {
+            DataShare::BlobSpan span = data.GetBlobSpan();
             rust::Vec<uint8_t> vec;
-            for (auto data: std_vec) {
-                vec.push_back(data);
+            vec.reserve(span.size);
+            for (size_t i = 0; i < span.size; i++) {
+                vec.push_back(span.data[i]);
             }
             published_data_change_node_push_item_arraybuffer(*node, rust::String(data.key_),
                 vec, rust::String(std::to_string(data.subscriberId_)));
         } else {
-            std::string strData = std::get<std::string>(dataItem);
+            const std::string &strData = std::get<std::string>(data.value_);
             published_data_change_node_push_item_str(*node, rust::String(data.key_),
                 rust::String(strData), rust::String(std::to_string(data.subscriberId_)));
         }
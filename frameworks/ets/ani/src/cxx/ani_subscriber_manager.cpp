@@ -293,12 +293,12 @@ void AniPublishedSubscriberManager::Emit(const DataShare::PublishedDataChangeNod
             continue;
         }
         lastChangeNodeMap_.Compute(key, [&data, &changeNode](const Key &, DataShare::PublishedDataChangeNode &value) {
-            value.datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+            value.datas_.emplace_back(data.Clone());
             value.ownerBundleName_ = changeNode.ownerBundleName_;
             return true;
         });
         for (auto const &obs : callbacks) {
-            results[obs].datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+            results[obs].datas_.emplace_back(data.Clone());
         }
     }
     for (auto &[callback, node] : results) {
@@ -313,7 +313,7 @@ void AniPublishedSubscriberManager::Emit(const std::vector<Key> &keys, const std
     for (auto &key : keys) {
         lastChangeNodeMap_.ComputeIfPresent(key, [&node](const Key &, DataShare::PublishedDataChangeNode &value) {
             for (auto &data : value.datas_) {
-                node.datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+                node.datas_.emplace_back(data.Clone());
             }
             node.ownerBundleName_ = value.ownerBundleName_;
             return true;
@@ -1801,7 +1801,7 @@ void DataShareNativeExtensionCallbackInt(double errorCode, rust::string errorMsg
     businessError.SetCode(static_cast<int>(errorCode));
     businessError.SetMessage(std::string(errorMsg));
     resultWrap->businessError_= businessError;
-    resultWrap->isRecvReply_ = true;
+    resultWrap->SetRecvReply();
 }
 
 void DataShareNativeExtensionCallbackObject(double errorCode, rust::string errorMsg, int64_t ptr, int64_t nativePtr)
@@ -1828,7 +1828,7 @@ void DataShareNativeExtensionCallbackObject(double errorCode, rust::string error
     businessError.SetCode(static_cast<int>(errorCode));
     businessError.SetMessage(std::string(errorMsg));
     resultWrap->businessError_= businessError;
-    resultWrap->isRecvReply_ = true;
+    resultWrap->SetRecvReply();
 }
 
 void DataShareNativeExtensionCallbackVoid(double errorCode, rust::string errorMsg, int64_t nativePtr)
@@ -1893,7 +1893,7 @@ void DataShareNativeExtensionCallbackString(double errorCode, rust::String error
     businessError.SetCode(static_cast<int>(errorCode));
     businessError.SetMessage(std::string(errorMsg));
     jsResult->businessError_= businessError;
-    jsResult->isRecvReply_ = true;
+    jsResult->SetRecvReply();
 }
 
 void DataShareNativeExtensionCallbackBatchUpdate(double errorCode, rust::String errorMsg,
@@ -1932,7 +1932,7 @@ void DataShareNativeExtensionCallbackBatchUpdate(double errorCode, rust::String
     businessError.SetMessage(std::string(errorMsg));
     jsResult->businessError_= businessError;
     jsResult->callbackResultNumber_ = E_OK;
-    jsResult->isRecvReply_ = true;
+    jsResult->SetRecvReply();
 }
 
 int ValidateUrisForDataProxy(rust::Vec<rust::String> uris)
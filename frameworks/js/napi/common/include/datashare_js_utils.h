@@ -103,6 +103,7 @@ public:
     static napi_value Convert2JSValue(napi_env env, const std::vector<std::string> &value);
     static napi_value Convert2JSValue(napi_env env, const std::string &value);
     static napi_value Convert2JSValue(napi_env env, const std::vector<uint8_t> &value, bool isTypedArray = true);
+    static napi_value Convert2JSValue(napi_env env, const uint8_t *value, size_t size, bool isTypedArray = true);
     static napi_value Convert2JSValue(napi_env env, int32_t value);
     static napi_value Convert2JSValue(napi_env env, int64_t value);
     static napi_value Convert2JSValue(napi_env env, uint32_t value);
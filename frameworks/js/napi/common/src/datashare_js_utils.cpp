@@ -183,25 +183,30 @@ napi_value DataShareJSUtils::Convert2JSValue(napi_env env, const std::string &va
 }
 
 napi_value DataShareJSUtils::Convert2JSValue(napi_env env, const std::vector<uint8_t> &value, bool isTypedArray)
+{
+    return Convert2JSValue(env, value.data(), value.size(), isTypedArray);
+}
+
+napi_value DataShareJSUtils::Convert2JSValue(napi_env env, const uint8_t *value, size_t size, bool isTypedArray)
 {
     void *native = nullptr;
     napi_value buffer = nullptr;
-    if (value.empty()) {
+    if (value == nullptr || size == 0) {
         LOG_DEBUG("vector is empty");
         return nullptr;
     }
-    napi_status status = napi_create_arraybuffer(env, value.size(), &native, &buffer);
+    napi_status status = napi_create_arraybuffer(env, size, &native, &buffer);
     if (status != napi_ok) {
         return nullptr;
     }
-    if (memcpy_s(native, value.size(), value.data(), value.size()) != EOK && value.size() > 0) {
+    if (memcpy_s(native, size, value, size) != EOK) {
         return nullptr;
     }
     if (!isTypedArray) {
         return buffer;
     }
     napi_value jsValue;
-    status = napi_create_typedarray(env, napi_uint8_array, value.size(), buffer, 0, &jsValue);
+    status = napi_create_typedarray(env, napi_uint8_array, size, buffer, 0, &jsValue);
     if (status != napi_ok) {
         return nullptr;
     }
@@ -457,9 +462,10 @@ napi_value DataShareJSUtils::Convert2JSValue(napi_env env, PublishedDataItem &pu
 
     napi_value data = nullptr;
     if (publishedDataItem.IsAshmem()) {
-        data = Convert2JSValue(env, std::get<std::vector<uint8_t>>(publishedDataItem.GetData()), false);
+        BlobSpan span = publishedDataItem.GetBlobSpan();
+        data = Convert2JSValue(env, span.data, span.size, false);
     } else {
-        data = Convert2JSValue(env, std::get<std::string>(publishedDataItem.GetData()));
+        data = Convert2JSValue(env, std::get<std::string>(publishedDataItem.value_));
     }
     if (data == nullptr) {
         return nullptr;
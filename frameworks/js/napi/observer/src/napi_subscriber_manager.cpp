@@ -232,12 +232,12 @@ void NapiPublishedSubscriberManager::Emit(const PublishedDataChangeNode &changeN
             continue;
         }
         lastChangeNodeMap_.Compute(key, [&data, &changeNode](const Key &, PublishedDataChangeNode &value) {
-            value.datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+            value.datas_.emplace_back(data.Clone());
             value.ownerBundleName_ = changeNode.ownerBundleName_;
             return true;
         });
         for (auto const &obs : callbacks) {
-            results[obs].datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+            results[obs].datas_.emplace_back(data.Clone());
         }
     }
     for (auto &[callback, node] : results) {
@@ -252,7 +252,7 @@ void NapiPublishedSubscriberManager::Emit(const std::vector<Key> &keys, const st
     for (auto &key : keys) {
         lastChangeNodeMap_.ComputeIfPresent(key, [&node](const Key &, PublishedDataChangeNode &value) {
             for (auto &data : value.datas_) {
-                node.datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+                node.datas_.emplace_back(data.Clone());
             }
             node.ownerBundleName_ = value.ownerBundleName_;
             return true;
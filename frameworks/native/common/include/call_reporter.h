@@ -16,8 +16,10 @@
 #ifndef DATASHARE_CALL_REPORTER_H
 #define DATASHARE_CALL_REPORTER_H
 
+#include <array>
+#include <atomic>
 #include <cinttypes>
-#include <concurrent_map.h>
+#include <mutex>
 #include <string>
 
 #include "boot_time_adaptor.h"
@@ -27,26 +29,40 @@ namespace DataShare {
 class DataShareCallReporter {
 public:
     DataShareCallReporter() = default;
-    struct CallInfo {
-        int count = 0;
-        // total count for silent access threshold
-        int totalCount = 0;
-        // start time of every 100 calls
-        int64_t firstTime = 0;
-        // start time of ervery 30s
-        int64_t startTime = 0;
-        // print err log only once by using flag
-        bool logPrintFlag = false;
-    };
     bool Count(const std::string &funcName, const std::string &uri);
 private:
-    ConcurrentMap<std::string, CallInfo> callCounts_;
+    // Calls of one function, every counter packs a start time in ms above COUNT_BITS bits of count,
+    // so it is moved on with a single compare-and-swap.
+    struct CallSlot {
+        std::string funcName;
+        // calls since the last RESET_COUNT_THRESHOLD calls, after the time of the first of them
+        std::atomic<uint64_t> frequency = 0;
+        // calls in the current TIME_THRESHOLD window, after the start time of the window
+        std::atomic<uint64_t> window = 0;
+        // start time of the window the over threshold error was printed in, print err log only once
+        std::atomic<int64_t> loggedWindow = -1;
+    };
+    struct CallResult {
+        int overCount = 0;
+        int64_t firstTime = 0;
+        int64_t windowStart = 0;
+        bool isOverThreshold = false;
+    };
     static constexpr int RESET_COUNT_THRESHOLD = 100;
     static constexpr int ACCESS_COUNT_THRESHOLD = 3000; // silent access threshold
     static constexpr int64_t TIME_THRESHOLD = 30000; // 30s
-    void UpdateCallCounts(const std::string &funcName, int &overCount, int64_t &firstCallTime, bool &isOverThreshold);
+    static constexpr size_t MAX_FUNC_NUM = 64;
+    static constexpr uint64_t COUNT_BITS = 24;
+    static constexpr uint64_t COUNT_MASK = (1ULL << COUNT_BITS) - 1;
+    bool Count(const std::string &funcName, const std::string &uri, int64_t now);
+    CallSlot *GetSlot(const std::string &funcName);
+    void UpdateCallCounts(CallSlot &slot, int64_t now, CallResult &result);
+    // Slots are only appended and never move, lookups scan the published ones without a lock.
+    std::array<CallSlot, MAX_FUNC_NUM> slots_;
+    std::atomic<size_t> slotCount_ = 0;
+    std::mutex slotMutex_;
     BootTimeAdaptor bootTimeAdaptor_;
 };
 } // namespace DataShare
 } // namespace OHOS
-#endif
\ No newline at end of file
+#endif
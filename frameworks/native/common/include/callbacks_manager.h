@@ -16,8 +16,13 @@
 #ifndef DATA_SHARE_CALLBACKS_MANAGER_H
 #define DATA_SHARE_CALLBACKS_MANAGER_H
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 
 #include "datashare_errno.h"
@@ -99,19 +104,98 @@ public:
     bool IsObserversNotifiedOnEnabled(const Key &key, std::shared_ptr<Observer> &observer);
 
 private:
+    using ObserverNodes = std::vector<ObserverNode>;
+    using ObserverNodesPtr = std::shared_ptr<const ObserverNodes>;
+    // Holds the observer list of a key. Writers replace the list with atomic_store, readers take it with atomic_load.
+    struct ObserverSlot {
+        ObserverNodesPtr nodes_ = std::make_shared<const ObserverNodes>();
+    };
+    using ObserverMap = std::map<Key, std::shared_ptr<ObserverSlot>>;
+
     static void DefaultProcess(const std::vector<Key> &, std::vector<OperationResult> &){};
     static void ProxyDataDefaultProcess(const std::vector<Key> &, std::vector<DataProxyResult> &){};
     static void DefaultProcessOnLocalEnabled(std::map<Key, std::vector<ObserverNodeOnEnabled>> &){};
+    static bool HasEnabledObserver(const ObserverNodes &nodes);
+    static bool IsEnabled(const ObserverNode &node);
+    static void StoreNodes(ObserverSlot &slot, std::shared_ptr<ObserverNodes> nodes);
+    ObserverNodesPtr GetObserverNodes(const Key &key);
+    void PublishObservers();
+    void AddLocalObserver(const Key &key, const ObserverNode &node);
+    bool DelLocalObservers(const Key &key, void *subscriber, bool &isLastDel);
     void DelLocalObservers(const Key &key, void *subscriber, std::vector<Key> &lastDelKeys,
         std::vector<OperationResult> &result);
     void DelLocalObservers(const Key &key, void *subscriber, std::vector<Key> &lastDelKeys,
         std::vector<DataProxyResult> &result);
     void DelLocalObservers(void *subscriber, std::vector<Key> &lastDelKeys, std::vector<OperationResult> &result);
     void DelLocalObservers(void *subscriber, std::vector<Key> &lastDelKeys, std::vector<DataProxyResult> &result);
-    std::recursive_mutex mutex_{};
-    std::map<Key, std::vector<ObserverNode>> callbacks_;
+    std::set<Key> TakeSubscriberKeys(void *subscriber);
+    // Writers change callbacks_ under mutex_. Observer lists are never changed in place, a writer stores a modified
+    // copy into the slot of the key. Adding or removing a key publishes a copy of callbacks_ to observers_, so
+    // notifying reads observers_ and the slots without mutex_ and never waits for a subscribe or unsubscribe.
+    std::mutex mutex_{};
+    ObserverMap callbacks_;
+    bool keysChanged_ = false;
+    std::shared_ptr<const ObserverMap> observers_ = std::make_shared<const ObserverMap>();
+    // Keys registered by each subscriber, so removing a subscriber does not visit the keys of the others.
+    std::map<void *, std::set<Key>> subscriberKeys_;
 };
 
+template<class Key, class Observer>
+bool CallbacksManager<Key, Observer>::IsEnabled(const ObserverNode &node)
+{
+    return node.enabled_ && node.observer_ != nullptr;
+}
+
+template<class Key, class Observer>
+bool CallbacksManager<Key, Observer>::HasEnabledObserver(const ObserverNodes &nodes)
+{
+    return std::any_of(nodes.begin(), nodes.end(), [](const ObserverNode &node) { return IsEnabled(node); });
+}
+
+template<class Key, class Observer>
+void CallbacksManager<Key, Observer>::StoreNodes(ObserverSlot &slot, std::shared_ptr<ObserverNodes> nodes)
+{
+    std::atomic_store(&slot.nodes_, ObserverNodesPtr(std::move(nodes)));
+}
+
+template<class Key, class Observer>
+auto CallbacksManager<Key, Observer>::GetObserverNodes(const Key &key) -> ObserverNodesPtr
+{
+    auto observers = std::atomic_load(&observers_);
+    auto it = observers->find(key);
+    if (it == observers->end()) {
+        return nullptr;
+    }
+    return std::atomic_load(&it->second->nodes_);
+}
+
+template<class Key, class Observer>
+void CallbacksManager<Key, Observer>::PublishObservers()
+{
+    if (!keysChanged_) {
+        return;
+    }
+    std::atomic_store(&observers_, std::make_shared<const ObserverMap>(callbacks_));
+    keysChanged_ = false;
+}
+
+template<class Key, class Observer>
+void CallbacksManager<Key, Observer>::AddLocalObserver(const Key &key, const ObserverNode &node)
+{
+    auto &slot = callbacks_[key];
+    if (slot == nullptr) {
+        slot = std::make_shared<ObserverSlot>();
+        keysChanged_ = true;
+    }
+    const ObserverNodes &nodes = *slot->nodes_;
+    auto newNodes = std::make_shared<ObserverNodes>();
+    newNodes->reserve(nodes.size() + 1);
+    newNodes->insert(newNodes->end(), nodes.begin(), nodes.end());
+    newNodes->emplace_back(node);
+    StoreNodes(*slot, std::move(newNodes));
+    subscriberKeys_[node.subscriber_].insert(key);
+}
+
 template<class Key, class Observer>
 std::vector<OperationResult> CallbacksManager<Key, Observer>::AddObservers(const std::vector<Key> &keys,
     void *subscriber, const std::shared_ptr<Observer> observer,
@@ -125,16 +209,17 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::AddObservers(const
     {
         std::lock_guard<decltype(mutex_)> lck(mutex_);
         for (auto &key : keys) {
-            std::vector<std::shared_ptr<Observer>> enabledObservers = GetEnabledObservers(key);
-            if (enabledObservers.empty()) {
-                callbacks_[key].emplace_back(observer, subscriber);
+            auto it = callbacks_.find(key);
+            if (it == callbacks_.end() || !HasEnabledObserver(*it->second->nodes_)) {
+                AddLocalObserver(key, ObserverNode(observer, subscriber));
                 firstRegisterKey.emplace_back(key);
                 continue;
             }
             localRegisterKey.emplace_back(key);
-            callbacks_[key].emplace_back(observer, subscriber);
+            AddLocalObserver(key, ObserverNode(observer, subscriber));
             result.emplace_back(key, E_OK);
         }
+        PublishObservers();
     }
     if (!localRegisterKey.empty()) {
         processOnLocalAdd(localRegisterKey, observer);
@@ -156,8 +241,9 @@ std::vector<DataProxyResult> CallbacksManager<Key, Observer>::AddObservers(const
         for (auto &key : keys) {
             ObserverNode node(observer, subscriber);
             node.config_ = config;
-            callbacks_[key].emplace_back(node);
+            AddLocalObserver(key, node);
         }
+        PublishObservers();
     }
     processOnFirstAdd(keys, observer, result);
     return result;
@@ -167,21 +253,30 @@ template<class Key, class Observer>
 std::vector<Key> CallbacksManager<Key, Observer>::GetKeys()
 {
     std::vector<Key> keys;
-    {
-        std::lock_guard<decltype(mutex_)> lck(mutex_);
-        for (auto &it : callbacks_) {
-            keys.emplace_back(it.first);
-        }
+    for (auto &it : *std::atomic_load(&observers_)) {
+        keys.emplace_back(it.first);
     }
     return keys;
 }
 
+template<class Key, class Observer>
+std::set<Key> CallbacksManager<Key, Observer>::TakeSubscriberKeys(void *subscriber)
+{
+    auto it = subscriberKeys_.find(subscriber);
+    if (it == subscriberKeys_.end()) {
+        return {};
+    }
+    std::set<Key> keys = std::move(it->second);
+    subscriberKeys_.erase(it);
+    return keys;
+}
+
 template<class Key, class Observer>
 void CallbacksManager<Key, Observer>::DelLocalObservers(void *subscriber, std::vector<Key> &lastDelKeys,
     std::vector<OperationResult> &result)
 {
-    for (auto &it : callbacks_) {
-        DelLocalObservers(it.first, subscriber, lastDelKeys, result);
+    for (auto &key : TakeSubscriberKeys(subscriber)) {
+        DelLocalObservers(key, subscriber, lastDelKeys, result);
     }
 }
 
@@ -189,30 +284,53 @@ template<class Key, class Observer>
 void CallbacksManager<Key, Observer>::DelLocalObservers(void *subscriber, std::vector<Key> &lastDelKeys,
     std::vector<DataProxyResult> &result)
 {
-    for (auto &it : callbacks_) {
-        DelLocalObservers(it.first, subscriber, lastDelKeys, result);
+    for (auto &key : TakeSubscriberKeys(subscriber)) {
+        DelLocalObservers(key, subscriber, lastDelKeys, result);
     }
 }
 
 template<class Key, class Observer>
-void CallbacksManager<Key, Observer>::DelLocalObservers(const Key &key, void *subscriber,
-    std::vector<Key> &lastDelKeys, std::vector<OperationResult> &result)
+bool CallbacksManager<Key, Observer>::DelLocalObservers(const Key &key, void *subscriber, bool &isLastDel)
 {
+    isLastDel = false;
     auto it = callbacks_.find(key);
     if (it == callbacks_.end()) {
-        result.emplace_back(key, E_UNREGISTERED_EMPTY);
-        return;
+        return false;
     }
-    std::vector<ObserverNode> &callbacks = it->second;
-    auto callbackIt = callbacks.begin();
-    while (callbackIt != callbacks.end()) {
-        if (callbackIt->subscriber_ != subscriber) {
-            callbackIt++;
-            continue;
+    auto subscriberIt = subscriberKeys_.find(subscriber);
+    if (subscriberIt != subscriberKeys_.end()) {
+        subscriberIt->second.erase(key);
+        if (subscriberIt->second.empty()) {
+            subscriberKeys_.erase(subscriberIt);
         }
-        callbackIt = callbacks.erase(callbackIt);
     }
-    if (!it->second.empty()) {
+    const ObserverNodes &nodes = *it->second->nodes_;
+    auto isSubscriber = [subscriber](const ObserverNode &node) { return node.subscriber_ == subscriber; };
+    if (std::none_of(nodes.begin(), nodes.end(), isSubscriber)) {
+        return true;
+    }
+    auto callbacks = std::make_shared<ObserverNodes>();
+    std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(*callbacks),
+        [&isSubscriber](const ObserverNode &node) { return !isSubscriber(node); });
+    isLastDel = callbacks->empty();
+    StoreNodes(*it->second, std::move(callbacks));
+    if (isLastDel) {
+        callbacks_.erase(it);
+        keysChanged_ = true;
+    }
+    return true;
+}
+
+template<class Key, class Observer>
+void CallbacksManager<Key, Observer>::DelLocalObservers(const Key &key, void *subscriber,
+    std::vector<Key> &lastDelKeys, std::vector<OperationResult> &result)
+{
+    bool isLastDel = false;
+    if (!DelLocalObservers(key, subscriber, isLastDel)) {
+        result.emplace_back(key, E_UNREGISTERED_EMPTY);
+        return;
+    }
+    if (!isLastDel) {
         result.emplace_back(key, E_OK);
         return;
     }
@@ -223,21 +341,12 @@ template<class Key, class Observer>
 void CallbacksManager<Key, Observer>::DelLocalObservers(const Key &key, void *subscriber,
     std::vector<Key> &lastDelKeys, std::vector<DataProxyResult> &result)
 {
-    auto it = callbacks_.find(key);
-    if (it == callbacks_.end()) {
+    bool isLastDel = false;
+    if (!DelLocalObservers(key, subscriber, isLastDel)) {
         result.emplace_back(key, INNER_ERROR);
         return;
     }
-    std::vector<ObserverNode> &callbacks = it->second;
-    auto callbackIt = callbacks.begin();
-    while (callbackIt != callbacks.end()) {
-        if (callbackIt->subscriber_ != subscriber) {
-            callbackIt++;
-            continue;
-        }
-        callbackIt = callbacks.erase(callbackIt);
-    }
-    if (!it->second.empty()) {
+    if (!isLastDel) {
         result.emplace_back(key, INNER_ERROR);
         return;
     }
@@ -253,12 +362,10 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::DelObservers(void
     {
         std::lock_guard<decltype(mutex_)> lck(mutex_);
         DelLocalObservers(subscriber, lastDelKeys, result);
+        PublishObservers();
         if (lastDelKeys.empty()) {
             return result;
         }
-        for (auto &key : lastDelKeys) {
-            callbacks_.erase(key);
-        }
     }
     processOnLastDel(lastDelKeys, result);
     return result;
@@ -275,12 +382,10 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::DelObservers(const
         for (auto &key : keys) {
             DelLocalObservers(key, subscriber, lastDelKeys, result);
         }
+        PublishObservers();
         if (lastDelKeys.empty()) {
             return result;
         }
-        for (auto &key : lastDelKeys) {
-            callbacks_.erase(key);
-        }
     }
     processOnLastDel(lastDelKeys, result);
     return result;
@@ -295,12 +400,10 @@ std::vector<DataProxyResult> CallbacksManager<Key, Observer>::DelObservers(void
     {
         std::lock_guard<decltype(mutex_)> lck(mutex_);
         DelLocalObservers(subscriber, lastDelKeys, result);
+        PublishObservers();
         if (lastDelKeys.empty()) {
             return result;
         }
-        for (auto &key : lastDelKeys) {
-            callbacks_.erase(key);
-        }
     }
     processOnLastDel(lastDelKeys, result);
     return result;
@@ -317,12 +420,10 @@ std::vector<DataProxyResult> CallbacksManager<Key, Observer>::DelProxyDataObserv
         for (auto &key : keys) {
             DelLocalObservers(key, subscriber, lastDelKeys, result);
         }
+        PublishObservers();
         if (lastDelKeys.empty()) {
             return result;
         }
-        for (auto &key : lastDelKeys) {
-            callbacks_.erase(key);
-        }
     }
     processOnLastDel(lastDelKeys, result);
     return result;
@@ -331,14 +432,13 @@ std::vector<DataProxyResult> CallbacksManager<Key, Observer>::DelProxyDataObserv
 template<class Key, class Observer>
 std::vector<std::shared_ptr<Observer>> CallbacksManager<Key, Observer>::GetEnabledObservers(const Key &inputKey)
 {
-    std::lock_guard<decltype(mutex_)> lck(mutex_);
-    auto it = callbacks_.find(inputKey);
-    if (it == callbacks_.end()) {
+    ObserverNodesPtr callbacks = GetObserverNodes(inputKey);
+    if (callbacks == nullptr) {
         return std::vector<std::shared_ptr<Observer>>();
     }
     std::vector<std::shared_ptr<Observer>> results;
-    for (const auto &value : it->second) {
-        if (value.enabled_ && value.observer_ != nullptr) {
+    for (const auto &value : *callbacks) {
+        if (IsEnabled(value)) {
             results.emplace_back(value.observer_);
         }
     }
@@ -348,14 +448,13 @@ std::vector<std::shared_ptr<Observer>> CallbacksManager<Key, Observer>::GetEnabl
 template <class Key, class Observer>
 auto CallbacksManager<Key, Observer>::GetEnabledProxyDataObseverNodes(const Key &inputKey) -> std::vector<ObserverNode>
 {
-    std::lock_guard<decltype(mutex_)> lck(mutex_);
-    auto it = callbacks_.find(inputKey);
-    if (it == callbacks_.end()) {
+    ObserverNodesPtr callbacks = GetObserverNodes(inputKey);
+    if (callbacks == nullptr) {
         return std::vector<ObserverNode>();
     }
     std::vector<ObserverNode> results;
-    for (const auto &value : it->second) {
-        if (value.enabled_ && value.observer_ != nullptr) {
+    for (const auto &value : *callbacks) {
+        if (IsEnabled(value)) {
             results.emplace_back(value);
         }
     }
@@ -366,27 +465,39 @@ template<class Key, class Observer>
 std::vector<std::shared_ptr<Observer>> CallbacksManager<Key, Observer>::GetObserversAndSetNotifiedOn(
     const Key &inputKey)
 {
-    std::lock_guard<decltype(mutex_)> lck(mutex_);
-    auto it = callbacks_.find(inputKey);
-    if (it == callbacks_.end()) {
+    ObserverNodesPtr callbacks = GetObserverNodes(inputKey);
+    if (callbacks == nullptr) {
         return std::vector<std::shared_ptr<Observer>>();
     }
     std::vector<std::shared_ptr<Observer>> results;
     uint32_t num = 0;
-    std::vector<ObserverNode> &callbacks = it->second;
-    for (auto &value : callbacks) {
-        if ((value.enabled_ && value.observer_ != nullptr)) {
+    bool isChanged = false;
+    for (const auto &value : *callbacks) {
+        bool enabled = IsEnabled(value);
+        if (enabled) {
             results.emplace_back(value.observer_);
-            // if get this enabled observer and notify, it's isNotifyOnEnabled flag should be reset to false
-            value.isNotifyOnEnabled_ = false;
         } else {
             num++;
-            value.isNotifyOnEnabled_ = true;
         }
+        // if get this enabled observer and notify, it's isNotifyOnEnabled flag should be reset to false
+        isChanged = isChanged || value.isNotifyOnEnabled_ == enabled;
     }
     if (num > 0) {
-        LOG_INFO("total %{public}zu, not refreshed %{public}u", callbacks.size(), num);
+        LOG_INFO("total %{public}zu, not refreshed %{public}u", callbacks->size(), num);
+    }
+    if (!isChanged) {
+        return results;
     }
+    std::lock_guard<decltype(mutex_)> lck(mutex_);
+    auto it = callbacks_.find(inputKey);
+    if (it == callbacks_.end()) {
+        return results;
+    }
+    auto newCallbacks = std::make_shared<ObserverNodes>(*it->second->nodes_);
+    for (auto &value : *newCallbacks) {
+        value.isNotifyOnEnabled_ = !IsEnabled(value);
+    }
+    StoreNodes(*it->second, std::move(newCallbacks));
     return results;
 }
 
@@ -408,14 +519,10 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::EnableObservers(
                 continue;
             }
 
-            auto& allObservers = it->second;
-            auto iterator = std::find_if(allObservers.begin(), allObservers.end(), [&subscriber](ObserverNode node) {
-                if (node.subscriber_ == subscriber) {
-                    return true;
-                }
-                return false;
-            });
-            if (iterator == allObservers.end()) {
+            auto allObservers = std::make_shared<ObserverNodes>(*it->second->nodes_);
+            auto iterator = std::find_if(allObservers->begin(), allObservers->end(),
+                [&subscriber](const ObserverNode &node) { return node.subscriber_ == subscriber; });
+            if (iterator == allObservers->end()) {
                 result.emplace_back(key, E_SUBSCRIBER_NOT_EXIST);
                 continue;
             }
@@ -424,12 +531,12 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::EnableObservers(
                 continue;
             }
 
-            std::vector<std::shared_ptr<Observer>> enabledObservers = GetEnabledObservers(key);
-            if (enabledObservers.empty()) {
+            if (!HasEnabledObserver(*it->second->nodes_)) {
                 sendServiceKeys.emplace_back(key);
             }
             refreshObservers[key].emplace_back(iterator->observer_, iterator->isNotifyOnEnabled_);
             iterator->enabled_ = true;
+            StoreNodes(*it->second, std::move(allObservers));
         }
     }
     enableServiceFunc(sendServiceKeys, result);
@@ -449,18 +556,14 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::DisableObservers(c
         std::lock_guard<decltype(mutex_)> lck(mutex_);
         for (auto &key : keys) {
             auto it = callbacks_.find(key);
-            if (it == callbacks_.end()) {
-                result.emplace_back(key, E_SUBSCRIBER_NOT_EXIST);
-                continue;
-            }
-            std::vector<std::shared_ptr<Observer>> enabledObservers = GetEnabledObservers(key);
-            if (enabledObservers.empty()) {
+            if (it == callbacks_.end() || !HasEnabledObserver(*it->second->nodes_)) {
                 result.emplace_back(key, E_SUBSCRIBER_NOT_EXIST);
                 continue;
             }
 
             bool hasDisabled = false;
-            for (auto &item : callbacks_[key]) {
+            auto callbacks = std::make_shared<ObserverNodes>(*it->second->nodes_);
+            for (auto &item : *callbacks) {
                 if (item.subscriber_ == subscriber) {
                     if (item.enabled_) {
                         item.enabled_ = false;
@@ -473,8 +576,8 @@ std::vector<OperationResult> CallbacksManager<Key, Observer>::DisableObservers(c
                 result.emplace_back(key, E_SUBSCRIBER_NOT_EXIST);
                 continue;
             }
-            enabledObservers = GetEnabledObservers(key);
-            if (!enabledObservers.empty()) {
+            StoreNodes(*it->second, std::move(callbacks));
+            if (HasEnabledObserver(*it->second->nodes_)) {
                 result.emplace_back(key, E_OK);
                 continue;
             }
@@ -489,9 +592,8 @@ template<class Key, class Observer>
 int CallbacksManager<Key, Observer>::GetAllSubscriberSize()
 {
     int count = 0;
-    std::lock_guard<decltype(mutex_)> lck(mutex_);
-    for (auto &[key, value] : callbacks_) {
-        count += GetAllSubscriberSize(key);
+    for (auto &[key, value] : *std::atomic_load(&observers_)) {
+        count += static_cast<int>(std::atomic_load(&value->nodes_)->size());
     }
     return count;
 }
@@ -499,12 +601,11 @@ int CallbacksManager<Key, Observer>::GetAllSubscriberSize()
 template<class Key, class Observer>
 int CallbacksManager<Key, Observer>::GetAllSubscriberSize(const Key &key)
 {
-    std::lock_guard<decltype(mutex_)> lck(mutex_);
-    auto it = callbacks_.find(key);
-    if (it == callbacks_.end()) {
+    ObserverNodesPtr callbacks = GetObserverNodes(key);
+    if (callbacks == nullptr) {
         return 0;
     }
-    return it->second.size();
+    return callbacks->size();
 }
 
 template<class Key, class Observer>
@@ -515,29 +616,28 @@ void CallbacksManager<Key, Observer>::SetObserversNotifiedOnEnabled(const Key &k
     if (it == callbacks_.end()) {
         return;
     }
-    std::vector<ObserverNode> &callbacks = it->second;
+    auto callbacks = std::make_shared<ObserverNodes>(*it->second->nodes_);
     uint32_t num = 0;
-    for (auto &observerNode : callbacks) {
+    for (auto &observerNode : *callbacks) {
         if (!observerNode.enabled_) {
             num++;
             observerNode.isNotifyOnEnabled_ = true;
         }
     }
     if (num > 0) {
-        LOG_INFO("total %{public}zu, not refreshed %{public}u", callbacks.size(), num);
+        LOG_INFO("total %{public}zu, not refreshed %{public}u", callbacks->size(), num);
+        StoreNodes(*it->second, std::move(callbacks));
     }
 }
 
 template<class Key, class Observer>
 bool CallbacksManager<Key, Observer>::IsObserversNotifiedOnEnabled(const Key &key, std::shared_ptr<Observer> &observer)
 {
-    std::lock_guard<decltype(mutex_)> lck(mutex_);
-    auto it = callbacks_.find(key);
-    if (it == callbacks_.end()) {
+    ObserverNodesPtr callbacks = GetObserverNodes(key);
+    if (callbacks == nullptr) {
         return false;
     }
-    std::vector<ObserverNode> &callbacks = it->second;
-    for (auto &node : callbacks) {
+    for (auto &node : *callbacks) {
         if (node.observer_ == observer) {
             return node.isNotifyOnEnabled_;
         }
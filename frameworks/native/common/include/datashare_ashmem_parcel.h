@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASHARE_ASHMEM_PARCEL_H
+#define DATASHARE_ASHMEM_PARCEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "message_parcel.h"
+
+namespace OHOS {
+namespace DataShare {
+/**
+ * @brief Carries a request too large for one binder transaction.
+ *
+ * The whole request parcel is copied into an ashmem sealed read only, only the ashmem, the original code, the
+ * length and the checksum of the request cross binder. A request holding objects or file descriptors can not be
+ * carried, their data only makes sense inside the parcel they were written to.
+ */
+class DataShareAshmemParcel {
+public:
+    /**
+     * @brief Writes data of the request with the given code into request, after its interface token.
+     */
+    static bool Pack(uint32_t code, MessageParcel &data, MessageParcel &request);
+
+    /**
+     * @brief Restores the request written by Pack into data, data starts with the interface token of the request.
+     */
+    static bool Unpack(MessageParcel &request, uint32_t &code, MessageParcel &data);
+
+    static uint64_t Checksum(const uint8_t *data, size_t size);
+
+    static constexpr size_t MAX_SIZE = 128 * 1024 * 1024;
+
+private:
+    static constexpr const char *ASHMEM_NAME = "DataShareRequest";
+    static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    static constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // DATASHARE_ASHMEM_PARCEL_H
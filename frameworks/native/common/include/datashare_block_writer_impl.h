@@ -38,6 +38,11 @@ public:
      */
     DataShareBlockWriterImpl(const std::string &name, size_t size);
 
+    /**
+     * SharedBlock constructor, writes to an existing block.
+     */
+    explicit DataShareBlockWriterImpl(std::shared_ptr<AppDataFwk::SharedBlock> block);
+
     /**
      * SharedBlock Deconstruction.
      */
@@ -78,6 +83,16 @@ public:
      */
     virtual int Write(uint32_t column, const char *value, size_t sizeIncludingNull) override;
 
+    /**
+     * Allocate a row and write its cells through the cell array of the row, which is looked up once.
+     */
+    int WriteRow(const Cell *cells, uint32_t count) override;
+
+    /**
+     * Write a chunk of one column to rows allocated in the shared block.
+     */
+    int WriteColumn(uint32_t column, uint32_t startRow, const Cell *cells, uint32_t count) override;
+
     /**
      * Get Block
      */
@@ -89,6 +104,12 @@ private:
      */
     bool GetCurrentRowIndex(uint32_t &rowIndex);
 
+    /**
+     * Put a cell to a cell unit of the shared block
+     */
+    static int PutCell(AppDataFwk::SharedBlock &block, AppDataFwk::SharedBlock::CellUnit *cellUnit,
+        const Cell &cell);
+
     /**
      * Convert ShareBlock error code to DataShare format
      */
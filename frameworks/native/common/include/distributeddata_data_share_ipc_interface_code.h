@@ -46,6 +46,7 @@ enum class IDataShareInterfaceCode {
     CMD_UNREGISTER_OBSERVEREXT_PROVIDER,
     CMD_NOTIFY_CHANGEEXT_PROVIDER,
     CMD_OPEN_FILE_WITH_ERR_CODE,
+    CMD_ASHMEM_REQUEST,
 };
 
 enum class ISharedResultInterfaceCode {
@@ -75,6 +76,8 @@ enum class ISharedResultInterfaceCode {
     FUNC_GET_COLUMN_NAME,
     FUNC_GET_COLUMN_TYPE,
     FUNC_GET_ROW_INDEX,
+    FUNC_FILL_WINDOW,
+    FUNC_FILL_WINDOWS,
     FUNC_BUTT,
 };
 
@@ -113,6 +116,8 @@ enum class DataShareServiceInterfaceCode {
     DATA_SHARE_SERVICE_CMD_PROXY_PUT_VALUE,
     DATA_SHARE_SERVICE_CMD_PROXY_REMOVE_VALUE,
     DATA_SHARE_SERVICE_CMD_PROXY_GET_VALUES,
+    DATA_SHARE_SERVICE_CMD_BATCH_INSERT,
+    DATA_SHARE_SERVICE_CMD_EXECUTE_BATCH,
     DATA_SHARE_SERVICE_CMD_MAX,
     DATA_SHARE_SERVICE_CMD_QUERY_SYSTEM = DATA_SHARE_CMD_SYSTEM_CODE,
     DATA_SHARE_SERVICE_CMD_ADD_TEMPLATE_SYSTEM,
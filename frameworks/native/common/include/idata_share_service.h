@@ -23,6 +23,7 @@
 #include "data_proxy_observer.h"
 #include "datashare_business_error.h"
 #include "datashare_common.h"
+#include "datashare_operation_statement.h"
 #include "datashare_predicates.h"
 #include "datashare_result_set.h"
 #include "datashare_sa_provider_info.h"
@@ -102,6 +103,20 @@ public:
     virtual std::pair<int32_t, int32_t> DeleteEx(const Uri &uri, const Uri &extUri,
         const DataSharePredicates &predicates) = 0;
 
+    /**
+     * Inserts the rows in one transaction, either all of them are inserted or none is. results holds the result of
+     * each row in order, on failure it ends with the row that failed.
+     */
+    virtual int32_t BatchInsert(const Uri &uri, const Uri &extUri, const std::vector<DataShareValuesBucket> &values,
+        std::vector<int32_t> &results) = 0;
+
+    /**
+     * Executes the statements in one transaction, either all of them take effect or none does. result holds the
+     * result of each statement in order.
+     */
+    virtual int32_t ExecuteBatch(const Uri &extUri, const std::vector<OperationStatement> &statements,
+        ExecResultSet &result) = 0;
+
     virtual std::vector<DataProxyResult> PublishProxyData(const std::vector<DataShareProxyData> &proxyData,
         const DataProxyConfig &proxyConfig) = 0;
 
@@ -15,6 +15,7 @@
 
 #ifndef DATASHARE_I_SHARED_RESULT_SET_PROXY_H
 #define DATASHARE_I_SHARED_RESULT_SET_PROXY_H
+#include <atomic>
 #include <memory>
 
 #include "ishared_result_set.h"
@@ -26,16 +27,26 @@ class ISharedResultSetProxy : public IRemoteProxy<ISharedResultSet> {
 public:
     static std::shared_ptr<DataShareResultSet> CreateProxy(MessageParcel &parcel);
     explicit ISharedResultSetProxy(const sptr<IRemoteObject> &impl);
-    virtual ~ISharedResultSetProxy() = default;
+    virtual ~ISharedResultSetProxy();
     int GetAllColumnNames(std::vector<std::string> &columnNames) override;
     int GetRowCount(int &count) override;
     bool OnGo(int startRowIndex, int targetRowIndex, int *cachedIndex = nullptr) override;
     int Close() override;
+protected:
+    bool FillWindow(int startRowIndex, int targetRowIndex, std::shared_ptr<AppDataFwk::SharedBlock> block,
+        int &endRowIndex) override;
+    bool FillWindows(int startRowIndex, int targetRowIndex,
+        const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &blocks, std::vector<int> &endRowIndexes) override;
+    uint32_t GetFillWindowsLimit() override;
+    bool CanFillWindow() override;
 private:
+    bool SendFillRequest(uint32_t code, MessageParcel &request, MessageParcel &reply);
     std::mutex mutex_;
     static BrokerDelegator<ISharedResultSetProxy> delegator_;
     std::vector<std::string> columnNames_;
     int32_t rowCount_ = -1;
+    // Set once the provider did not know a fill request, like a provider built before the fill codes
+    std::atomic<bool> fillRejected_ = false;
 };
 } // namespace OHOS::DataShare
 #endif // DATASHARE_I_SHARED_RESULT_SET_PROXY_H
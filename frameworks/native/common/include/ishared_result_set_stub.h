@@ -15,6 +15,7 @@
 
 #ifndef DATASHARE_I_SHARED_RESULT_SET_STUB_H
 #define DATASHARE_I_SHARED_RESULT_SET_STUB_H
+#include <array>
 #include <functional>
 #include <memory>
 
@@ -38,16 +39,18 @@ protected:
     int HandleGetAllColumnNamesRequest(MessageParcel &data, MessageParcel &reply);
     int HandleOnGoRequest(MessageParcel &data, MessageParcel &reply);
     int HandleCloseRequest(MessageParcel &data, MessageParcel &reply);
+    int HandleFillWindowRequest(MessageParcel &data, MessageParcel &reply);
+    int HandleFillWindowsRequest(MessageParcel &data, MessageParcel &reply);
 
 private:
     using Handler = int(ISharedResultSetStub::*)(MessageParcel &request, MessageParcel &reply);
+    using Handlers = std::array<Handler, static_cast<uint32_t>(ResultCode::FUNC_BUTT)>;
+    static constexpr Handlers GetHandlers();
+    static std::shared_ptr<AppDataFwk::SharedBlock> ReadWindow(MessageParcel &data);
+    bool CopyWindows(const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &blocks,
+        const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &windows, size_t count);
     std::shared_ptr<DataShareResultSet> resultSet_;
-    static constexpr Handler handlers[static_cast<uint32_t>(ResultCode::FUNC_BUTT)] {
-        &ISharedResultSetStub::HandleGetRowCountRequest,
-        &ISharedResultSetStub::HandleGetAllColumnNamesRequest,
-        &ISharedResultSetStub::HandleOnGoRequest,
-        &ISharedResultSetStub::HandleCloseRequest,
-    };
+    static const Handlers handlers;
 };
 } // namespace OHOS::DataShare
 
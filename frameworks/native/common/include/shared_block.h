@@ -90,6 +90,17 @@ public:
      */
     int Clear();
 
+    /**
+     * Zero the bytes the rows used and clear current shared block, so its next reader never sees them.
+     */
+    int Wipe();
+
+    /**
+     * Copy the used bytes of current shared block into a writable block of the same size, which may be shared with
+     * another process. Only the header of current shared block is read.
+     */
+    int CopyTo(SharedBlock &block);
+
     /**
      * Set a shared block column.
      */
@@ -130,6 +141,31 @@ public:
      */
     int PutNull(uint32_t row, uint32_t column);
 
+    /**
+     * Put blob data to a cell unit got from GetCellUnit, so a row is resolved once for all of its cells.
+     */
+    int PutBlob(CellUnit *cellUnit, const void *value, size_t size);
+
+    /**
+     * Put string data to a cell unit got from GetCellUnit.
+     */
+    int PutString(CellUnit *cellUnit, const char *value, size_t sizeIncludingNull);
+
+    /**
+     * Put long data to a cell unit got from GetCellUnit.
+     */
+    int PutLong(CellUnit *cellUnit, int64_t value);
+
+    /**
+     * Put Double data to a cell unit got from GetCellUnit.
+     */
+    int PutDouble(CellUnit *cellUnit, double value);
+
+    /**
+     * Put Null data to a cell unit got from GetCellUnit.
+     */
+    int PutNull(CellUnit *cellUnit);
+
     /**
      * Gets the cell unit at the specified row and column.
      */
@@ -205,6 +241,19 @@ public:
     int WriteMessageParcel(MessageParcel &parcel);
 
     static int ReadMessageParcel(MessageParcel &parcel, SharedBlock *&block);
+
+    /**
+     * Read a SharedBlock from the parcel, a writable block is filled on behalf of the sender.
+     * A read-only block is mapped read-only.
+     */
+    static int ReadMessageParcel(MessageParcel &parcel, SharedBlock *&block, bool readOnly);
+
+    /**
+     * Forbid the writable mappings of the shared memory once the block is handed to readers.
+     * The block itself can still be filled through its own mapping.
+     */
+    int Seal();
+
     /**
      * Write raw data in block.
      */
@@ -257,6 +306,15 @@ private:
     size_t mSize;
     bool mReadOnly;
     static const size_t ROW_OFFSETS_NUM = 100;
+    /* Row offsets held by one page of the row directory, must be a power of 2. */
+    static constexpr uint32_t ROW_PAGE_SHIFT = 8;
+    static constexpr uint32_t ROW_PAGE_SIZE = 1 << ROW_PAGE_SHIFT;
+    static constexpr uint32_t ROW_PAGE_MASK = ROW_PAGE_SIZE - 1;
+    /**
+     * Layout tag of blocks using the paged row directory. The value is far beyond any valid offset,
+     * so it can not be mistaken for the first row offset of a legacy block, which occupies the same bytes.
+     */
+    static constexpr uint32_t LAYOUT_ROW_DIRECTORY = 0x53420002;
     /**
     * Default setting for SQLITE_MAX_COLUMN is 2000.
     * We can set it at compile time to as large as 32767
@@ -278,8 +336,17 @@ private:
         uint32_t lastPos_;
         /* current position of the current block. */
         uint32_t blockPos_;
+        /* Layout of the row offsets, LAYOUT_ROW_DIRECTORY or legacy row group list. */
+        uint32_t layoutVersion;
+        /* Offset of the row directory, each entry is the offset of a page of ROW_PAGE_SIZE row offsets. */
+        uint32_t rowDirOffset;
+        /* Max number of pages the row directory can hold. */
+        uint32_t rowDirCapacity;
+        /* Number of pages allocated in the row directory. */
+        uint32_t rowPageNums;
     };
 
+    /* Row group of the legacy layout, only used to read blocks from older writers. */
     struct RowGroupHeader {
         uint32_t rowOffsets[ROW_OFFSETS_NUM];
         uint32_t nextGroupOffset;
@@ -295,10 +362,19 @@ private:
 
     inline uint32_t *GetRowOffset(uint32_t row);
 
+    uint32_t *GetLegacyRowOffset(uint32_t row);
+
     uint32_t *AllocRowOffset();
 
+    inline bool IsRowDirectoryLayout()
+    {
+        return mHeader->layoutVersion == LAYOUT_ROW_DIRECTORY;
+    }
+
     int PutBlobOrString(uint32_t row, uint32_t column, const void *value, size_t size, int32_t type);
 
+    int PutBlobOrString(CellUnit *cellUnit, const void *value, size_t size, int32_t type);
+
     static int CreateSharedBlock(const std::string &name, size_t size, sptr<Ashmem> ashmem,
         SharedBlock *&outSharedBlock);
 
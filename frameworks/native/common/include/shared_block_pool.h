@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASHARE_SHARED_BLOCK_POOL_H
+#define DATASHARE_SHARED_BLOCK_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "shared_block.h"
+
+namespace OHOS {
+namespace DataShare {
+/**
+ * @brief Keeps the SharedBlocks of closed result sets of the process, so the next query skips creating an ashmem.
+ *
+ * An idle block is keyed by its size and by its owner, the pid and token id of the process it was handed to. That
+ * process keeps the ashmem mapped, so a block is only handed out again to the same owner, and the bytes the previous
+ * rows used are zeroed first. A block never handed to another process has no owner.
+ */
+class SharedBlockPool {
+public:
+    static constexpr uint64_t NO_OWNER = 0;
+    static constexpr size_t DEFAULT_MAX_IDLE_BYTES = 8 * 1024 * 1024;
+
+    static SharedBlockPool &GetInstance();
+
+    /**
+     * @brief Returns the owner of a block handed to the process, another app reusing the pid is another owner.
+     */
+    static uint64_t GetOwner(int32_t pid, uint32_t tokenId);
+
+    /**
+     * @brief Returns a cleared idle block of the size and owner, or a new block if there is none.
+     */
+    std::shared_ptr<AppDataFwk::SharedBlock> Acquire(size_t size, uint64_t owner = NO_OWNER);
+
+    /**
+     * @brief Returns a cleared idle block of the size and owner, or nullptr if there is none.
+     */
+    std::shared_ptr<AppDataFwk::SharedBlock> TakeIdle(size_t size, uint64_t owner);
+
+    /**
+     * @brief Keeps a block acquired from the pool for the next query, the caller must hold the only reference.
+     *
+     * The oldest idle blocks are released while the idle blocks take more than the max idle bytes.
+     */
+    void Recycle(std::shared_ptr<AppDataFwk::SharedBlock> block, size_t size, uint64_t owner);
+
+    /**
+     * @brief Releases the oldest idle blocks until they take at most keepBytes.
+     *
+     * The provider calls it from DataShareExtAbility::OnMemoryLevel, a process using the pool without the extension
+     * ability has to call it on memory pressure itself.
+     */
+    void Trim(size_t keepBytes = 0);
+
+    void SetMaxIdleBytes(size_t maxIdleBytes);
+
+    size_t GetIdleBytes();
+
+private:
+    struct IdleBlock {
+        size_t size;
+        uint64_t owner;
+        std::shared_ptr<AppDataFwk::SharedBlock> block;
+    };
+
+    SharedBlockPool() = default;
+    void TrimLocked(size_t keepBytes, std::list<IdleBlock> &released);
+
+    std::mutex mutex_;
+    size_t maxIdleBytes_ = DEFAULT_MAX_IDLE_BYTES;
+    size_t idleBytes_ = 0;
+    // The most recently recycled block is at the back
+    std::list<IdleBlock> idleBlocks_;
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // DATASHARE_SHARED_BLOCK_POOL_H
@@ -25,88 +25,105 @@ namespace DataShare {
 // count the func call and check if the funcCount exceeds the threshold
 bool DataShareCallReporter::Count(const std::string &funcName, const std::string &uri)
 {
-    int overCount = 0;
-    int64_t firstCallTime = 0;
+    int64_t now = bootTimeAdaptor_.GetBootTimeMs();
+    if (now < 0) {
+        return false;
+    }
+    return Count(funcName, uri, now);
+}
+
+bool DataShareCallReporter::Count(const std::string &funcName, const std::string &uri, int64_t now)
+{
+    CallSlot *slot = GetSlot(funcName);
+    if (slot == nullptr) {
+        return false;
+    }
     // isOverThreshold means that the call count of the funcName over threshold, true means exceeded
     // if exceeds the threshold, the current 30s time window will return 'true'
     // and the funcCount will be reseted in the next 30s time window
-    bool isOverThreshold = false;
-
-    UpdateCallCounts(funcName, overCount, firstCallTime, isOverThreshold);
-
-    int64_t now  = bootTimeAdaptor_.GetBootTimeMs();
-    if (now < 0) {
-        return isOverThreshold;
-    }
-    if (overCount > 0) {
+    CallResult result;
+    UpdateCallCounts(*slot, now, result);
+    if (result.overCount > 0) {
         LOG_WARN("Call the threshold, func: %{public}s, first:%{public}" PRIi64 "ms, now:%{public}" PRIi64
-            "ms, uri:%{public}s", funcName.c_str(), firstCallTime, now, DataShareStringUtils::Anonymous(uri).c_str());
+            "ms, uri:%{public}s", funcName.c_str(), result.firstTime, now,
+            DataShareStringUtils::Anonymous(uri).c_str());
     }
-    if (overCount > 1) {
+    if (result.overCount > 1) {
         LOG_WARN("Call too frequently, func: %{public}s, first:%{public}" PRIi64 "ms, now:%{public}" PRIi64
-            "ms, uri:%{public}s", funcName.c_str(), firstCallTime, now, DataShareStringUtils::Anonymous(uri).c_str());
+            "ms, uri:%{public}s", funcName.c_str(), result.firstTime, now,
+            DataShareStringUtils::Anonymous(uri).c_str());
     }
     // error log for over threshold and only print once
-    if (isOverThreshold) {
-        callCounts_.Compute(funcName, [funcName, now, uri](auto &key, CallInfo &callInfo) {
-            if (!callInfo.logPrintFlag) {
-                int64_t thresholdStartTime = callInfo.startTime;
-                callInfo.logPrintFlag = true;
-                LOG_ERROR("Over threshold, func: %{public}s, first:%{public}" PRIi64 "ms, now:%{public}" PRIi64
-                    "ms, uri:%{public}s", funcName.c_str(), thresholdStartTime, now,
-                    DataShareStringUtils::Anonymous(uri).c_str());
-            }
-            return true;
-        });
+    if (result.isOverThreshold && slot->loggedWindow.exchange(result.windowStart) != result.windowStart) {
+        LOG_ERROR("Over threshold, func: %{public}s, first:%{public}" PRIi64 "ms, now:%{public}" PRIi64
+            "ms, uri:%{public}s", funcName.c_str(), result.windowStart, now,
+            DataShareStringUtils::Anonymous(uri).c_str());
     }
-    return isOverThreshold;
+    return result.isOverThreshold;
 }
 
-void DataShareCallReporter::UpdateCallCounts(const std::string &funcName, int &overCount, int64_t &firstCallTime,
-    bool &isOverThreshold)
+DataShareCallReporter::CallSlot *DataShareCallReporter::GetSlot(const std::string &funcName)
 {
-    callCounts_.Compute(funcName, [&overCount, &firstCallTime, &isOverThreshold, this](auto &key, CallInfo &callInfo) {
-        int callCount = callInfo.count;
-        // totalCallCount is the call count of funcName in 30s
-        int totalCallCount = callInfo.totalCount;
-        int64_t currTime = bootTimeAdaptor_.GetBootTimeMs();
-        // get boot time failed
-        if (currTime < 0) {
-            return false;
+    size_t count = slotCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (slots_[i].funcName == funcName) {
+            return &slots_[i];
         }
-        if (callCount == 0) {
-            callInfo.firstTime = currTime;
+    }
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    count = slotCount_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; i++) {
+        if (slots_[i].funcName == funcName) {
+            return &slots_[i];
         }
+    }
+    if (count >= MAX_FUNC_NUM) {
+        LOG_ERROR("Too many funcs to count, func: %{public}s", funcName.c_str());
+        return nullptr;
+    }
+    slots_[count].funcName = funcName;
+    slotCount_.store(count + 1, std::memory_order_release);
+    return &slots_[count];
+}
+
+void DataShareCallReporter::UpdateCallCounts(CallSlot &slot, int64_t now, CallResult &result)
+{
+    uint64_t currTime = static_cast<uint64_t>(now);
+    uint64_t oldValue = slot.frequency.load(std::memory_order_relaxed);
+    uint64_t newValue = 0;
+    do {
+        uint64_t callCount = oldValue & COUNT_MASK;
+        uint64_t first = callCount == 0 ? currTime : oldValue >> COUNT_BITS;
+        result.overCount = 0;
         if (++callCount % RESET_COUNT_THRESHOLD == 0) {
-            int64_t first = callInfo.firstTime;
-            ++overCount;
-            firstCallTime = first;
+            ++result.overCount;
+            result.firstTime = static_cast<int64_t>(first);
             if (currTime - first <= TIME_THRESHOLD) {
-                ++overCount;
+                ++result.overCount;
             }
             callCount = 0;
         }
-        callInfo.count = callCount;
+        newValue = (first << COUNT_BITS) | callCount;
+    } while (!slot.frequency.compare_exchange_weak(oldValue, newValue, std::memory_order_relaxed));
 
-        // update access control count
-        if (totalCallCount == 0) {
-            callInfo.startTime = currTime;
-        }
-        int64_t thresholdStartTime = callInfo.startTime;
-        // reset callInfo when time >= 30s or currTime < thresholdStartTime
+    // update access control count
+    oldValue = slot.window.load(std::memory_order_relaxed);
+    do {
+        uint64_t totalCallCount = oldValue & COUNT_MASK;
+        uint64_t thresholdStartTime = totalCallCount == 0 ? currTime : oldValue >> COUNT_BITS;
+        // start a new window when time >= 30s or currTime < thresholdStartTime
         if (currTime - thresholdStartTime >= TIME_THRESHOLD || currTime < thresholdStartTime) {
-            callInfo.startTime = currTime;
-            callInfo.totalCount = 0;
-            callInfo.logPrintFlag = false;
+            thresholdStartTime = currTime;
             totalCallCount = 0;
         }
-        // isOverThreshold return true when callCount >= 3000 in 30s
-        if (++totalCallCount >= ACCESS_COUNT_THRESHOLD) {
-            isOverThreshold = true;
+        if (totalCallCount < COUNT_MASK) {
+            ++totalCallCount;
         }
-        callInfo.totalCount = totalCallCount;
-        return true;
-    });
+        // isOverThreshold return true when callCount >= 3000 in 30s
+        result.isOverThreshold = totalCallCount >= ACCESS_COUNT_THRESHOLD;
+        result.windowStart = static_cast<int64_t>(thresholdStartTime);
+        newValue = (thresholdStartTime << COUNT_BITS) | totalCallCount;
+    } while (!slot.window.compare_exchange_weak(oldValue, newValue, std::memory_order_relaxed));
 }
 } // namespace DataShare
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
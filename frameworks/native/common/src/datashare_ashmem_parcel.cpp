@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "datashare_ashmem_parcel"
+
+#include "datashare_ashmem_parcel.h"
+
+#include <cinttypes>
+#include <securec.h>
+#include <sys/mman.h>
+
+#include "ashmem.h"
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+bool DataShareAshmemParcel::Pack(uint32_t code, MessageParcel &data, MessageParcel &request)
+{
+    size_t size = data.GetDataSize();
+    if (size == 0 || size > MAX_SIZE) {
+        LOG_ERROR("Size of request is invalid:%{public}zu", size);
+        return false;
+    }
+    if (data.GetOffsetsSize() != 0) {
+        LOG_ERROR("Request with objects can not be carried by ashmem, code:%{public}u", code);
+        return false;
+    }
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(ASHMEM_NAME, static_cast<int32_t>(size));
+    if (ashmem == nullptr) {
+        LOG_ERROR("Create ashmem failed, size:%{public}zu", size);
+        return false;
+    }
+    const uint8_t *buffer = reinterpret_cast<const uint8_t *>(data.GetData());
+    if (!ashmem->MapReadAndWriteAshmem() || !ashmem->WriteToAshmem(buffer, static_cast<int32_t>(size), 0)) {
+        LOG_ERROR("Write ashmem failed, size:%{public}zu", size);
+        ashmem->CloseAshmem();
+        return false;
+    }
+    // no writable mapping is left once sealed, the receiver reads what the checksum was taken of
+    ashmem->UnmapAshmem();
+    if (!ashmem->SetProtection(PROT_READ)) {
+        LOG_ERROR("Seal ashmem failed");
+        ashmem->CloseAshmem();
+        return false;
+    }
+    if (!request.WriteUint32(code) || !request.WriteUint64(size) || !request.WriteUint64(Checksum(buffer, size)) ||
+        !request.WriteAshmem(ashmem)) {
+        LOG_ERROR("Write ashmem to parcel failed");
+        ashmem->CloseAshmem();
+        return false;
+    }
+    ashmem->CloseAshmem();
+    return true;
+}
+
+bool DataShareAshmemParcel::Unpack(MessageParcel &request, uint32_t &code, MessageParcel &data)
+{
+    uint64_t size = 0;
+    uint64_t checksum = 0;
+    if (!request.ReadUint32(code) || !request.ReadUint64(size) || !request.ReadUint64(checksum)) {
+        LOG_ERROR("Read header of request failed");
+        return false;
+    }
+    sptr<Ashmem> ashmem = request.ReadAshmem();
+    if (ashmem == nullptr) {
+        LOG_ERROR("Read ashmem failed, code:%{public}u", code);
+        return false;
+    }
+    if (size == 0 || size > MAX_SIZE || size > static_cast<uint64_t>(ashmem->GetAshmemSize())) {
+        LOG_ERROR("Size of request is invalid:%{public}" PRIu64 ", ashmem:%{public}d", size,
+            ashmem->GetAshmemSize());
+        ashmem->CloseAshmem();
+        return false;
+    }
+    if ((ashmem->GetProtection() & PROT_WRITE) != 0) {
+        LOG_ERROR("Ashmem of request is not sealed, code:%{public}u", code);
+        ashmem->CloseAshmem();
+        return false;
+    }
+    const void *buffer = nullptr;
+    if (ashmem->MapReadOnlyAshmem()) {
+        buffer = ashmem->ReadFromAshmem(static_cast<int32_t>(size), 0);
+    }
+    // parse a copy, so the data checked is the data read
+    bool isCopied = buffer != nullptr && data.SetMaxCapacity(MAX_SIZE) &&
+        data.WriteBuffer(buffer, static_cast<size_t>(size));
+    ashmem->UnmapAshmem();
+    ashmem->CloseAshmem();
+    if (!isCopied) {
+        LOG_ERROR("Read ashmem failed, size:%{public}" PRIu64, size);
+        return false;
+    }
+    if (Checksum(reinterpret_cast<const uint8_t *>(data.GetData()), static_cast<size_t>(size)) != checksum) {
+        LOG_ERROR("Checksum of request mismatch, code:%{public}u, size:%{public}" PRIu64, code, size);
+        return false;
+    }
+    return true;
+}
+
+uint64_t DataShareAshmemParcel::Checksum(const uint8_t *data, size_t size)
+{
+    // FNV-1a over 8 byte words, the bytes left are folded one by one
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t pos = 0;
+    for (; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        if (memcpy_s(&word, sizeof(word), data + pos, sizeof(word)) != EOK) {
+            return 0;
+        }
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (; pos < size; pos++) {
+        hash = (hash ^ data[pos]) * FNV_PRIME;
+    }
+    return hash;
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -36,6 +36,11 @@ DataShareBlockWriterImpl::DataShareBlockWriterImpl(const std::string &name, size
     shareBlock_ = std::shared_ptr<AppDataFwk::SharedBlock>(shareBlock);
 }
 
+DataShareBlockWriterImpl::DataShareBlockWriterImpl(std::shared_ptr<AppDataFwk::SharedBlock> block)
+    : shareBlock_(std::move(block))
+{
+}
+
 DataShareBlockWriterImpl::~DataShareBlockWriterImpl()
 {
 }
@@ -135,6 +140,59 @@ int DataShareBlockWriterImpl::Write(uint32_t column, const char *value, size_t s
     return ConvertErrorCode(block->PutString(currentRowIndex, column, value, sizeIncludingNull));
 }
 
+int DataShareBlockWriterImpl::WriteRow(const Cell *cells, uint32_t count)
+{
+    auto block = GetBlock();
+    if (block == nullptr) {
+        LOG_ERROR("shareBlock_ is nullptr");
+        return E_ERROR;
+    }
+    if ((cells == nullptr && count != 0) || count > block->GetColumnNum()) {
+        LOG_ERROR("Write row fail, count %{public}u, columns %{public}u", count, block->GetColumnNum());
+        return E_ERROR;
+    }
+    // A full block is the normal end of a window, so it is not logged.
+    if (block->AllocRow() != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+        return E_ERROR;
+    }
+    if (count == 0) {
+        return E_OK;
+    }
+    AppDataFwk::SharedBlock::CellUnit *cellUnits = block->GetCellUnit(block->GetRowNum() - 1, 0);
+    int result = cellUnits == nullptr ? AppDataFwk::SharedBlock::SHARED_BLOCK_BAD_VALUE :
+        AppDataFwk::SharedBlock::SHARED_BLOCK_OK;
+    for (uint32_t column = 0; column < count && result == AppDataFwk::SharedBlock::SHARED_BLOCK_OK; column++) {
+        result = PutCell(*block, &cellUnits[column], cells[column]);
+    }
+    if (result != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+        block->FreeLastRow();
+    }
+    return ConvertErrorCode(result);
+}
+
+int DataShareBlockWriterImpl::WriteColumn(uint32_t column, uint32_t startRow, const Cell *cells, uint32_t count)
+{
+    auto block = GetBlock();
+    if (block == nullptr) {
+        LOG_ERROR("shareBlock_ is nullptr");
+        return E_ERROR;
+    }
+    uint32_t rowNum = block->GetRowNum();
+    if ((cells == nullptr && count != 0) || column >= block->GetColumnNum() || startRow > rowNum ||
+        count > rowNum - startRow) {
+        LOG_ERROR("Write column fail, column %{public}u, rows [%{public}u, %{public}u) of %{public}u",
+            column, startRow, startRow + count, rowNum);
+        return E_ERROR;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        int result = PutCell(*block, block->GetCellUnit(startRow + i, column), cells[i]);
+        if (result != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+            return ConvertErrorCode(result);
+        }
+    }
+    return E_OK;
+}
+
 std::shared_ptr<AppDataFwk::SharedBlock> DataShareBlockWriterImpl::GetBlock()
 {
     return shareBlock_;
@@ -154,5 +212,24 @@ bool DataShareBlockWriterImpl::GetCurrentRowIndex(uint32_t &rowIndex)
     }
     return false;
 }
+
+int DataShareBlockWriterImpl::PutCell(AppDataFwk::SharedBlock &block, AppDataFwk::SharedBlock::CellUnit *cellUnit,
+    const Cell &cell)
+{
+    switch (cell.type) {
+        case Cell::TYPE_NULL:
+            return block.PutNull(cellUnit);
+        case Cell::TYPE_INTEGER:
+            return block.PutLong(cellUnit, cell.longValue);
+        case Cell::TYPE_FLOAT:
+            return block.PutDouble(cellUnit, cell.doubleValue);
+        case Cell::TYPE_STRING:
+            return block.PutString(cellUnit, static_cast<const char *>(cell.value), cell.size);
+        case Cell::TYPE_BLOB:
+            return block.PutBlob(cellUnit, cell.value, cell.size);
+        default:
+            return AppDataFwk::SharedBlock::SHARED_BLOCK_BAD_VALUE;
+    }
+}
 } // namespace DataShare
 } // namespace OHOS
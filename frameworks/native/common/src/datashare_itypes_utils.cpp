@@ -19,6 +19,8 @@
 
 #include <cstdint>
 #include <iomanip>
+#include <memory>
+#include <securec.h>
 #include <sstream>
 #include <variant>
 #include "dataproxy_handle_common.h"
@@ -183,16 +185,153 @@ bool Unmarshalling(RdbChangeNode &changeNode, MessageParcel &parcel)
     return ITypesUtil::Unmarshal(parcel, changeNode.size_);
 }
 
+namespace {
+// Leads the arena layout of a change node in place of the item count, legacy readers reject it as an invalid count
+constexpr int32_t PUBLISHED_ARENA_V1 = -1;
+// Blobs of fewer items are sent in their own shared memory
+constexpr size_t MIN_ARENA_BLOB_COUNT = 2;
+
+enum PublishedItemKind : int32_t {
+    PUBLISHED_ITEM_BLOB = 0,
+    PUBLISHED_ITEM_STRING,
+};
+
+/**
+ * Gets the arena holding all blobs of the items, packs the blobs into a new one when they are not shared yet.
+ */
+std::shared_ptr<PublishedDataArena> GetPublishedArena(const std::vector<PublishedDataItem> &datas,
+    std::vector<PublishedDataArena::Slice> &slices)
+{
+    std::shared_ptr<PublishedDataArena> shared = nullptr;
+    size_t blobCount = 0;
+    bool isShared = true;
+    slices.assign(datas.size(), PublishedDataArena::Slice());
+    for (size_t i = 0; i < datas.size(); i++) {
+        const AshmemNode *node = std::get_if<AshmemNode>(&datas[i].value_);
+        if (node == nullptr) {
+            continue;
+        }
+        blobCount++;
+        if (node->arena == nullptr || (shared != nullptr && shared != node->arena)) {
+            isShared = false;
+            continue;
+        }
+        shared = node->arena;
+        slices[i] = node->slice;
+    }
+    if (isShared && shared != nullptr) {
+        return shared;
+    }
+    if (blobCount < MIN_ARENA_BLOB_COUNT) {
+        return nullptr;
+    }
+    return PublishedDataArena::Pack(datas, slices);
+}
+
+bool MarshalPublishedArena(const PublishedDataChangeNode &changeNode, const PublishedDataArena &arena,
+    const std::vector<PublishedDataArena::Slice> &slices, MessageParcel &parcel)
+{
+    if (!parcel.WriteInt32(PUBLISHED_ARENA_V1) || !parcel.WriteAshmem(arena.GetAshmem()) ||
+        !parcel.WriteInt32(static_cast<int32_t>(changeNode.datas_.size()))) {
+        LOG_ERROR("Write arena failed.");
+        return false;
+    }
+    for (size_t i = 0; i < changeNode.datas_.size(); i++) {
+        const PublishedDataItem &item = changeNode.datas_[i];
+        if (!ITypesUtil::Marshal(parcel, item.key_, item.subscriberId_)) {
+            return false;
+        }
+        const std::string *value = std::get_if<std::string>(&item.value_);
+        if (value != nullptr) {
+            if (!parcel.WriteInt32(PUBLISHED_ITEM_STRING) || !ITypesUtil::Marshal(parcel, *value)) {
+                return false;
+            }
+            continue;
+        }
+        if (!parcel.WriteInt32(PUBLISHED_ITEM_BLOB) || !parcel.WriteUint32(slices[i].offset) ||
+            !parcel.WriteUint32(slices[i].size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UnmarshalPublishedArena(PublishedDataChangeNode &changeNode, MessageParcel &parcel)
+{
+    sptr<Ashmem> ashmem = parcel.ReadAshmem();
+    if (ashmem == nullptr) {
+        LOG_ERROR("Read arena failed.");
+        return false;
+    }
+    auto arena = std::make_shared<PublishedDataArena>(ashmem);
+    if (!ashmem->MapReadOnlyAshmem()) {
+        LOG_ERROR("Map arena failed.");
+        return false;
+    }
+    uint64_t arenaSize = static_cast<uint64_t>(ashmem->GetAshmemSize());
+    int32_t count = parcel.ReadInt32();
+    if (count < 0 || static_cast<size_t>(count) > parcel.GetReadableBytes()) {
+        LOG_ERROR("Count of items is invalid:%{public}d", count);
+        return false;
+    }
+    std::vector<PublishedDataItem> datas;
+    datas.reserve(static_cast<size_t>(count));
+    for (int32_t i = 0; i < count; i++) {
+        std::string key;
+        int64_t subscriberId = 0;
+        if (!ITypesUtil::Unmarshal(parcel, key, subscriberId)) {
+            return false;
+        }
+        int32_t kind = parcel.ReadInt32();
+        if (kind == PUBLISHED_ITEM_STRING) {
+            std::string value;
+            if (!ITypesUtil::Unmarshal(parcel, value)) {
+                return false;
+            }
+            datas.emplace_back(key, subscriberId, PublishedDataItem::DataType(std::move(value)));
+            continue;
+        }
+        PublishedDataArena::Slice slice;
+        if (kind != PUBLISHED_ITEM_BLOB || !parcel.ReadUint32(slice.offset) || !parcel.ReadUint32(slice.size)) {
+            LOG_ERROR("Read item %{public}d failed, kind:%{public}d", i, kind);
+            return false;
+        }
+        if (static_cast<uint64_t>(slice.offset) + slice.size > arenaSize) {
+            LOG_ERROR("Slice of item %{public}d exceeds the arena, offset:%{public}u, size:%{public}u", i,
+                slice.offset, slice.size);
+            return false;
+        }
+        datas.emplace_back(key, subscriberId, arena, slice);
+    }
+    changeNode.datas_ = std::move(datas);
+    return true;
+}
+} // namespace
+
 template<>
 bool Marshalling(const PublishedDataChangeNode &changeNode, MessageParcel &parcel)
 {
-    return ITypesUtil::Marshal(parcel, changeNode.ownerBundleName_, changeNode.datas_);
+    std::vector<PublishedDataArena::Slice> slices;
+    auto arena = GetPublishedArena(changeNode.datas_, slices);
+    if (arena == nullptr) {
+        return ITypesUtil::Marshal(parcel, changeNode.ownerBundleName_, changeNode.datas_);
+    }
+    return ITypesUtil::Marshal(parcel, changeNode.ownerBundleName_) &&
+        MarshalPublishedArena(changeNode, *arena, slices, parcel);
 }
 
 template<>
 bool Unmarshalling(PublishedDataChangeNode &changeNode, MessageParcel &parcel)
 {
-    return ITypesUtil::Unmarshal(parcel, changeNode.ownerBundleName_, changeNode.datas_);
+    if (!ITypesUtil::Unmarshal(parcel, changeNode.ownerBundleName_)) {
+        return false;
+    }
+    size_t position = parcel.GetReadPosition();
+    if (parcel.ReadInt32() == PUBLISHED_ARENA_V1) {
+        return UnmarshalPublishedArena(changeNode, parcel);
+    }
+    parcel.RewindRead(position);
+    return ITypesUtil::Unmarshal(parcel, changeNode.datas_);
 }
 
 template<>
@@ -218,7 +357,24 @@ bool Unmarshalling(AshmemNode &node, MessageParcel &parcel)
 template<>
 bool Marshalling(const AshmemNode &node, MessageParcel &parcel)
 {
-    return parcel.WriteAshmem(node.ashmem);
+    if (node.arena == nullptr) {
+        return parcel.WriteAshmem(node.ashmem);
+    }
+    // A slice of an arena sent on its own, copy it out so the receiver does not map the whole arena
+    const uint8_t *data = node.arena->Read(node.slice);
+    if (data == nullptr) {
+        LOG_ERROR("Read slice failed, offset:%{public}u, size:%{public}u", node.slice.offset, node.slice.size);
+        return false;
+    }
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem("PublishedDataSlice", static_cast<int32_t>(node.slice.size));
+    if (ashmem == nullptr) {
+        return false;
+    }
+    bool result = ashmem->MapReadAndWriteAshmem() &&
+        ashmem->WriteToAshmem(data, static_cast<int32_t>(node.slice.size), 0) && parcel.WriteAshmem(ashmem);
+    ashmem->UnmapAshmem();
+    ashmem->CloseAshmem();
+    return result;
 }
 
 template<>
@@ -620,184 +776,6 @@ bool MarshalStringVecToBuffer(std::ostringstream &oss, const std::vector<std::st
     return oss.good();
 }
 
-bool MarshalSingleTypeToBuffer(std::ostringstream &oss, const SingleValue::Type &value)
-{
-    // write typeId
-    uint8_t typeId = value.index();
-    if (!MarshalBasicTypeToBuffer(oss, typeId)) {
-        return false;
-    }
-    switch (typeId) {
-        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_NULL): {
-            return oss.good();
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_INT): {
-            int val = std::get<int>(value);
-            if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_DOUBLE): {
-            double val = std::get<double>(value);
-            if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_STRING): {
-            std::string val = std::get<std::string>(value);
-            if (!MarshalStringToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_BOOL): {
-            bool val = std::get<bool>(value);
-            if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_LONG): {
-            int64_t val = std::get<int64_t>(value);
-            if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
-            break;
-        }
-        default:
-            LOG_ERROR("MarshalSingleTypeToBuffer: unknown typeId");
-            return false;
-    }
-    return oss.good();
-}
-
-bool MarshalSingleTypeVecToBuffer(std::ostringstream &oss, const std::vector<SingleValue::Type> &values)
-{
-    // write vector size
-    size_t len = values.size();
-    if (!MarshalBasicTypeToBuffer(oss, len)) {
-        return false;
-    }
-    for (const auto &it : values) {
-        if (!MarshalSingleTypeToBuffer(oss, it)) {
-            return false;
-        }
-    }
-    return oss.good();
-}
-
-bool MarshalMultiTypeToBuffer(std::ostringstream &oss, const MutliValue::Type &value)
-{
-    uint8_t typeId = value.index();
-    if (!MarshalBasicTypeToBuffer(oss, typeId)) {
-        return false;
-    }
-    // add offset of TYPE_NULL
-    typeId += static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_NULL);
-    switch (typeId) {
-        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_NULL): {
-            return oss.good();
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_INT_VECTOR): {
-            std::vector<int> val = std::get<std::vector<int>>(value);
-            if (!MarshalBasicTypeVecToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_DOUBLE_VECTOR): {
-            std::vector<double> val = std::get<std::vector<double>>(value);
-            if (!MarshalBasicTypeVecToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_LONG_VECTOR): {
-            std::vector<int64_t> val = std::get<std::vector<int64_t>>(value);
-            if (!MarshalBasicTypeVecToBuffer(oss, val)) { return false; }
-            break;
-        }
-        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_STRING_VECTOR): {
-            auto val = std::get<std::vector<std::string>>(value);
-            if (!MarshalStringVecToBuffer(oss, val)) { return false; }
-            break;
-        }
-        default:
-            LOG_ERROR("MarshalMultiTypeToBuffer: unknown typeId");
-            return false;
-    }
-    return oss.good();
-}
-
-bool MarshalMultiTypeVecToBuffer(std::ostringstream &oss, const std::vector<MutliValue::Type> &values)
-{
-    size_t len = values.size();
-    if (!MarshalBasicTypeToBuffer(oss, len)) {
-        return false;
-    }
-    for (const auto &it : values) {
-        if (!MarshalMultiTypeToBuffer(oss, it)) {
-            return false;
-        }
-    }
-    return oss.good();
-}
-
-bool MarshalOperationItemToBuffer(std::ostringstream &oss, const OperationItem &value)
-{
-    int32_t operation = value.operation;
-    std::vector<SingleValue::Type> singleParams = value.singleParams;
-    std::vector<MutliValue::Type> multiParams = value.multiParams;
-
-    // Serialize operation
-    if (!MarshalBasicTypeToBuffer(oss, operation)) {
-        return false;
-    }
-    // Serialize singleParams
-    if (!MarshalSingleTypeVecToBuffer(oss, singleParams)) {
-        return false;
-    }
-    // Serialize multiParams
-    if (!MarshalMultiTypeVecToBuffer(oss, multiParams)) {
-        return false;
-    }
-    return oss.good();
-}
-
-bool MarshalOperationItemVecToBuffer(std::ostringstream &oss, const std::vector<OperationItem> &values)
-{
-    size_t len = values.size();
-    if (!MarshalBasicTypeToBuffer(oss, len)) {
-        return false;
-    }
-    for (const auto &it : values) {
-        if (!MarshalOperationItemToBuffer(oss, it)) {
-            return false;
-        }
-    }
-    return oss.good();
-}
-
-bool MarshalPredicatesToBuffer(std::ostringstream &oss, const DataSharePredicates &predicates)
-{
-    // Extract all members of predicates
-    const std::vector<OperationItem> &operations = predicates.GetOperationList();
-    std::string whereClause = predicates.GetWhereClause();
-    std::vector<std::string> whereArgs = predicates.GetWhereArgs();
-    std::string order = predicates.GetOrder();
-    short mode = predicates.GetSettingMode();
-
-    // Serialize operations
-    if (!MarshalOperationItemVecToBuffer(oss, operations)) {
-        return false;
-    }
-    // Serialize whereClause
-    if (!MarshalStringToBuffer(oss, whereClause)) {
-        return false;
-    }
-    // Serialize whereArgs
-    if (!MarshalStringVecToBuffer(oss, whereArgs)) {
-        return false;
-    }
-    // Serialize order
-    if (!MarshalStringToBuffer(oss, order)) {
-        return false;
-    }
-    // Serialize mode
-    if (!MarshalBasicTypeToBuffer(oss, mode)) {
-        return false;
-    }
-    return oss.good();
-}
-
 template <typename T>
 bool UnmarshalBasicTypeToBuffer(std::istringstream &iss, T &value)
 {
@@ -1062,95 +1040,527 @@ bool UnmarshalPredicatesToBuffer(std::istringstream &iss, DataSharePredicates &p
     return iss.good();
 }
 
-bool MarshalPredicates(const Predicates &predicates, MessageParcel &parcel)
+namespace {
+// Leads the flat layout in place of the legacy length, legacy readers reject it as an invalid length
+constexpr int32_t FLAT_FORMAT_V1 = -1;
+
+/**
+ * Appends the flat layout to a caller sized buffer, without a buffer it only measures the layout.
+ */
+class FlatWriter {
+public:
+    FlatWriter() = default;
+    FlatWriter(uint8_t *buffer, size_t capacity) : buffer_(buffer), capacity_(capacity) {}
+
+    bool Write(const void *data, size_t size)
+    {
+        if (size > MAX_IPC_SIZE - size_) {
+            return false;
+        }
+        if (buffer_ != nullptr && size > 0 &&
+            (size > capacity_ - size_ || memcpy_s(buffer_ + size_, capacity_ - size_, data, size) != EOK)) {
+            return false;
+        }
+        size_ += size;
+        return true;
+    }
+
+    template <typename T>
+    bool Write(const T &value)
+    {
+        return Write(&value, sizeof(T));
+    }
+
+    bool WriteCount(size_t count)
+    {
+        return count <= UINT32_MAX && Write(static_cast<uint32_t>(count));
+    }
+
+    bool WriteBool(bool value)
+    {
+        return Write(static_cast<uint8_t>(value));
+    }
+
+    bool WriteString(const std::string &value)
+    {
+        return WriteCount(value.size()) && Write(value.data(), value.size());
+    }
+
+    template <typename T>
+    bool WriteVector(const std::vector<T> &values)
+    {
+        return WriteCount(values.size()) && Write(values.data(), values.size() * sizeof(T));
+    }
+
+    bool WriteStringVector(const std::vector<std::string> &values)
+    {
+        if (!WriteCount(values.size())) {
+            return false;
+        }
+        for (const auto &value : values) {
+            if (!WriteString(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t Size() const
+    {
+        return size_;
+    }
+
+private:
+    uint8_t *buffer_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+};
+
+/**
+ * Decodes the flat layout straight from the parcel data.
+ */
+class FlatReader {
+public:
+    FlatReader(const uint8_t *data, size_t size) : cursor_(data), end_(data + size) {}
+
+    bool Read(void *data, size_t size)
+    {
+        if (size > Remain()) {
+            return false;
+        }
+        if (size > 0 && memcpy_s(data, size, cursor_, size) != EOK) {
+            return false;
+        }
+        cursor_ += size;
+        return true;
+    }
+
+    template <typename T>
+    bool Read(T &value)
+    {
+        return Read(&value, sizeof(T));
+    }
+
+    // Every counted item takes at least unitSize bytes, so a count beyond the rest of the data is corrupt.
+    bool ReadCount(size_t &count, size_t unitSize)
+    {
+        uint32_t value = 0;
+        if (!Read(value) || (unitSize > 0 && value > Remain() / unitSize)) {
+            return false;
+        }
+        count = value;
+        return true;
+    }
+
+    bool ReadBool(bool &value)
+    {
+        uint8_t byte = 0;
+        if (!Read(byte)) {
+            return false;
+        }
+        value = byte != 0;
+        return true;
+    }
+
+    bool ReadString(std::string &value)
+    {
+        size_t len = 0;
+        if (!ReadCount(len, sizeof(char))) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char *>(cursor_), len);
+        cursor_ += len;
+        return true;
+    }
+
+    template <typename T>
+    bool ReadVector(std::vector<T> &values)
+    {
+        size_t len = 0;
+        if (!ReadCount(len, sizeof(T))) {
+            return false;
+        }
+        values.resize(len);
+        return Read(values.data(), len * sizeof(T));
+    }
+
+    bool ReadStringVector(std::vector<std::string> &values)
+    {
+        size_t len = 0;
+        if (!ReadCount(len, sizeof(uint32_t))) {
+            return false;
+        }
+        for (size_t i = 0; i < len; i++) {
+            if (!ReadString(values.emplace_back())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    size_t Remain() const
+    {
+        return static_cast<size_t>(end_ - cursor_);
+    }
+
+    const uint8_t *cursor_;
+    const uint8_t *end_;
+};
+
+bool MarshalFlat(FlatWriter &writer, const SingleValue::Type &value)
 {
-    std::ostringstream oss;
-    if (!MarshalPredicatesToBuffer(oss, predicates)) {
-        LOG_ERROR("MarshalPredicatesToBuffer failed.");
+    uint8_t typeId = value.index();
+    if (!writer.Write(typeId)) {
         return false;
     }
-    std::string str = oss.str();
-    size_t size = str.length();
-    if (size > MAX_IPC_SIZE) {
-        LOG_ERROR("Size of predicates is too large.");
+    switch (typeId) {
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_NULL):
+            return true;
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_INT):
+            return writer.Write(std::get<int>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_DOUBLE):
+            return writer.Write(std::get<double>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_STRING):
+            return writer.WriteString(std::get<std::string>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_BOOL):
+            return writer.WriteBool(std::get<bool>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_LONG):
+            return writer.Write(std::get<int64_t>(value));
+        default:
+            LOG_ERROR("MarshalFlat: unknown single typeId %{public}u", typeId);
+            return false;
+    }
+}
+
+bool UnmarshalFlat(FlatReader &reader, SingleValue::Type &value)
+{
+    uint8_t typeId = 0;
+    if (!reader.Read(typeId)) {
         return false;
     }
-    if (!parcel.WriteInt32(size)) {
-        LOG_ERROR("Write size failed.");
+    switch (typeId) {
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_NULL):
+            return true;
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_INT):
+            return reader.Read(value.emplace<int>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_DOUBLE):
+            return reader.Read(value.emplace<double>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_STRING):
+            return reader.ReadString(value.emplace<std::string>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_BOOL):
+            return reader.ReadBool(value.emplace<bool>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectType::TYPE_LONG):
+            return reader.Read(value.emplace<int64_t>());
+        default:
+            LOG_ERROR("UnmarshalFlat: unknown single typeId %{public}u", typeId);
+            return false;
+    }
+}
+
+bool MarshalFlat(FlatWriter &writer, const MutliValue::Type &value)
+{
+    uint8_t typeId = value.index();
+    if (!writer.Write(typeId)) {
         return false;
     }
-    return parcel.WriteRawData(reinterpret_cast<const void *>(str.data()), size);
+    // add offset of TYPE_NULL
+    switch (typeId + static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_NULL)) {
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_NULL):
+            return true;
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_INT_VECTOR):
+            return writer.WriteVector(std::get<std::vector<int>>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_LONG_VECTOR):
+            return writer.WriteVector(std::get<std::vector<int64_t>>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_DOUBLE_VECTOR):
+            return writer.WriteVector(std::get<std::vector<double>>(value));
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_STRING_VECTOR):
+            return writer.WriteStringVector(std::get<std::vector<std::string>>(value));
+        default:
+            LOG_ERROR("MarshalFlat: unknown multi typeId %{public}u", typeId);
+            return false;
+    }
 }
 
-bool UnmarshalPredicates(Predicates &predicates, MessageParcel &parcel)
+bool UnmarshalFlat(FlatReader &reader, MutliValue::Type &value)
 {
-    int32_t length = parcel.ReadInt32();
-    if (length < 1) {
-        LOG_ERROR("Length of predicates is invalid.");
+    uint8_t typeId = 0;
+    if (!reader.Read(typeId)) {
         return false;
     }
-    if (static_cast<size_t>(length) > MAX_IPC_SIZE) {
-        LOG_ERROR("Length of predicates is too large.");
+    // add offset of TYPE_NULL
+    switch (typeId + static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_NULL)) {
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_NULL):
+            return true;
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_INT_VECTOR):
+            return reader.ReadVector(value.emplace<std::vector<int>>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_LONG_VECTOR):
+            return reader.ReadVector(value.emplace<std::vector<int64_t>>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_DOUBLE_VECTOR):
+            return reader.ReadVector(value.emplace<std::vector<double>>());
+        case static_cast<uint8_t>(DataSharePredicatesObjectsType::TYPE_STRING_VECTOR):
+            return reader.ReadStringVector(value.emplace<std::vector<std::string>>());
+        default:
+            LOG_ERROR("UnmarshalFlat: unknown multi typeId %{public}u", typeId);
+            return false;
+    }
+}
+
+template <typename T>
+bool MarshalFlatVec(FlatWriter &writer, const std::vector<T> &values)
+{
+    if (!writer.WriteCount(values.size())) {
         return false;
     }
-    const char *buffer = reinterpret_cast<const char *>(parcel.ReadRawData(static_cast<size_t>(length)));
-    if (buffer == nullptr) {
-        LOG_ERROR("ReadRawData failed.");
+    for (const auto &value : values) {
+        if (!MarshalFlat(writer, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool UnmarshalFlatVec(FlatReader &reader, std::vector<T> &values)
+{
+    size_t len = 0;
+    // Every item starts with at least one byte.
+    if (!reader.ReadCount(len, sizeof(uint8_t))) {
         return false;
     }
-    std::istringstream iss(std::string(buffer, length));
-    return UnmarshalPredicatesToBuffer(iss, predicates);
+    for (size_t i = 0; i < len; i++) {
+        if (!UnmarshalFlat(reader, values.emplace_back())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MarshalFlat(FlatWriter &writer, const OperationItem &item)
+{
+    return writer.Write(item.operation) && MarshalFlatVec(writer, item.singleParams) &&
+        MarshalFlatVec(writer, item.multiParams);
+}
+
+bool UnmarshalFlat(FlatReader &reader, OperationItem &item)
+{
+    return reader.Read(item.operation) && UnmarshalFlatVec(reader, item.singleParams) &&
+        UnmarshalFlatVec(reader, item.multiParams);
+}
+
+bool MarshalFlat(FlatWriter &writer, const DataSharePredicates &predicates)
+{
+    return MarshalFlatVec(writer, predicates.GetOperationList()) && writer.WriteString(predicates.GetWhereClause()) &&
+        writer.WriteStringVector(predicates.GetWhereArgs()) && writer.WriteString(predicates.GetOrder()) &&
+        writer.Write(predicates.GetSettingMode());
+}
+
+bool UnmarshalFlat(FlatReader &reader, DataSharePredicates &predicates)
+{
+    std::vector<OperationItem> operations;
+    std::string whereClause;
+    std::vector<std::string> whereArgs;
+    std::string order;
+    int16_t mode = 0;
+    if (!UnmarshalFlatVec(reader, operations) || !reader.ReadString(whereClause) ||
+        !reader.ReadStringVector(whereArgs) || !reader.ReadString(order) || !reader.Read(mode)) {
+        LOG_ERROR("Unmarshal predicates failed.");
+        return false;
+    }
+    predicates.SetOperationList(std::move(operations));
+    predicates.SetWhereClause(whereClause);
+    predicates.SetWhereArgs(whereArgs);
+    predicates.SetOrder(order);
+    predicates.SetSettingMode(mode);
+    return true;
 }
 
-bool MarshalValuesBucketToBuffer(std::ostringstream &oss, const DataShareValuesBucket &bucket)
+bool MarshalFlat(FlatWriter &writer, const DataShareValuesBucket &bucket)
 {
-    // marshal valuesMap size
-    size_t mapSize = bucket.valuesMap.size();
-    if (!MarshalBasicTypeToBuffer(oss, mapSize)) {
-        LOG_ERROR("Marshal valuesMap size failed");
+    if (!writer.WriteCount(bucket.valuesMap.size())) {
         return false;
     }
     for (const auto &[key, value] : bucket.valuesMap) {
-        // write key
-        if (!MarshalStringToBuffer(oss, key)) { return false; }
-        // write typeId
         uint8_t typeId = value.index();
-        if (!MarshalBasicTypeToBuffer(oss, typeId)) { return false; }
+        if (!writer.WriteString(key) || !writer.Write(typeId)) {
+            return false;
+        }
+        bool result = true;
         switch (typeId) {
-            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_NULL): {
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_NULL):
+                break;
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_INT):
+                result = writer.Write(std::get<int64_t>(value));
+                break;
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_DOUBLE):
+                result = writer.Write(std::get<double>(value));
+                break;
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_STRING):
+                result = writer.WriteString(std::get<std::string>(value));
+                break;
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_BOOL):
+                result = writer.WriteBool(std::get<bool>(value));
+                break;
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_BLOB):
+                result = writer.WriteVector(std::get<std::vector<uint8_t>>(value));
+                break;
+            default:
+                LOG_ERROR("MarshalFlat: unknown value typeId %{public}u", typeId);
+                return false;
+        }
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool UnmarshalFlat(FlatReader &reader, DataShareValuesBucket &bucket)
+{
+    size_t mapSize = 0;
+    // Every value takes at least its key length and its typeId.
+    if (!reader.ReadCount(mapSize, sizeof(uint32_t) + sizeof(uint8_t))) {
+        return false;
+    }
+    for (size_t i = 0; i < mapSize; i++) {
+        std::string key;
+        uint8_t typeId = 0;
+        if (!reader.ReadString(key) || !reader.Read(typeId)) {
+            return false;
+        }
+        DataShareValueObject::Type value;
+        bool result = true;
+        switch (typeId) {
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_NULL):
+                // Same as the legacy layout, a null value leaves the column out.
                 continue;
-            }
-            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_INT): {
-                int64_t val = std::get<int64_t>(value);
-                if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_INT):
+                result = reader.Read(value.emplace<int64_t>());
                 break;
-            }
-            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_DOUBLE): {
-                double val = std::get<double>(value);
-                if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_DOUBLE):
+                result = reader.Read(value.emplace<double>());
                 break;
-            }
-            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_STRING): {
-                std::string val = std::get<std::string>(value);
-                if (!MarshalStringToBuffer(oss, val)) { return false; }
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_STRING):
+                result = reader.ReadString(value.emplace<std::string>());
                 break;
-            }
-            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_BOOL): {
-                bool val = std::get<bool>(value);
-                if (!MarshalBasicTypeToBuffer(oss, val)) { return false; }
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_BOOL):
+                result = reader.ReadBool(value.emplace<bool>());
                 break;
-            }
-            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_BLOB): {
-                std::vector<uint8_t> val = std::get<std::vector<uint8_t>>(value);
-                if (!MarshalBasicTypeVecToBuffer(oss, val)) { return false; }
+            case static_cast<uint8_t>(DataShareValueObjectType::TYPE_BLOB):
+                result = reader.ReadVector(value.emplace<std::vector<uint8_t>>());
                 break;
-            }
             default:
-                LOG_ERROR("MarshalValuesBucketToBuffer: unknown typeId");
+                LOG_ERROR("UnmarshalFlat: unknown value typeId %{public}u", typeId);
                 return false;
         }
+        if (!result) {
+            return false;
+        }
+        // The keys come in map order, so every insertion lands at the end.
+        bucket.valuesMap.emplace_hint(bucket.valuesMap.end(), std::move(key), std::move(value));
     }
-    return oss.good();
+    return true;
+}
+
+bool MarshalFlat(FlatWriter &writer, const OperationStatement &statement)
+{
+    if (!statement.IsOperationTypeValid()) {
+        // existing marshalling use static cast on enum, only log when operationType exceeds defined types
+        LOG_ERROR("operationType Invalid:%{public}d", statement.operationType);
+    }
+    return writer.Write(statement.operationType) && writer.WriteString(statement.uri) &&
+        MarshalFlat(writer, statement.predicates) && MarshalFlat(writer, statement.valuesBucket) &&
+        writer.WriteString(statement.backReference.GetColumn()) && writer.Write(statement.backReference.GetFromIndex());
+}
+
+bool UnmarshalFlat(FlatReader &reader, OperationStatement &statement)
+{
+    std::string column;
+    int32_t fromIndex = 0;
+    if (!reader.Read(statement.operationType) || !reader.ReadString(statement.uri) ||
+        !UnmarshalFlat(reader, statement.predicates) || !UnmarshalFlat(reader, statement.valuesBucket) ||
+        !reader.ReadString(column) || !reader.Read(fromIndex)) {
+        return false;
+    }
+    if (!statement.IsOperationTypeValid()) {
+        // existing marshalling use static cast on enum, only log when operationType exceeds defined types
+        LOG_ERROR("operationType Invalid:%{public}d", statement.operationType);
+    }
+    statement.backReference.SetColumn(column);
+    statement.backReference.SetFromIndex(fromIndex);
+    return true;
+}
+
+/**
+ * Measures the flat layout first, so it is encoded into one buffer and copied to the parcel once.
+ */
+template <typename F>
+bool WriteFlat(MessageParcel &parcel, F marshal)
+{
+    FlatWriter measure;
+    if (!marshal(measure)) {
+        LOG_ERROR("Measure flat data failed.");
+        return false;
+    }
+    size_t size = measure.Size();
+    std::unique_ptr<uint8_t[]> buffer = std::make_unique<uint8_t[]>(size);
+    FlatWriter writer(buffer.get(), size);
+    if (!marshal(writer) || writer.Size() != size) {
+        LOG_ERROR("Marshal flat data failed.");
+        return false;
+    }
+    if (!parcel.WriteInt32(FLAT_FORMAT_V1) || !parcel.WriteInt32(static_cast<int32_t>(size))) {
+        LOG_ERROR("Write size failed.");
+        return false;
+    }
+    return parcel.WriteRawData(reinterpret_cast<const void *>(buffer.get()), size);
+}
+
+/**
+ * Reads the data of the flat layout, or of the legacy layout when isLegacy is set.
+ */
+const uint8_t *ReadFlatData(MessageParcel &parcel, size_t &size, bool &isLegacy)
+{
+    int32_t head = parcel.ReadInt32();
+    isLegacy = head != FLAT_FORMAT_V1;
+    int32_t length = isLegacy ? head : parcel.ReadInt32();
+    if (length < 1) {
+        LOG_ERROR("Length of data is invalid:%{public}d", length);
+        return nullptr;
+    }
+    if (static_cast<size_t>(length) > MAX_IPC_SIZE) {
+        LOG_ERROR("Length of data exceed limit:%{public}d", length);
+        return nullptr;
+    }
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(parcel.ReadRawData(static_cast<size_t>(length)));
+    if (data == nullptr) {
+        LOG_ERROR("ReadRawData failed.");
+        return nullptr;
+    }
+    size = static_cast<size_t>(length);
+    return data;
+}
+} // namespace
+
+bool MarshalPredicates(const Predicates &predicates, MessageParcel &parcel)
+{
+    return WriteFlat(parcel, [&predicates](FlatWriter &writer) { return MarshalFlat(writer, predicates); });
+}
+
+bool UnmarshalPredicates(Predicates &predicates, MessageParcel &parcel)
+{
+    size_t size = 0;
+    bool isLegacy = false;
+    const uint8_t *data = ReadFlatData(parcel, size, isLegacy);
+    if (data == nullptr) {
+        return false;
+    }
+    if (isLegacy) {
+        std::istringstream iss(std::string(reinterpret_cast<const char *>(data), size));
+        return UnmarshalPredicatesToBuffer(iss, predicates);
+    }
+    FlatReader reader(data, size);
+    return UnmarshalFlat(reader, predicates);
 }
 
 bool UnmarshalValuesBucketToBuffer(std::istringstream &iss,
@@ -1208,20 +1618,6 @@ bool UnmarshalValuesBucketToBuffer(std::istringstream &iss,
     return iss.good();
 }
 
-bool MarshalValuesBucketVecToBuffer(std::ostringstream &oss, const std::vector<DataShareValuesBucket> &values)
-{
-    size_t size = values.size();
-    if (!MarshalBasicTypeToBuffer(oss, size)) {
-        return false;
-    }
-    for (const auto &bucket : values) {
-        if (!MarshalValuesBucketToBuffer(oss, bucket)) {
-            return false;
-        }
-    }
-    return oss.good();
-}
-
 bool UnmarshalValuesBucketVecToBuffer(std::istringstream &iss, std::vector<DataShareValuesBucket> &values)
 {
     size_t size;
@@ -1238,42 +1634,23 @@ bool UnmarshalValuesBucketVecToBuffer(std::istringstream &iss, std::vector<DataS
 
 bool MarshalValuesBucketVec(const std::vector<DataShareValuesBucket> &values, MessageParcel &parcel)
 {
-    std::ostringstream oss;
-    if (!MarshalValuesBucketVecToBuffer(oss, values)) {
-        LOG_ERROR("MarshalValuesBucketVecToBuffer failed.");
-        return false;
-    }
-    std::string str = oss.str();
-    size_t size = str.length();
-    if (size > MAX_IPC_SIZE) {
-        LOG_ERROR("Size of ValuesBucketVec is too large.");
-        return false;
-    }
-    if (!parcel.WriteInt32(size)) {
-        LOG_ERROR("Write size failed.");
-        return false;
-    }
-    return parcel.WriteRawData(reinterpret_cast<const void *>(str.data()), size);
+    return WriteFlat(parcel, [&values](FlatWriter &writer) { return MarshalFlatVec(writer, values); });
 }
 
 bool UnmarshalValuesBucketVec(std::vector<DataShareValuesBucket> &values, MessageParcel &parcel)
 {
-    int32_t length = parcel.ReadInt32();
-    if (length < 1) {
-        LOG_ERROR("Length of ValuesBucketVec is invalid.");
+    size_t size = 0;
+    bool isLegacy = false;
+    const uint8_t *data = ReadFlatData(parcel, size, isLegacy);
+    if (data == nullptr) {
         return false;
     }
-    if (static_cast<size_t>(length) > MAX_IPC_SIZE) {
-        LOG_ERROR("Length of ValuesBucketVec is too large.");
-        return false;
-    }
-    const char *buffer = reinterpret_cast<const char *>(parcel.ReadRawData(static_cast<size_t>(length)));
-    if (buffer == nullptr) {
-        LOG_ERROR("ReadRawData failed.");
-        return false;
+    if (isLegacy) {
+        std::istringstream iss(std::string(reinterpret_cast<const char *>(data), size));
+        return UnmarshalValuesBucketVecToBuffer(iss, values);
     }
-    std::istringstream iss(std::string(buffer, length));
-    return UnmarshalValuesBucketVecToBuffer(iss, values);
+    FlatReader reader(data, size);
+    return UnmarshalFlatVec(reader, values);
 }
 
 template<>
@@ -1288,19 +1665,6 @@ bool Unmarshalling(RegisterOption &option, MessageParcel &parcel)
     return ITypesUtil::Unmarshal(parcel, option.isReconnect);
 }
 
-bool MarshalBackReferenceToBuffer(std::ostringstream &oss, const BackReference &backReference)
-{
-    if (!MarshalStringToBuffer(oss, backReference.GetColumn())) {
-        LOG_ERROR("Marshal column failed.");
-        return false;
-    }
-    if (!MarshalBasicTypeToBuffer(oss, backReference.GetFromIndex())) {
-        LOG_ERROR("Marshal fromIndex failed.");
-        return false;
-    }
-    return oss.good();
-}
-
 bool UnmarshalBackReferenceToBuffer(std::istringstream &iss, BackReference &backReference)
 {
     std::string column = "";
@@ -1318,45 +1682,6 @@ bool UnmarshalBackReferenceToBuffer(std::istringstream &iss, BackReference &back
     return iss.good();
 }
 
-bool MarshalOperationStatementVecToBuffer(std::ostringstream &oss,
-                                          const std::vector<OperationStatement> &operationStatements)
-{
-    size_t size = operationStatements.size();
-    if (!MarshalBasicTypeToBuffer(oss, size)) {
-        LOG_ERROR("Marshal vec size failed.");
-        return false;
-    }
-    size_t index = 0;
-    for (const auto &statement : operationStatements) {
-        if (!statement.IsOperationTypeValid()) {
-            // existing marshalling use static cast on enum, only log when operationType exceeds defined types
-            LOG_ERROR("operationType Invalid:%{public}d, index:%{public}zu", statement.operationType, index);
-        }
-        if (!MarshalBasicTypeToBuffer(oss, statement.operationType)) {
-            LOG_ERROR("Marshal operationType failed.");
-            return false;
-        }
-        if (!MarshalStringToBuffer(oss, statement.uri)) {
-            LOG_ERROR("Marshal uri failed.");
-            return false;
-        }
-        if (!MarshalPredicatesToBuffer(oss, statement.predicates)) {
-            LOG_ERROR("Marshal predicates failed.");
-            return false;
-        }
-        if (!MarshalValuesBucketToBuffer(oss, statement.valuesBucket)) {
-            LOG_ERROR("Marshal valuesBucket failed.");
-            return false;
-        }
-        if (!MarshalBackReferenceToBuffer(oss, statement.backReference)) {
-            LOG_ERROR("Marshal backReference failed.");
-            return false;
-        }
-        index += 1;
-    }
-    return oss.good();
-}
-
 bool UnmarshalOperationStatementVecToBuffer(std::istringstream &iss,
                                             std::vector<OperationStatement> &operationStatements)
 {
@@ -1400,42 +1725,25 @@ bool UnmarshalOperationStatementVecToBuffer(std::istringstream &iss,
 // Currently as a substitution for MarshalToBuffer
 bool MarshalOperationStatementVec(const std::vector<OperationStatement> &operationStatements, MessageParcel &parcel)
 {
-    std::ostringstream oss;
-    if (!MarshalOperationStatementVecToBuffer(oss, operationStatements)) {
-        LOG_ERROR("MarshalOperationStatementVecToBuffer failed.");
-        return false;
-    }
-    std::string str = oss.str();
-    size_t size = str.length();
-    if (size > MAX_IPC_SIZE) {
-        LOG_ERROR("Size of OperationStatementVec exceed limit:%{public}zu", size);
-        return false;
-    }
-    if (!parcel.WriteInt32(size)) {
-        LOG_ERROR("Write size failed.");
-        return false;
-    }
-    return parcel.WriteRawData(reinterpret_cast<const void *>(str.data()), size);
+    return WriteFlat(parcel, [&operationStatements](FlatWriter &writer) {
+        return MarshalFlatVec(writer, operationStatements);
+    });
 }
 
 bool UnmarshalOperationStatementVec(std::vector<OperationStatement> &operationStatements, MessageParcel &parcel)
 {
-    int32_t length = parcel.ReadInt32();
-    if (length < 1) {
-        LOG_ERROR("Length of OperationStatementVec is invalid:%{public}d", length);
+    size_t size = 0;
+    bool isLegacy = false;
+    const uint8_t *data = ReadFlatData(parcel, size, isLegacy);
+    if (data == nullptr) {
         return false;
     }
-    if (static_cast<size_t>(length) > MAX_IPC_SIZE) {
-        LOG_ERROR("Length of OperationStatementVec exceed limit:%{public}d", length);
-        return false;
+    if (isLegacy) {
+        std::istringstream iss(std::string(reinterpret_cast<const char *>(data), size));
+        return UnmarshalOperationStatementVecToBuffer(iss, operationStatements);
     }
-    const char *buffer = reinterpret_cast<const char *>(parcel.ReadRawData(static_cast<size_t>(length)));
-    if (buffer == nullptr) {
-        LOG_ERROR("ReadRawData failed.");
-        return false;
-    }
-    std::istringstream iss(std::string(buffer, length));
-    return UnmarshalOperationStatementVecToBuffer(iss, operationStatements);
+    FlatReader reader(data, size);
+    return UnmarshalFlatVec(reader, operationStatements);
 }
 
 bool MarshalDataProxyValueToBuffer(std::ostringstream &oss, const DataProxyValue &value)
@@ -13,7 +13,6 @@
  * limitations under the License.
  */
 #define LOG_TAG "datashare_predicates_verify"
-#include <regex>
 
 #include "datashare_predicates_verify.h"
 
@@ -30,41 +29,73 @@ static const std::set<OperationType> SINGLE_3_PARAMS_SYS_SET = { NOT_EQUAL_TO, G
     BETWEEN, NOTBETWEEN };
 static const std::set<OperationType> MULTI_2_PARAMS_SYS_SET = { IN_KEY, GROUP_BY };
 
-// colName or (colName) or [colName] or "colName"
-// allows leading/trailing spaces
-static const std::regex COLNAME_OPTIONAL_BRACKETS(
-    "^\\s*([a-zA-Z0-9_]+)\\s*$|"
-    "^\\s*\\(([a-zA-Z0-9_]+)\\)\\s*$|"
-    "^\\s*\\[([a-zA-Z0-9_]+)\\]\\s*$|"
-    "^\\s*\"([a-zA-Z0-9_]+)\"\\s*$"
-);
+// A field is accepted when, after trimming leading and trailing spaces, it is one of
+//     colName, tableName.colName, store.table.colName or $.colName
+// optionally wrapped in (), [] or "", where every name is made of [a-zA-Z0-9_]+.
+// The fields are scanned once by hand, they used to be matched against four std::regex patterns each.
+static constexpr size_t MAX_NAME_SEGMENTS = 3;
+static constexpr size_t JSON_PATH_SEGMENTS = 2;
 
-// tableName.colName or (tableName.colName) or [tableName.colName] or "tableName.colName"
-// allows leading/trailing spaces
-static const std::regex TABLENAME_DOT_COLNAME_OPTIONAL_BRACKETS(
-    "^\\s*([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\s*$|"
-    "^\\s*\\(([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\)\\s*$|"
-    "^\\s*\\[([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\]\\s*$|"
-    "^\\s*\"([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\"\\s*$"
-);
+static bool IsSpaceChar(char c)
+{
+    // same set as \s of std::regex: ' ', '\t', '\n', '\v', '\f', '\r'
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
 
-// $.colName or ($.colName) or [$.colName] or "$.colName"
-// allows leading/trailing spaces
-static const std::regex AMPERSAND_DOT_COLNAME_OPTIONAL_BRACKETS(
-    "^\\s*(\\$\\.[a-zA-Z0-9_]+)\\s*$|"
-    "^\\s*\\((\\$\\.[a-zA-Z0-9_]+)\\)\\s*$|"
-    "^\\s*\\[(\\$\\.[a-zA-Z0-9_]+)\\]\\s*$|"
-    "^\\s*\"(\\$\\.[a-zA-Z0-9_]+)\"\\s*$"
-);
+static bool IsNameChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
 
-// store.table.colName or (store.table.colName) or [store.table.colName] or "store.table.colName"
-// allows leading/trailing spaces
-static const std::regex STORE_TABLE_COLNAME_OPTIONAL_BRACKETS(
-    "^\\s*([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\s*$|"
-    "^\\s*\\(([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\)\\s*$|"
-    "^\\s*\\[([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\]\\s*$|"
-    "^\\s*\"([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\"\\s*$"
-);
+static char GetClosingBracket(char c)
+{
+    switch (c) {
+        case '(':
+            return ')';
+        case '[':
+            return ']';
+        case '"':
+            return '"';
+        default:
+            return '\0';
+    }
+}
+
+static const std::string &GetSingleField(const OperationItem &item)
+{
+    static const std::string emptyField;
+    auto field = std::get_if<std::string>(&item.singleParams[0]);
+    return field != nullptr ? *field : emptyField;
+}
+
+// Checks that [begin, end) is name, name.name, name.name.name or $.name
+static bool IsQualifiedName(const char *begin, const char *end)
+{
+    bool isJsonPath = begin != end && *begin == '$';
+    const char *pos = begin;
+    if (isJsonPath) {
+        pos++;
+        if (pos == end || *pos != '.') {
+            return false;
+        }
+    }
+    size_t segments = 1;
+    size_t segmentLen = isJsonPath ? 1 : 0;
+    for (; pos != end; pos++) {
+        if (IsNameChar(*pos)) {
+            segmentLen++;
+        } else if (*pos == '.' && segmentLen > 0 && segments < MAX_NAME_SEGMENTS) {
+            segments++;
+            segmentLen = 0;
+        } else {
+            return false;
+        }
+    }
+    if (segmentLen == 0) {
+        return false;
+    }
+    return !isJsonPath || segments == JSON_PATH_SEGMENTS;
+}
 
 std::pair<int, int> DataSharePredicatesVerify::VerifyPredicates(const DataSharePredicates &predicates)
 {
@@ -106,18 +137,20 @@ int DataSharePredicatesVerify::VerifyPredicatesByType(const PredicatesVerifyType
     }
     // public interfaces add hiview when field invalid
     // system interfaces need return error when field illegal
+    // fields are checked in place, a field that is not a string is verified as an empty one
     if (verifyType == PredicatesVerifyType::SINGLE_2_PARAMS_PUBLIC ||
         verifyType == PredicatesVerifyType::SINGLE_3_PARAMS_PUBLIC) {
-        if (!VerifyField(item.GetSingle(0))) {
+        if (!VerifyField(GetSingleField(item))) {
             return E_FIELD_INVALID;
         }
     } else if (verifyType == PredicatesVerifyType::SINGLE_2_PARAMS_SYS ||
         verifyType == PredicatesVerifyType::SINGLE_3_PARAMS_SYS) {
-        if (!VerifyField(item.GetSingle(0))) {
+        if (!VerifyField(GetSingleField(item))) {
             return E_FIELD_ILLEGAL;
         }
     } else if (verifyType == PredicatesVerifyType::MULTI_2_PARAMS_SYS) {
-        if (!VerifyFields(MutliValue(item.multiParams[0]))) {
+        auto fields = std::get_if<std::vector<std::string>>(&item.multiParams[0]);
+        if (fields != nullptr && !VerifyFields(*fields)) {
             return E_FIELD_ILLEGAL;
         }
     }
@@ -141,10 +174,26 @@ bool DataSharePredicatesVerify::VerifyField(const std::string &field)
         LOG_WARN("field is empty");
         return true;
     }
-    return (std::regex_match(field, COLNAME_OPTIONAL_BRACKETS) ||
-        std::regex_match(field, TABLENAME_DOT_COLNAME_OPTIONAL_BRACKETS) ||
-        std::regex_match(field, AMPERSAND_DOT_COLNAME_OPTIONAL_BRACKETS) ||
-        std::regex_match(field, STORE_TABLE_COLNAME_OPTIONAL_BRACKETS));
+    const char *begin = field.data();
+    const char *end = begin + field.size();
+    while (begin != end && IsSpaceChar(*begin)) {
+        begin++;
+    }
+    while (end != begin && IsSpaceChar(*(end - 1))) {
+        end--;
+    }
+    if (begin == end) {
+        return false;
+    }
+    char closing = GetClosingBracket(*begin);
+    if (closing != '\0') {
+        if (end - begin < 2 || *(end - 1) != closing) {
+            return false;
+        }
+        begin++;
+        end--;
+    }
+    return IsQualifiedName(begin, end);
 }
 
 bool DataSharePredicatesVerify::VerifyFields(const std::vector<std::string> &fields)
@@ -18,22 +18,103 @@
 #include "datashare_result_set.h"
 
 #include <securec.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
 #include <sstream>
 
 #include "adaptor.h"
 #include "datashare_block_writer_impl.h"
+#include "datashare_common.h"
 #include "datashare_errno.h"
 #include "datashare_log.h"
+#include "ipc_skeleton.h"
 #include "parcel.h"
 #include "shared_block.h"
+#include "shared_block_pool.h"
 #include "string_ex.h"
 #include "ishared_result_set.h"
+#include "executor_pool.h"
 
 namespace OHOS {
 namespace DataShare {
 namespace {
 // The default position of the cursor
 static const int INITIAL_POS = -1;
+constexpr const char *PREFETCH_EXECUTOR_NAME = "DShare_Prefetch";
+
+std::shared_ptr<ExecutorPool> GetPrefetchExecutor()
+{
+    static std::shared_ptr<ExecutorPool> executor =
+        std::make_shared<ExecutorPool>(MAX_THREADS, MIN_THREADS, PREFETCH_EXECUTOR_NAME);
+    return executor;
+}
+
+void AppendBytes(DataShareResultSet::ColumnBuffer &column, const void *value, size_t size)
+{
+    if (value != nullptr && size > 0) {
+        const auto *bytes = static_cast<const uint8_t *>(value);
+        column.arena.insert(column.arena.end(), bytes, bytes + size);
+    }
+    column.offsets.push_back(static_cast<uint32_t>(column.arena.size()));
+}
+
+/**
+ * Appends the cell to the column the way GetLong, GetDouble, GetString and GetBlob convert it
+ */
+int AppendCell(AppDataFwk::SharedBlock &block, AppDataFwk::SharedBlock::CellUnit &cellUnit,
+    DataShareResultSet::ColumnBuffer &column)
+{
+    int type = cellUnit.type;
+    column.nulls.push_back(type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_NULL ? 1 : 0);
+    bool isText = type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_STRING;
+    bool isBytes = isText || type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_BLOB;
+    size_t size = 0;
+    const void *value = isBytes ? block.GetCellUnitValueBlob(&cellUnit, &size) : nullptr;
+    switch (column.type) {
+        case DataType::TYPE_INTEGER:
+            if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_INTEGER) {
+                column.longs.push_back(cellUnit.cell.longValue);
+            } else if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_FLOAT) {
+                column.longs.push_back(static_cast<int64_t>(cellUnit.cell.doubleValue));
+            } else {
+                bool hasText = isText && size > 1 && value != nullptr;
+                column.longs.push_back(hasText ? strtoll(static_cast<const char *>(value), nullptr, 0) : 0);
+            }
+            return E_OK;
+        case DataType::TYPE_FLOAT:
+            if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_FLOAT) {
+                column.doubles.push_back(cellUnit.cell.doubleValue);
+            } else if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_INTEGER) {
+                column.doubles.push_back(static_cast<double>(cellUnit.cell.longValue));
+            } else {
+                bool hasText = isText && size > 1 && value != nullptr;
+                column.doubles.push_back(hasText ? strtod(static_cast<const char *>(value), nullptr) : 0.0);
+            }
+            return E_OK;
+        case DataType::TYPE_STRING:
+            if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_INTEGER) {
+                std::string text = std::to_string(cellUnit.cell.longValue);
+                AppendBytes(column, text.data(), text.size());
+            } else if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_FLOAT) {
+                std::ostringstream os;
+                os << cellUnit.cell.doubleValue;
+                std::string text = os.str();
+                AppendBytes(column, text.data(), text.size());
+            } else if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_BLOB) {
+                LOG_ERROR("blob in string column %{public}d", column.columnIndex);
+                return E_ERROR;
+            } else {
+                AppendBytes(column, value, size > 0 ? size - 1 : 0);
+            }
+            return E_OK;
+        case DataType::TYPE_BLOB:
+            AppendBytes(column, value, size);
+            return E_OK;
+        default:
+            return E_INVALID_OBJECT_TYPE;
+    }
+}
 } // namespace
 std::atomic<int32_t> DataShareResultSet::blockId_ = 0;
 DataShareResultSet::DataShareResultSet()
@@ -43,17 +124,19 @@ DataShareResultSet::DataShareResultSet()
 DataShareResultSet::DataShareResultSet(std::shared_ptr<ResultSetBridge> &bridge, size_t blockSize)
     : bridge_(bridge)
 {
-    std::string name = "DataShare" + std::to_string(blockId_.fetch_add(1));
     if (blockSize > MAX_SHARE_BLOCK_SIZE) {
         LOG_ERROR("blockSize: %{public}zu over limit!", blockSize);
         return;
     }
-    blockWriter_ = std::make_shared<DataShareBlockWriterImpl>(name, blockSize);
-    if (blockWriter_ == nullptr) {
-        LOG_ERROR("blockWriter_ is null!");
+    auto block = SharedBlockPool::GetInstance().Acquire(blockSize);
+    if (block == nullptr) {
+        LOG_ERROR("sharedBlock is null!");
         return;
     }
-    sharedBlock_ = blockWriter_->GetBlock();
+    blockWriter_ = std::make_shared<DataShareBlockWriterImpl>(block);
+    sharedBlock_ = std::move(block);
+    blockSize_ = blockSize;
+    blockPooled_ = true;
 }
 
 DataShareResultSet::~DataShareResultSet()
@@ -78,22 +161,22 @@ int DataShareResultSet::GetRowCount(int &count)
         LOG_ERROR("bridge_ is null!");
         return E_ERROR;
     }
-    return bridge->GetRowCount(count);
+    if (GetStreamedRowCount(count)) {
+        return E_OK;
+    }
+    int errCode = bridge->GetRowCount(count);
+    count = CapStreamedRowCount(count);
+    return errCode;
 }
 
 bool DataShareResultSet::OnGo(int startRowIndex, int targetRowIndex, int *cachedIndex)
 {
-    auto block = GetBlock();
-    auto bridge = GetBridge();
-    if (bridge == nullptr || blockWriter_ == nullptr || block == nullptr) {
-        LOG_ERROR("bridge_ or blockWriter_ or sharedBlock_ is null!");
+    auto blockWriter = blockWriter_;
+    if (blockWriter == nullptr) {
+        LOG_ERROR("blockWriter_ is null!");
         return false;
     }
-    std::vector<std::string> columnNames;
-    GetAllColumnNames(columnNames);
-    block->Clear();
-    block->SetColumnNum(columnNames.size());
-    int result = bridge->OnGo(startRowIndex, targetRowIndex, *blockWriter_);
+    int result = FillByBridge(startRowIndex, targetRowIndex, *blockWriter);
     if (cachedIndex != nullptr) {
         *cachedIndex = result;
     }
@@ -108,6 +191,526 @@ void DataShareResultSet::FillBlock(int startRowIndex, AppDataFwk::SharedBlock *b
     return;
 }
 
+bool DataShareResultSet::FillWindow(int startRowIndex, int targetRowIndex,
+    std::shared_ptr<AppDataFwk::SharedBlock> block, int &endRowIndex)
+{
+    if (block == nullptr) {
+        LOG_ERROR("block is null!");
+        return false;
+    }
+    DataShareBlockWriterImpl writer(block);
+    endRowIndex = FillByBridge(startRowIndex, targetRowIndex, writer);
+    return endRowIndex >= 0;
+}
+
+bool DataShareResultSet::FillWindows(int startRowIndex, int targetRowIndex,
+    const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &blocks, std::vector<int> &endRowIndexes)
+{
+    endRowIndexes.clear();
+    int startRow = startRowIndex;
+    for (auto &block : blocks) {
+        int endRow = INITIAL_POS;
+        if (startRow > targetRowIndex || !FillWindow(startRow, targetRowIndex, block, endRow) || endRow < startRow) {
+            break;
+        }
+        endRowIndexes.push_back(endRow);
+        startRow = endRow + 1;
+    }
+    return !endRowIndexes.empty();
+}
+
+uint32_t DataShareResultSet::GetFillWindowsLimit()
+{
+    return 1;
+}
+
+bool DataShareResultSet::CanFillWindow()
+{
+    return true;
+}
+
+/**
+ * Falls back to OnGo on the base block for a provider that does not fill the windows of the consumer
+ */
+void DataShareResultSet::StopFillingWindows()
+{
+    if (IsPrefetchEnabled() || IsAdaptiveWindowEnabled()) {
+        LOG_WARN("provider does not fill windows, prefetch and adaptive window are stopped");
+    }
+    StopPrefetch();
+    StopAdaptiveWindow();
+}
+
+/**
+ * Clears the block of the writer and lets the bridge fill it, returns the last row filled or a negative value
+ */
+int DataShareResultSet::FillByBridge(int startRowIndex, int targetRowIndex, DataShareBlockWriterImpl &writer)
+{
+    auto block = writer.GetBlock();
+    auto bridge = GetBridge();
+    if (bridge == nullptr || block == nullptr) {
+        LOG_ERROR("bridge_ or block is null!");
+        return E_ERROR;
+    }
+    std::vector<std::string> columnNames;
+    GetAllColumnNames(columnNames);
+    std::lock_guard<std::mutex> lock(fillMutex_);
+    block->Clear();
+    block->SetColumnNum(columnNames.size());
+    return bridge->OnGo(startRowIndex, targetRowIndex, writer);
+}
+
+int DataShareResultSet::EnablePrefetch(const PrefetchOption &option)
+{
+    if (option.depth > MAX_PREFETCH_DEPTH) {
+        LOG_ERROR("prefetch depth %{public}u over limit!", option.depth);
+        return E_ERROR;
+    }
+    if (option.depth > 0 && IsAdaptiveWindowEnabled()) {
+        LOG_ERROR("prefetch does not work with the adaptive window!");
+        return E_ERROR;
+    }
+    int startRowPos = startRowPos_;
+    StopPrefetch();
+    if (startRowPos_ != startRowPos) {
+        // The cursor was on a borrowed window, its rows are read into the base block again.
+        int rowCount = GetCursorRowLimit();
+        int endPos = INITIAL_POS;
+        if (!OnGo(startRowPos, rowCount - 1, &endPos)) {
+            LOG_ERROR("OnGo fail pos %{public}d", startRowPos);
+            return E_ERROR;
+        }
+        startRowPos_ = startRowPos;
+        endRowPos_ = endPos;
+    }
+    if (option.depth == 0) {
+        return E_OK;
+    }
+    auto block = GetBlock();
+    if (block == nullptr) {
+        LOG_ERROR("sharedBlock is null!");
+        return E_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    prefetchOption_ = option;
+    prefetchStatistics_ = {};
+    baseBlock_ = block;
+    prefetchEnabled_ = true;
+    return E_OK;
+}
+
+void DataShareResultSet::SetSingleThreaded(bool singleThreaded)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    singleThreaded_.store(singleThreaded);
+}
+
+DataShareResultSet::PrefetchStatistics DataShareResultSet::GetPrefetchStatistics()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    return prefetchStatistics_;
+}
+
+void DataShareResultSet::StopPrefetch()
+{
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    if (!prefetchEnabled_) {
+        return;
+    }
+    prefetchEnabled_ = false;
+    prefetchGeneration_++;
+    prefetchCond_.wait(lock, [this]() { return !prefetchRunning_; });
+    prefetchWindows_.clear();
+    idleBlocks_.clear();
+    prefetchNextRow_ = INITIAL_POS;
+    if (currentWindow_ != nullptr) {
+        currentWindow_ = nullptr;
+        // Rows of a borrowed window are gone with it, the next move refills the base block.
+        std::unique_lock<std::shared_mutex> blockLock(mutex_);
+        sharedBlock_ = baseBlock_;
+        startRowPos_ = INITIAL_POS;
+        endRowPos_ = INITIAL_POS;
+    }
+    baseBlock_ = nullptr;
+}
+
+bool DataShareResultSet::IsPrefetchEnabled()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    return prefetchEnabled_;
+}
+
+/**
+ * Moves the cursor window onto position, from the prefetched windows if one holds it
+ */
+bool DataShareResultSet::MoveToWindow(int position, int rowCount, int &startPos, int &endPos)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    prefetchRowCount_ = rowCount;
+    int backwardRows = static_cast<int>(prefetchOption_.backwardRows);
+    bool result = true;
+    auto window = TakePrefetchedWindow(position, lock);
+    if (window != nullptr) {
+        prefetchStatistics_.hits++;
+        startPos = window->startRowPos;
+        endPos = window->endRowPos;
+        SetCurrentWindow(window);
+    } else {
+        prefetchStatistics_.misses++;
+        prefetchGeneration_++;
+        for (auto &prefetched : prefetchWindows_) {
+            RecycleWindowBlock(prefetched->block);
+        }
+        prefetchWindows_.clear();
+        prefetchNextRow_ = INITIAL_POS;
+        SetCurrentWindow(nullptr);
+        lock.unlock();
+        startPos = std::max(0, position - backwardRows);
+        result = OnGo(startPos, rowCount - 1, &endPos);
+        if (result && endPos < position) {
+            // The backward rows took the room of the target row.
+            startPos = position;
+            result = OnGo(startPos, rowCount - 1, &endPos);
+        }
+        lock.lock();
+    }
+    if (result) {
+        prefetchNextRow_ = endPos + 1;
+        SchedulePrefetch();
+    }
+    auto stall = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    prefetchStatistics_.stallTimeUs += static_cast<uint64_t>(stall.count());
+    return result;
+}
+
+/**
+ * Finds the prefetched window holding position, waiting for the window being filled if it may hold it
+ */
+std::shared_ptr<DataShareResultSet::PrefetchWindow> DataShareResultSet::TakePrefetchedWindow(int position,
+    std::unique_lock<std::mutex> &lock)
+{
+    auto holds = [position](const std::shared_ptr<PrefetchWindow> &window) {
+        return position >= window->startRowPos && position <= window->endRowPos;
+    };
+    auto it = std::find_if(prefetchWindows_.begin(), prefetchWindows_.end(), holds);
+    int nextRow = prefetchWindows_.empty() ? prefetchNextRow_ : prefetchWindows_.back()->endRowPos + 1;
+    int span = endRowPos_ - startRowPos_ + 1;
+    // Only a move onto the window right after the prefetched ones waits for the prefetch to catch up.
+    if (it == prefetchWindows_.end() && prefetchRunning_ && nextRow >= 0 && position >= nextRow &&
+        (span <= 0 || position - nextRow < span)) {
+        size_t count = prefetchWindows_.size();
+        prefetchCond_.wait(lock, [this, count]() { return !prefetchRunning_ || prefetchWindows_.size() != count; });
+        it = std::find_if(prefetchWindows_.begin(), prefetchWindows_.end(), holds);
+    }
+    if (it == prefetchWindows_.end()) {
+        return nullptr;
+    }
+    auto window = *it;
+    // The windows before the hit are behind the cursor now.
+    for (auto skipped = prefetchWindows_.begin(); skipped != it; ++skipped) {
+        RecycleWindowBlock((*skipped)->block);
+    }
+    prefetchWindows_.erase(prefetchWindows_.begin(), it + 1);
+    return window;
+}
+
+/**
+ * Lends the block of window to the cursor, a null window gives the base block back
+ */
+void DataShareResultSet::SetCurrentWindow(std::shared_ptr<PrefetchWindow> window)
+{
+    if (currentWindow_ != nullptr) {
+        RecycleWindowBlock(currentWindow_->block);
+    }
+    currentWindow_ = window;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    sharedBlock_ = window != nullptr ? window->block : baseBlock_;
+}
+
+void DataShareResultSet::SchedulePrefetch()
+{
+    if (!prefetchEnabled_ || prefetchRunning_ || prefetchNextRow_ < 0) {
+        return;
+    }
+    // Waiting for half of the ring to be free lets one fill cover several windows.
+    size_t batch = std::min<size_t>(std::max<uint32_t>(GetFillWindowsLimit(), 1), (prefetchOption_.depth + 1) / 2);
+    if (prefetchWindows_.size() + batch > prefetchOption_.depth) {
+        return;
+    }
+    prefetchRunning_ = true;
+    auto taskId = GetPrefetchExecutor()->Execute([this]() { RunPrefetch(); });
+    if (taskId == ExecutorPool::INVALID_TASK_ID) {
+        LOG_ERROR("schedule prefetch failed");
+        prefetchRunning_ = false;
+    }
+}
+
+/**
+ * Fills windows one after another until the prefetch depth is reached
+ */
+void DataShareResultSet::RunPrefetch()
+{
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    while (prefetchEnabled_ && prefetchNextRow_ >= 0 && prefetchWindows_.size() < prefetchOption_.depth) {
+        int startRow = prefetchWindows_.empty() ? prefetchNextRow_ : prefetchWindows_.back()->endRowPos + 1;
+        int rowCount = prefetchRowCount_;
+        if (startRow >= rowCount) {
+            break;
+        }
+        // The free windows of the ring are filled at once, a remote result set fills them in one transaction.
+        std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> blocks;
+        size_t limit = std::max<uint32_t>(GetFillWindowsLimit(), 1);
+        while (prefetchWindows_.size() + blocks.size() < prefetchOption_.depth && blocks.size() < limit) {
+            auto block = AcquireWindowBlock();
+            if (block == nullptr) {
+                break;
+            }
+            blocks.push_back(std::move(block));
+        }
+        if (blocks.empty()) {
+            break;
+        }
+        uint64_t generation = prefetchGeneration_;
+        lock.unlock();
+        std::vector<int> endRows;
+        bool result = FillWindows(startRow, rowCount - 1, blocks, endRows);
+        lock.lock();
+        if (generation != prefetchGeneration_ || !result) {
+            for (auto &block : blocks) {
+                RecycleWindowBlock(block);
+            }
+            if (generation != prefetchGeneration_) {
+                continue;
+            }
+            LOG_ERROR("prefetch fail s %{public}d, windows %{public}zu", startRow, blocks.size());
+            break;
+        }
+        for (size_t i = 0; i < blocks.size(); i++) {
+            if (i >= endRows.size()) {
+                RecycleWindowBlock(blocks[i]);
+                continue;
+            }
+            prefetchWindows_.push_back(std::make_shared<PrefetchWindow>(PrefetchWindow { blocks[i], startRow,
+                endRows[i] }));
+            startRow = endRows[i] + 1;
+        }
+        prefetchCond_.notify_all();
+    }
+    prefetchRunning_ = false;
+    prefetchCond_.notify_all();
+}
+
+int DataShareResultSet::EnableAdaptiveWindow(const AdaptiveWindowOption &option)
+{
+    if (option.minBlockSize == 0 || option.minBlockSize > option.maxBlockSize ||
+        option.maxBlockSize > MAX_SHARE_BLOCK_SIZE || option.minRows == 0 || option.minRows > option.maxRows) {
+        LOG_ERROR("adaptive window option invalid, block %{public}zu-%{public}zu, rows %{public}u-%{public}u",
+            option.minBlockSize, option.maxBlockSize, option.minRows, option.maxRows);
+        return E_ERROR;
+    }
+    auto block = GetBlock();
+    if (block == nullptr) {
+        LOG_ERROR("sharedBlock is null!");
+        return E_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    if (prefetchEnabled_) {
+        LOG_ERROR("adaptive window does not work with the prefetch!");
+        return E_ERROR;
+    }
+    adaptiveOption_ = option;
+    adaptiveStatistics_ = {};
+    adaptiveRows_ = option.minRows;
+    if (!adaptiveEnabled_) {
+        baseBlock_ = block;
+        adaptiveEnabled_ = true;
+    }
+    return E_OK;
+}
+
+DataShareResultSet::AdaptiveWindowStatistics DataShareResultSet::GetAdaptiveWindowStatistics()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    return adaptiveStatistics_;
+}
+
+bool DataShareResultSet::IsAdaptiveWindowEnabled()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    return adaptiveEnabled_;
+}
+
+void DataShareResultSet::StopAdaptiveWindow()
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    if (!adaptiveEnabled_) {
+        return;
+    }
+    adaptiveEnabled_ = false;
+    if (adaptiveBlock_ != nullptr) {
+        adaptiveBlock_ = nullptr;
+        std::unique_lock<std::shared_mutex> blockLock(mutex_);
+        sharedBlock_ = baseBlock_;
+        startRowPos_ = INITIAL_POS;
+        endRowPos_ = INITIAL_POS;
+    }
+    baseBlock_ = nullptr;
+}
+
+int DataShareResultSet::EnableStreaming(const StreamOption &option)
+{
+    streamOption_ = option;
+    streamRowCount_ = INITIAL_POS;
+    streaming_ = true;
+    return E_OK;
+}
+
+bool DataShareResultSet::GetStreamedRowCount(int &count)
+{
+    if (!streaming_ || streamRowCount_ < 0) {
+        return false;
+    }
+    count = streamRowCount_;
+    return true;
+}
+
+int DataShareResultSet::CapStreamedRowCount(int count)
+{
+    if (!streaming_ || streamOption_.rowBudget == 0) {
+        return count;
+    }
+    return static_cast<int>(std::min<int64_t>(count, streamOption_.rowBudget));
+}
+
+/**
+ * Gives the rows the cursor moves within, a streaming cursor runs until its budget or the end it found
+ */
+int DataShareResultSet::GetCursorRowLimit()
+{
+    if (!streaming_) {
+        int rowCount = 0;
+        GetRowCount(rowCount);
+        return rowCount;
+    }
+    if (streamRowCount_ >= 0) {
+        return streamRowCount_;
+    }
+    if (streamOption_.rowBudget > 0) {
+        return static_cast<int>(std::min<int64_t>(streamOption_.rowBudget, std::numeric_limits<int>::max()));
+    }
+    return std::numeric_limits<int>::max();
+}
+
+/**
+ * Moves the cursor window onto position, in a block sized for the rows the scroll pattern asks for
+ */
+bool DataShareResultSet::MoveToAdaptiveWindow(int position, int rowCount, int &startPos, int &endPos)
+{
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    // A move onto the row right after the window is a sequential scan, which gets twice the rows next time.
+    bool sequential = endRowPos_ >= 0 && position == endRowPos_ + 1;
+    adaptiveRows_ = sequential ? std::min(adaptiveRows_ * 2, adaptiveOption_.maxRows) : adaptiveOption_.minRows;
+    int64_t lastRow = static_cast<int64_t>(position) + adaptiveRows_ - 1;
+    int targetRow = static_cast<int>(std::min<int64_t>(rowCount - 1, lastRow));
+    size_t blockSize = GetAdaptiveBlockSize();
+    bool result = FillAdaptiveWindow(position, targetRow, blockSize, endPos);
+    if ((!result || endPos < position) && blockSize < adaptiveOption_.maxBlockSize) {
+        // The rows are wider than measured so far, the largest block holds at least the target row.
+        blockSize = adaptiveOption_.maxBlockSize;
+        result = FillAdaptiveWindow(position, targetRow, blockSize, endPos);
+    }
+    if (!result) {
+        return false;
+    }
+    if (endPos < position) {
+        // No row at position, a streaming cursor takes it as the end of the result set.
+        return streaming_;
+    }
+    startPos = position;
+    uint32_t rows = adaptiveBlock_->GetRowNum();
+    if (rows > 0) {
+        size_t rowBytes = adaptiveBlock_->GetUsedBytes() / rows;
+        size_t lastRowBytes = adaptiveStatistics_.rowBytes;
+        adaptiveStatistics_.rowBytes = lastRowBytes == 0 ? rowBytes : (lastRowBytes * 3 + rowBytes) / 4;
+    }
+    adaptiveStatistics_.refills++;
+    adaptiveStatistics_.rows += rows;
+    adaptiveStatistics_.blockSize = blockSize;
+    adaptiveStatistics_.peakBlockSize = std::max(adaptiveStatistics_.peakBlockSize, blockSize);
+    return true;
+}
+
+/**
+ * Fills the rows from position to targetRow into the adaptive block, replacing the block if its size differs
+ */
+bool DataShareResultSet::FillAdaptiveWindow(int position, int targetRow, size_t blockSize, int &endPos)
+{
+    auto block = adaptiveBlock_;
+    if (block == nullptr || block->Size() != blockSize) {
+        std::string name = "DataShare" + std::to_string(blockId_.fetch_add(1));
+        AppDataFwk::SharedBlock *newBlock = nullptr;
+        if (AppDataFwk::SharedBlock::Create(name, blockSize, newBlock) != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+            LOG_ERROR("create adaptive block failed, size %{public}zu", blockSize);
+            return false;
+        }
+        block = std::shared_ptr<AppDataFwk::SharedBlock>(newBlock);
+    }
+    adaptiveBlock_ = block;
+    endPos = INITIAL_POS;
+    if (!FillWindow(position, targetRow, block, endPos)) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> blockLock(mutex_);
+    sharedBlock_ = block;
+    return true;
+}
+
+/**
+ * Sizes the next window for adaptiveRows_ rows of the average width measured so far
+ */
+size_t DataShareResultSet::GetAdaptiveBlockSize()
+{
+    const size_t unit = 64 * 1024;
+    size_t rowBytes = adaptiveStatistics_.rowBytes;
+    // Rows of an unknown width start in the smallest block, which the measured width corrects from then on.
+    size_t blockSize = adaptiveOption_.minBlockSize;
+    if (rowBytes > adaptiveOption_.maxBlockSize / adaptiveRows_) {
+        blockSize = adaptiveOption_.maxBlockSize;
+    } else if (rowBytes > 0) {
+        // An eighth on top leaves room for rows a bit wider than the average.
+        blockSize = rowBytes * adaptiveRows_ + rowBytes * adaptiveRows_ / 8;
+        blockSize = (blockSize + unit - 1) / unit * unit;
+    }
+    return std::clamp(blockSize, adaptiveOption_.minBlockSize, adaptiveOption_.maxBlockSize);
+}
+
+std::shared_ptr<AppDataFwk::SharedBlock> DataShareResultSet::AcquireWindowBlock()
+{
+    if (!idleBlocks_.empty()) {
+        auto block = idleBlocks_.back();
+        idleBlocks_.pop_back();
+        return block;
+    }
+    if (baseBlock_ == nullptr) {
+        return nullptr;
+    }
+    std::string name = "DataShare" + std::to_string(blockId_.fetch_add(1));
+    AppDataFwk::SharedBlock *block = nullptr;
+    if (AppDataFwk::SharedBlock::Create(name, baseBlock_->Size(), block) != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+        LOG_ERROR("create window block failed");
+        return nullptr;
+    }
+    return std::shared_ptr<AppDataFwk::SharedBlock>(block);
+}
+
+void DataShareResultSet::RecycleWindowBlock(std::shared_ptr<AppDataFwk::SharedBlock> block)
+{
+    if (block != nullptr && idleBlocks_.size() < prefetchOption_.depth) {
+        idleBlocks_.push_back(std::move(block));
+    }
+}
+
 /**
  * Get current bridge
  */
@@ -133,8 +736,6 @@ int DataShareResultSet::GetDataType(int columnIndex, DataType &dataType)
         LOG_ERROR("sharedBlock is null!");
         return E_ERROR;
     }
-    int rowCount = 0;
-    GetRowCount(rowCount);
     AppDataFwk::SharedBlock::CellUnit *cellUnit =
         block->GetCellUnit(static_cast<uint32_t>(rowPos_) - startRowPos_, static_cast<uint32_t>(columnIndex));
     if (!cellUnit) {
@@ -151,8 +752,7 @@ int DataShareResultSet::GoToRow(int position)
         LOG_ERROR("sharedBlock is null!");
         return E_ERROR;
     }
-    int rowCnt = 0;
-    GetRowCount(rowCnt);
+    int rowCnt = GetCursorRowLimit();
     if (position >= rowCnt) {
         rowPos_ = rowCnt;
         LOG_ERROR("pos oor %{public}d, %{public}d", position, rowCnt);
@@ -168,10 +768,41 @@ int DataShareResultSet::GoToRow(int position)
     }
     bool result = true;
     if (position > endRowPos_ || position < startRowPos_) {
+        int startPos = position;
         int endPos = -1;
-        result = OnGo(position, rowCnt - 1, &endPos);
+        int targetRow = rowCnt - 1;
+        if (streaming_ && streamOption_.pageRows > 0) {
+            int64_t pageEnd = static_cast<int64_t>(position) + streamOption_.pageRows - 1;
+            targetRow = static_cast<int>(std::min<int64_t>(targetRow, pageEnd));
+        }
+        bool fillWindow = CanFillWindow();
+        if (!fillWindow) {
+            StopFillingWindows();
+        }
+        if (IsPrefetchEnabled()) {
+            result = MoveToWindow(position, rowCnt, startPos, endPos);
+        } else if (IsAdaptiveWindowEnabled()) {
+            result = MoveToAdaptiveWindow(position, rowCnt, startPos, endPos);
+        } else {
+            result = OnGo(position, targetRow, &endPos);
+        }
+        if (!result && fillWindow && !CanFillWindow()) {
+            // The provider rejected the window just handed over, the move is done on the base block instead.
+            StopFillingWindows();
+            startPos = position;
+            result = OnGo(position, targetRow, &endPos);
+        }
+        if (result && streaming_ && endPos < position) {
+            // A streaming cursor learns the end of the result set from a window filled without the row, a failed
+            // fill is an error. Only a window right after the last one tells the row count.
+            if (position == 0 || position == endRowPos_ + 1) {
+                streamRowCount_ = position;
+                rowCnt = position;
+            }
+            result = false;
+        }
         if (result) {
-            startRowPos_ = position;
+            startRowPos_ = startPos;
             endRowPos_ = endPos;
         }
     }
@@ -273,6 +904,138 @@ int DataShareResultSet::GetString(int columnIndex, std::string &value)
     }
 }
 
+/**
+ * Reads the type of the cell of the current row, and where its string or blob is in the block
+ */
+int DataShareResultSet::GetCellValue(int columnIndex, int &type, const void *&value, size_t &size)
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_, std::defer_lock);
+    if (!singleThreaded_.load()) {
+        lock.lock();
+    }
+    auto block = sharedBlock_.get();
+    if (block == nullptr) {
+        LOG_ERROR("sharedBlock is null!");
+        return E_ERROR;
+    }
+    AppDataFwk::SharedBlock::CellUnit *cellUnit =
+        block->GetCellUnit(static_cast<uint32_t>(rowPos_ - startRowPos_), static_cast<uint32_t>(columnIndex));
+    if (cellUnit == nullptr) {
+        return E_ERROR;
+    }
+    type = cellUnit->type;
+    if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_BLOB
+        || type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_STRING) {
+        value = block->GetCellUnitValueBlob(cellUnit, &size);
+        if (value == nullptr) {
+            LOG_ERROR("value of cell is null");
+            return E_ERROR;
+        }
+    }
+    return E_OK;
+}
+
+int DataShareResultSet::GetStringView(int columnIndex, std::string_view &value)
+{
+    value = std::string_view();
+    int type = AppDataFwk::SharedBlock::CELL_UNIT_TYPE_NULL;
+    const void *data = nullptr;
+    size_t sizeIncludingNull = 0;
+    int errorCode = GetCellValue(columnIndex, type, data, sizeIncludingNull);
+    if (errorCode != E_OK) {
+        return errorCode;
+    }
+    if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_STRING) {
+        value = std::string_view(static_cast<const char *>(data), sizeIncludingNull > 0 ? sizeIncludingNull - 1 : 0);
+        return E_OK;
+    }
+    if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_NULL) {
+        return E_OK;
+    }
+    // Numbers are not stored as text, GetString formats them.
+    return E_INVALID_OBJECT_TYPE;
+}
+
+int DataShareResultSet::GetBlobSpan(int columnIndex, const uint8_t *&value, size_t &size)
+{
+    value = nullptr;
+    size = 0;
+    int type = AppDataFwk::SharedBlock::CELL_UNIT_TYPE_NULL;
+    const void *data = nullptr;
+    size_t dataSize = 0;
+    int errorCode = GetCellValue(columnIndex, type, data, dataSize);
+    if (errorCode != E_OK) {
+        return errorCode;
+    }
+    if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_BLOB
+        || type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_STRING) {
+        value = static_cast<const uint8_t *>(data);
+        size = dataSize;
+        return E_OK;
+    }
+    if (type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_INTEGER
+        || type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_NULL
+        || type == AppDataFwk::SharedBlock::CELL_UNIT_TYPE_FLOAT) {
+        return E_OK;
+    }
+    LOG_ERROR("AppDataFwk::SharedBlock::nothing !");
+    return E_INVALID_OBJECT_TYPE;
+}
+
+int DataShareResultSet::GetRows(int startRow, int rowCount, std::vector<ColumnBuffer> &columns, int &fetchedRows)
+{
+    fetchedRows = 0;
+    if (startRow < 0 || rowCount < 0) {
+        LOG_ERROR("invalid rows s %{public}d, n %{public}d", startRow, rowCount);
+        return E_ERROR;
+    }
+    int columnCount = 0;
+    GetColumnCount(columnCount);
+    for (auto &column : columns) {
+        if (column.columnIndex < 0 || column.columnIndex >= columnCount || column.type == DataType::TYPE_NULL) {
+            LOG_ERROR("invalid column %{public}d, type %{public}d", column.columnIndex, static_cast<int>(column.type));
+            return E_INVALID_COLUMN_INDEX;
+        }
+        column.longs.clear();
+        column.doubles.clear();
+        column.offsets.assign(1, 0);
+        column.arena.clear();
+        column.nulls.clear();
+    }
+    int totalRows = GetCursorRowLimit();
+    int endRow = static_cast<int>(std::min<int64_t>(totalRows, static_cast<int64_t>(startRow) + rowCount));
+    int row = startRow;
+    while (row < endRow) {
+        if (GoToRow(row) != E_OK) {
+            // A streaming cursor finds the end of the result set on the way, the rows fetched are all there is.
+            int streamedRows = 0;
+            return GetStreamedRowCount(streamedRows) && row >= streamedRows ? E_OK : E_ERROR;
+        }
+        auto block = GetBlock();
+        if (block == nullptr || block->GetColumnNum() != static_cast<uint32_t>(columnCount)) {
+            LOG_ERROR("sharedBlock is null or its columns mismatch!");
+            return E_ERROR;
+        }
+        int windowEnd = std::min(endRowPos_ + 1, endRow);
+        for (; row < windowEnd; row++) {
+            // The cells of a row are contiguous, the row offset is resolved once for all columns.
+            AppDataFwk::SharedBlock::CellUnit *cells = block->GetCellUnit(static_cast<uint32_t>(row - startRowPos_), 0);
+            if (cells == nullptr) {
+                return E_ERROR;
+            }
+            for (auto &column : columns) {
+                int errorCode = AppendCell(*block, cells[column.columnIndex], column);
+                if (errorCode != E_OK) {
+                    return errorCode;
+                }
+            }
+            fetchedRows++;
+        }
+        rowPos_ = row - 1;
+    }
+    return E_OK;
+}
+
 int DataShareResultSet::GetInt(int columnIndex, int &value)
 {
     auto block = GetBlock();
@@ -394,6 +1157,8 @@ int DataShareResultSet::Close()
 {
     DISTRIBUTED_DATA_HITRACE(std::string(__FUNCTION__));
     DataShareAbsResultSet::Close();
+    StopPrefetch();
+    StopAdaptiveWindow();
     ClosedBlockAndBridge();
     return E_OK;
 }
@@ -428,10 +1193,46 @@ bool DataShareResultSet::HasBlock()
  */
 void DataShareResultSet::ClosedBlockAndBridge()
 {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    sharedBlock_ = nullptr;
-    bridge_ = nullptr;
-    blockWriter_ = nullptr;
+    std::shared_ptr<AppDataFwk::SharedBlock> block;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        block = std::move(sharedBlock_);
+        bridge_ = nullptr;
+        blockWriter_ = nullptr;
+        if (!blockPooled_) {
+            return;
+        }
+        blockPooled_ = false;
+    }
+    SharedBlockPool::GetInstance().Recycle(std::move(block), blockSize_, blockOwner_);
+}
+
+/**
+ * Hands the block to the process of owner. While the block is still empty, it is swapped for an idle block that
+ * process already maps, so no other process ever maps a block of the owner.
+ */
+std::shared_ptr<AppDataFwk::SharedBlock> DataShareResultSet::AdoptBlockOwner(uint64_t owner)
+{
+    std::shared_ptr<AppDataFwk::SharedBlock> unshared;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (!blockPooled_ || blockOwner_ != SharedBlockPool::NO_OWNER || sharedBlock_ == nullptr) {
+            return sharedBlock_;
+        }
+        blockOwner_ = owner;
+        if (sharedBlock_->GetRowNum() != 0) {
+            return sharedBlock_;
+        }
+        auto block = SharedBlockPool::GetInstance().TakeIdle(blockSize_, owner);
+        if (block == nullptr) {
+            return sharedBlock_;
+        }
+        unshared = std::move(sharedBlock_);
+        sharedBlock_ = block;
+        blockWriter_ = std::make_shared<DataShareBlockWriterImpl>(block);
+    }
+    SharedBlockPool::GetInstance().Recycle(std::move(unshared), blockSize_, SharedBlockPool::NO_OWNER);
+    return GetBlock();
 }
 
 void DataShareResultSet::Finalize()
@@ -457,11 +1258,16 @@ int DataShareResultSet::CheckState(int columnIndex)
 
 bool DataShareResultSet::Marshalling(MessageParcel &parcel)
 {
-    auto block = GetBlock();
+    auto block =
+        AdoptBlockOwner(SharedBlockPool::GetOwner(IPCSkeleton::GetCallingPid(), IPCSkeleton::GetCallingTokenID()));
     if (block == nullptr) {
         LOG_ERROR("sharedBlock is null.");
         return false;
     }
+    // Readers of the block map it read-only, the bridge keeps filling it through the mapping of the block.
+    if (block->Seal() != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+        LOG_WARN("seal sharedBlock failed.");
+    }
     return block->WriteMessageParcel(parcel);
 }
 
@@ -17,6 +17,110 @@
 
 namespace OHOS {
 namespace DataShare {
+PublishedDataArena::PublishedDataArena(sptr<Ashmem> ashmem) : ashmem_(std::move(ashmem))
+{
+}
+
+PublishedDataArena::~PublishedDataArena()
+{
+    if (ashmem_ != nullptr) {
+        ashmem_->UnmapAshmem();
+        ashmem_->CloseAshmem();
+    }
+}
+
+std::shared_ptr<PublishedDataArena> PublishedDataArena::Pack(const std::vector<PublishedDataItem> &datas,
+    std::vector<Slice> &slices)
+{
+    std::vector<BlobSpan> spans;
+    spans.reserve(datas.size());
+    uint64_t total = 0;
+    for (const auto &item : datas) {
+        BlobSpan span = item.GetBlobSpan();
+        total += span.size;
+        spans.push_back(span);
+    }
+    if (total == 0 || total > static_cast<uint64_t>(INT32_MAX)) {
+        return nullptr;
+    }
+    sptr<Ashmem> mem = Ashmem::CreateAshmem("PublishedDataArena", static_cast<int32_t>(total));
+    if (mem == nullptr) {
+        return nullptr;
+    }
+    auto arena = std::make_shared<PublishedDataArena>(mem);
+    if (!mem->MapReadAndWriteAshmem()) {
+        return nullptr;
+    }
+    std::vector<Slice> result;
+    result.reserve(spans.size());
+    uint32_t offset = 0;
+    for (const auto &span : spans) {
+        Slice slice = { offset, static_cast<uint32_t>(span.size) };
+        if (span.size != 0 && !mem->WriteToAshmem(span.data, static_cast<int32_t>(span.size), offset)) {
+            return nullptr;
+        }
+        offset += slice.size;
+        result.push_back(slice);
+    }
+    slices = std::move(result);
+    return arena;
+}
+
+sptr<Ashmem> PublishedDataArena::GetAshmem() const
+{
+    return ashmem_;
+}
+
+const uint8_t *PublishedDataArena::Read(const Slice &slice) const
+{
+    if (ashmem_ == nullptr || slice.size == 0) {
+        return nullptr;
+    }
+    uint64_t end = static_cast<uint64_t>(slice.offset) + slice.size;
+    if (end > static_cast<uint64_t>(ashmem_->GetAshmemSize())) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint8_t *>(
+        ashmem_->ReadFromAshmem(static_cast<int32_t>(slice.size), static_cast<int32_t>(slice.offset)));
+}
+
+bool PublishedDataChangeNode::PackBlobs()
+{
+    std::shared_ptr<PublishedDataArena> shared = nullptr;
+    bool packed = true;
+    for (const auto &item : datas_) {
+        if (!item.IsAshmem()) {
+            continue;
+        }
+        const AshmemNode &node = std::get<AshmemNode>(item.value_);
+        if (node.arena == nullptr || (shared != nullptr && shared != node.arena)) {
+            packed = false;
+            break;
+        }
+        shared = node.arena;
+    }
+    if (packed) {
+        return shared != nullptr;
+    }
+    std::vector<PublishedDataArena::Slice> slices;
+    auto arena = PublishedDataArena::Pack(datas_, slices);
+    if (arena == nullptr) {
+        return false;
+    }
+    std::vector<PublishedDataItem> datas;
+    datas.reserve(datas_.size());
+    for (size_t i = 0; i < datas_.size(); i++) {
+        if (datas_[i].IsAshmem()) {
+            datas.emplace_back(datas_[i].key_, datas_[i].subscriberId_, arena, slices[i]);
+        } else {
+            datas.emplace_back(std::move(datas_[i]));
+        }
+    }
+    // the replaced items release their own shared memory
+    datas_ = std::move(datas);
+    return true;
+}
+
 PublishedDataItem::~PublishedDataItem()
 {
     Clear();
@@ -28,6 +132,14 @@ PublishedDataItem::PublishedDataItem(const std::string &key, int64_t subscriberI
     Set(value);
 }
 
+PublishedDataItem::PublishedDataItem(const std::string &key, int64_t subscriberId,
+    std::shared_ptr<PublishedDataArena> arena, PublishedDataArena::Slice slice)
+    : key_(key), subscriberId_(subscriberId)
+{
+    AshmemNode node = { nullptr, false, std::move(arena), slice };
+    value_ = std::move(node);
+}
+
 PublishedDataItem::PublishedDataItem(PublishedDataItem &&item)
 {
     key_ = std::move(item.key_);
@@ -72,6 +184,12 @@ bool PublishedDataItem::IsString() const
     return value_.index() == 1;
 }
 
+bool PublishedDataItem::IsArena() const
+{
+    const AshmemNode *node = std::get_if<AshmemNode>(&value_);
+    return node != nullptr && node->arena != nullptr;
+}
+
 void PublishedDataItem::Set(DataType &value)
 {
     Clear();
@@ -101,21 +219,47 @@ void PublishedDataItem::Set(DataType &value)
 PublishedDataItem::DataType PublishedDataItem::GetData() const
 {
     if (IsAshmem()) {
-        const AshmemNode &node = std::get<AshmemNode>(value_);
-        if (node.ashmem != nullptr) {
-            node.ashmem->MapReadOnlyAshmem();
-            uint8_t *data = (uint8_t *)node.ashmem->ReadFromAshmem(node.ashmem->GetAshmemSize(), 0);
-            if (data == nullptr) {
-                return std::vector<uint8_t>();
-            }
-            return std::vector<uint8_t>(data, data + node.ashmem->GetAshmemSize());
+        BlobSpan span = GetBlobSpan();
+        if (span.data == nullptr) {
+            return std::vector<uint8_t>();
         }
-        return std::vector<uint8_t>();
+        return std::vector<uint8_t>(span.data, span.data + span.size);
     } else {
         return std::get<std::string>(value_);
     }
 }
 
+BlobSpan PublishedDataItem::GetBlobSpan() const
+{
+    const AshmemNode *node = std::get_if<AshmemNode>(&value_);
+    if (node == nullptr) {
+        return {};
+    }
+    if (node->arena != nullptr) {
+        const uint8_t *data = node->arena->Read(node->slice);
+        return data == nullptr ? BlobSpan() : BlobSpan { data, node->slice.size };
+    }
+    if (node->ashmem == nullptr) {
+        return {};
+    }
+    node->ashmem->MapReadOnlyAshmem();
+    int32_t size = node->ashmem->GetAshmemSize();
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(node->ashmem->ReadFromAshmem(size, 0));
+    if (data == nullptr || size <= 0) {
+        return {};
+    }
+    return { data, static_cast<size_t>(size) };
+}
+
+PublishedDataItem PublishedDataItem::Clone() const
+{
+    const AshmemNode *node = std::get_if<AshmemNode>(&value_);
+    if (node != nullptr && node->arena != nullptr) {
+        return PublishedDataItem(key_, subscriberId_, node->arena, node->slice);
+    }
+    return PublishedDataItem(key_, subscriberId_, GetData());
+}
+
 void PublishedDataItem::SetAshmem(sptr<Ashmem> ashmem, bool isManaged)
 {
     AshmemNode node = { ashmem, isManaged };
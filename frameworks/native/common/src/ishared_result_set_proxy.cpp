@@ -19,7 +19,9 @@
 
 #include "datashare_errno.h"
 #include "datashare_log.h"
+#include "ipc_types.h"
 #include "iremote_proxy.h"
+#include "shared_block.h"
 #include "string_ex.h"
 
 using namespace OHOS::DistributedShare::DataShare;
@@ -33,6 +35,12 @@ ISharedResultSetProxy::ISharedResultSetProxy(const sptr<OHOS::IRemoteObject> &im
 {
 }
 
+ISharedResultSetProxy::~ISharedResultSetProxy()
+{
+    // The prefetch fills windows through this proxy, it has to stop before the proxy is gone.
+    StopPrefetch();
+}
+
 std::shared_ptr<DataShareResultSet> ISharedResultSetProxy::CreateProxy(MessageParcel &parcel)
 {
     sptr<IRemoteObject> remoter = parcel.ReadRemoteObject();
@@ -83,8 +91,11 @@ int ISharedResultSetProxy::GetAllColumnNames(std::vector<std::string> &columnNam
 
 int ISharedResultSetProxy::GetRowCount(int &count)
 {
+    if (GetStreamedRowCount(count)) {
+        return E_OK;
+    }
     if (rowCount_ >= 0) {
-        count = rowCount_;
+        count = CapStreamedRowCount(rowCount_);
         return E_OK;
     }
     MessageParcel request;
@@ -109,6 +120,7 @@ int ISharedResultSetProxy::GetRowCount(int &count)
     count = reply.ReadInt32();
     LOG_DEBUG("count %{public}d", count);
     rowCount_ = count;
+    count = CapStreamedRowCount(count);
     return E_OK;
 }
 
@@ -140,6 +152,114 @@ bool ISharedResultSetProxy::OnGo(int oldRowIndex, int newRowIndex, int *cachedIn
     return true;
 }
 
+bool ISharedResultSetProxy::FillWindow(int startRowIndex, int targetRowIndex,
+    std::shared_ptr<AppDataFwk::SharedBlock> block, int &endRowIndex)
+{
+    if (block == nullptr) {
+        LOG_ERROR("block is null");
+        return false;
+    }
+    MessageParcel request;
+    std::u16string descriptor = ISharedResultSetProxy::GetDescriptor();
+    if (!request.WriteInterfaceToken(descriptor)) {
+        LOG_ERROR("WriteDescriptor is failed, WriteDescriptor = %{public}s", Str16ToStr8(descriptor).c_str());
+        return false;
+    }
+    request.WriteInt32(startRowIndex);
+    request.WriteInt32(targetRowIndex);
+    if (!block->WriteMessageParcel(request)) {
+        LOG_ERROR("Write window block failed");
+        return false;
+    }
+    MessageParcel reply;
+    if (!SendFillRequest(static_cast<uint32_t>(ISharedResultInterfaceCode::FUNC_FILL_WINDOW), request, reply)) {
+        return false;
+    }
+    endRowIndex = reply.ReadInt32();
+    return endRowIndex >= 0;
+}
+
+/**
+ * Sends all blocks to the provider in one transaction, the provider fills them one after another
+ */
+bool ISharedResultSetProxy::FillWindows(int startRowIndex, int targetRowIndex,
+    const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &blocks, std::vector<int> &endRowIndexes)
+{
+    endRowIndexes.clear();
+    if (blocks.empty() || blocks.size() > MAX_FILL_WINDOWS) {
+        LOG_ERROR("window count %{public}zu invalid", blocks.size());
+        return false;
+    }
+    MessageParcel request;
+    std::u16string descriptor = ISharedResultSetProxy::GetDescriptor();
+    if (!request.WriteInterfaceToken(descriptor)) {
+        LOG_ERROR("WriteDescriptor is failed, WriteDescriptor = %{public}s", Str16ToStr8(descriptor).c_str());
+        return false;
+    }
+    request.WriteInt32(startRowIndex);
+    request.WriteInt32(targetRowIndex);
+    request.WriteUint32(static_cast<uint32_t>(blocks.size()));
+    for (auto &block : blocks) {
+        if (block == nullptr || !block->WriteMessageParcel(request)) {
+            LOG_ERROR("Write window block failed");
+            return false;
+        }
+    }
+    MessageParcel reply;
+    if (!SendFillRequest(static_cast<uint32_t>(ISharedResultInterfaceCode::FUNC_FILL_WINDOWS), request, reply)) {
+        return false;
+    }
+    uint32_t count = reply.ReadUint32();
+    if (count > blocks.size()) {
+        LOG_ERROR("Reply window count %{public}u over %{public}zu", count, blocks.size());
+        return false;
+    }
+    int startRow = startRowIndex;
+    for (uint32_t i = 0; i < count; i++) {
+        int endRow = reply.ReadInt32();
+        if (endRow < startRow) {
+            LOG_ERROR("Reply window %{public}u ends at %{public}d before %{public}d", i, endRow, startRow);
+            break;
+        }
+        endRowIndexes.push_back(endRow);
+        startRow = endRow + 1;
+    }
+    return !endRowIndexes.empty();
+}
+
+uint32_t ISharedResultSetProxy::GetFillWindowsLimit()
+{
+    return MAX_FILL_WINDOWS;
+}
+
+bool ISharedResultSetProxy::CanFillWindow()
+{
+    return !fillRejected_;
+}
+
+/**
+ * Sends a fill request, a provider not knowing the code is not asked to fill windows again and the cursor uses OnGo.
+ * Any other error only fails this request.
+ */
+bool ISharedResultSetProxy::SendFillRequest(uint32_t code, MessageParcel &request, MessageParcel &reply)
+{
+    if (fillRejected_) {
+        return false;
+    }
+    MessageOption msgOption;
+    int errCode = Remote()->SendRequest(code, request, reply, msgOption);
+    if (errCode == IPC_STUB_UNKNOW_TRANS_ERR) {
+        LOG_ERROR("IPC Error %{public}x, code %{public}u falls back to OnGo", errCode, code);
+        fillRejected_ = true;
+        return false;
+    }
+    if (errCode != 0) {
+        LOG_ERROR("IPC Error %{public}x, code %{public}u", errCode, code);
+        return false;
+    }
+    return true;
+}
+
 int ISharedResultSetProxy::Close()
 {
     DataShareResultSet::Close();
@@ -20,12 +20,27 @@
 #include "datashare_log.h"
 #include "datashare_errno.h"
 #include "ipc_skeleton.h"
+#include "shared_block.h"
+#include "shared_block_pool.h"
 #include "string_ex.h"
 
 namespace OHOS::DataShare {
 std::function<sptr<ISharedResultSet>(std::shared_ptr<DataShareResultSet>,
     MessageParcel &)> ISharedResultSet::providerCreator_ = ISharedResultSetStub::CreateStub;
-constexpr ISharedResultSetStub::Handler ISharedResultSetStub::handlers[static_cast<uint32_t>(ResultCode::FUNC_BUTT)];
+constexpr ISharedResultSetStub::Handlers ISharedResultSetStub::GetHandlers()
+{
+    // The codes the stub does not serve stay null.
+    Handlers handlers {};
+    auto set = [&handlers](ResultCode code, Handler handler) { handlers[static_cast<uint32_t>(code)] = handler; };
+    set(ResultCode::FUNC_GET_ROW_COUNT, &ISharedResultSetStub::HandleGetRowCountRequest);
+    set(ResultCode::FUNC_GET_ALL_COLUMN_NAMES, &ISharedResultSetStub::HandleGetAllColumnNamesRequest);
+    set(ResultCode::FUNC_ON_GO, &ISharedResultSetStub::HandleOnGoRequest);
+    set(ResultCode::FUNC_CLOSE, &ISharedResultSetStub::HandleCloseRequest);
+    set(ResultCode::FUNC_FILL_WINDOW, &ISharedResultSetStub::HandleFillWindowRequest);
+    set(ResultCode::FUNC_FILL_WINDOWS, &ISharedResultSetStub::HandleFillWindowsRequest);
+    return handlers;
+}
+const ISharedResultSetStub::Handlers ISharedResultSetStub::handlers = ISharedResultSetStub::GetHandlers();
 const std::chrono::milliseconds TIME_THRESHOLD = std::chrono::milliseconds(500);
 
 sptr<ISharedResultSet> ISharedResultSetStub::CreateStub(std::shared_ptr<DataShareResultSet> result,
@@ -133,4 +148,96 @@ int ISharedResultSetStub::HandleCloseRequest(MessageParcel &data, MessageParcel
     LOG_DEBUG("errCode %{public}d", errCode);
     return NO_ERROR;
 }
+
+/**
+ * Maps a window of the consumer, which the consumer can still write while the provider fills it
+ */
+std::shared_ptr<AppDataFwk::SharedBlock> ISharedResultSetStub::ReadWindow(MessageParcel &data)
+{
+    AppDataFwk::SharedBlock *block = nullptr;
+    int ret = AppDataFwk::SharedBlock::ReadMessageParcel(data, block, false);
+    std::shared_ptr<AppDataFwk::SharedBlock> window(block);
+    if (ret != AppDataFwk::SharedBlock::SHARED_BLOCK_OK || window == nullptr ||
+        window->Size() > DataShareResultSet::MAX_SHARE_BLOCK_SIZE) {
+        LOG_ERROR("read window failed, ret %{public}d", ret);
+        return nullptr;
+    }
+    return window;
+}
+
+/**
+ * Copies the first count blocks filled by the provider into the windows of the consumer. The rows are only written
+ * through the headers of the blocks of the provider, never through a header the consumer can still change.
+ */
+bool ISharedResultSetStub::CopyWindows(const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &blocks,
+    const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &windows, size_t count)
+{
+    for (size_t i = 0; i < count && i < blocks.size() && i < windows.size(); i++) {
+        if (blocks[i]->CopyTo(*windows[i]) != AppDataFwk::SharedBlock::SHARED_BLOCK_OK) {
+            LOG_ERROR("copy window %{public}zu failed", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+int ISharedResultSetStub::HandleFillWindowRequest(MessageParcel &data, MessageParcel &reply)
+{
+    int startRow = data.ReadInt32();
+    int targetRow = data.ReadInt32();
+    auto window = ReadWindow(data);
+    auto block = window == nullptr ? nullptr : SharedBlockPool::GetInstance().Acquire(window->Size());
+    if (block == nullptr) {
+        reply.WriteInt32(-1);
+        return NO_ERROR;
+    }
+    int endRow = -1;
+    if (!resultSet_->FillWindow(startRow, targetRow, block, endRow) || !CopyWindows({ block }, { window }, 1)) {
+        endRow = -1;
+    }
+    SharedBlockPool::GetInstance().Recycle(std::move(block), window->Size(), SharedBlockPool::NO_OWNER);
+    reply.WriteInt32(endRow);
+    LOG_DEBUG("HandleFillWindowRequest call %{public}d", endRow);
+    return NO_ERROR;
+}
+
+int ISharedResultSetStub::HandleFillWindowsRequest(MessageParcel &data, MessageParcel &reply)
+{
+    int startRow = data.ReadInt32();
+    int targetRow = data.ReadInt32();
+    uint32_t count = data.ReadUint32();
+    if (count == 0 || count > DataShareResultSet::MAX_FILL_WINDOWS) {
+        LOG_ERROR("window count %{public}u invalid", count);
+        reply.WriteUint32(0);
+        return NO_ERROR;
+    }
+    std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> windows;
+    std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> blocks;
+    auto &pool = SharedBlockPool::GetInstance();
+    for (uint32_t i = 0; i < count; i++) {
+        auto window = ReadWindow(data);
+        auto block = window == nullptr ? nullptr : pool.Acquire(window->Size());
+        if (block == nullptr) {
+            LOG_ERROR("read window %{public}u failed", i);
+            reply.WriteUint32(0);
+            return NO_ERROR;
+        }
+        windows.push_back(std::move(window));
+        blocks.push_back(std::move(block));
+    }
+    std::vector<int> endRows;
+    resultSet_->FillWindows(startRow, targetRow, blocks, endRows);
+    if (!CopyWindows(blocks, windows, endRows.size())) {
+        endRows.clear();
+    }
+    for (size_t i = 0; i < blocks.size(); i++) {
+        pool.Recycle(std::move(blocks[i]), windows[i]->Size(), SharedBlockPool::NO_OWNER);
+    }
+    reply.WriteUint32(static_cast<uint32_t>(endRows.size()));
+    for (int endRow : endRows) {
+        reply.WriteInt32(endRow);
+    }
+    LOG_DEBUG("HandleFillWindowsRequest call %{public}zu", endRows.size());
+    return NO_ERROR;
+}
 } // namespace OHOS::DataShare
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <codecvt>
 #include <iostream>
 
@@ -117,6 +118,11 @@ int SharedBlock::WriteMessageParcel(MessageParcel &parcel)
 }
 
 int SharedBlock::ReadMessageParcel(MessageParcel &parcel, SharedBlock *&block)
+{
+    return ReadMessageParcel(parcel, block, true);
+}
+
+int SharedBlock::ReadMessageParcel(MessageParcel &parcel, SharedBlock *&block, bool readOnly)
 {
     std::string name = ToUtf8(parcel.ReadString16());
     sptr<Ashmem> ashmem = parcel.ReadAshmem();
@@ -124,13 +130,13 @@ int SharedBlock::ReadMessageParcel(MessageParcel &parcel, SharedBlock *&block)
         LOG_ERROR("ReadMessageParcel: No ashmem in the parcel.");
         return SHARED_BLOCK_BAD_VALUE;
     }
-    bool ret = ashmem->MapReadAndWriteAshmem();
+    bool ret = readOnly ? ashmem->MapReadOnlyAshmem() : ashmem->MapReadAndWriteAshmem();
     if (!ret) {
-        LOG_ERROR("ReadMessageParcel: MapReadAndWriteAshmem function error.");
+        LOG_ERROR("ReadMessageParcel: map ashmem error, readOnly %{public}d.", readOnly);
         ashmem->CloseAshmem();
         return SHARED_BLOCK_SET_PORT_ERROR;
     }
-    block = new (std::nothrow) SharedBlock(name, ashmem, ashmem->GetAshmemSize(), true);
+    block = new (std::nothrow) SharedBlock(name, ashmem, ashmem->GetAshmemSize(), readOnly);
     if (block == nullptr) {
         LOG_ERROR("ReadMessageParcel new SharedBlock error.");
         return SHARED_BLOCK_BAD_VALUE;
@@ -150,27 +156,78 @@ int SharedBlock::ReadMessageParcel(MessageParcel &parcel, SharedBlock *&block)
     return SHARED_BLOCK_OK;
 }
 
+int SharedBlock::Seal()
+{
+    if (ashmem_ == nullptr) {
+        return SHARED_BLOCK_BAD_VALUE;
+    }
+    /* Only limits the mappings made from now on, the mapping of the writer stays writable. */
+    if (!ashmem_->SetProtection(PROT_READ)) {
+        LOG_ERROR("Seal: SetProtection function error.");
+        return SHARED_BLOCK_SET_PORT_ERROR;
+    }
+    return SHARED_BLOCK_OK;
+}
+
 int SharedBlock::Clear()
 {
     if (mReadOnly) {
         return SHARED_BLOCK_INVALID_OPERATION;
     }
 
-    mHeader->unusedOffset = sizeof(SharedBlockHeader) + sizeof(RowGroupHeader);
-    mHeader->firstRowGroupOffset = sizeof(SharedBlockHeader);
+    /* Every row takes at least its row offset, which bounds the pages the row directory needs. */
+    size_t maxRows = mSize > sizeof(SharedBlockHeader) ? (mSize - sizeof(SharedBlockHeader)) / sizeof(uint32_t) : 0;
+    uint32_t dirCapacity = static_cast<uint32_t>((maxRows + ROW_PAGE_MASK) >> ROW_PAGE_SHIFT);
+    uint32_t dirSize = dirCapacity * sizeof(uint32_t);
+    if (dirCapacity == 0 || OffsetToPtr(sizeof(SharedBlockHeader), dirSize) == nullptr) {
+        LOG_ERROR("Failed to get row directory in clear().");
+        return SHARED_BLOCK_BAD_VALUE;
+    }
+
+    mHeader->unusedOffset = sizeof(SharedBlockHeader) + dirSize;
+    /* Readers of the legacy layout fail to find the first row group instead of misreading the block. */
+    mHeader->firstRowGroupOffset = INVALID_ROW_RECORD;
     mHeader->rowNums = 0;
     mHeader->columnNums = 0;
     mHeader->startPos_ = 0;
     mHeader->lastPos_ = 0;
     mHeader->blockPos_ = 0;
+    mHeader->layoutVersion = LAYOUT_ROW_DIRECTORY;
+    mHeader->rowDirOffset = sizeof(SharedBlockHeader);
+    mHeader->rowDirCapacity = dirCapacity;
+    mHeader->rowPageNums = 0;
+    return SHARED_BLOCK_OK;
+}
 
-    RowGroupHeader *firstGroup =
-        static_cast<RowGroupHeader *>(OffsetToPtr(mHeader->firstRowGroupOffset, sizeof(RowGroupHeader)));
-    if (!firstGroup) {
-        LOG_ERROR("Failed to get group in clear().");
+int SharedBlock::Wipe()
+{
+    if (mReadOnly) {
+        return SHARED_BLOCK_INVALID_OPERATION;
+    }
+
+    size_t usedBytes = std::min(static_cast<size_t>(mHeader->unusedOffset), mSize);
+    if (usedBytes > sizeof(SharedBlockHeader)) {
+        size_t dataSize = mSize - sizeof(SharedBlockHeader);
+        if (memset_s(static_cast<uint8_t *>(mData) + sizeof(SharedBlockHeader), dataSize, 0,
+            usedBytes - sizeof(SharedBlockHeader)) != EOK) {
+            LOG_ERROR("Failed to zero the used bytes in wipe().");
+            return SHARED_BLOCK_BAD_VALUE;
+        }
+    }
+    return Clear();
+}
+
+int SharedBlock::CopyTo(SharedBlock &block)
+{
+    if (block.mReadOnly || block.mSize != mSize || block.mData == nullptr) {
+        return SHARED_BLOCK_INVALID_OPERATION;
+    }
+
+    size_t usedBytes = std::min(static_cast<size_t>(mHeader->unusedOffset), mSize);
+    if (memcpy_s(block.mData, block.mSize, mData, usedBytes) != EOK) {
+        LOG_ERROR("Failed to copy the used bytes in copyTo().");
         return SHARED_BLOCK_BAD_VALUE;
     }
-    firstGroup->nextGroupOffset = 0;
     return SHARED_BLOCK_OK;
 }
 
@@ -264,6 +321,30 @@ uint32_t SharedBlock::Alloc(size_t size, bool aligned)
 }
 
 inline uint32_t *SharedBlock::GetRowOffset(uint32_t row)
+{
+    if (!IsRowDirectoryLayout()) {
+        return GetLegacyRowOffset(row);
+    }
+
+    uint32_t page = row >> ROW_PAGE_SHIFT;
+    if (page >= mHeader->rowPageNums || mHeader->rowPageNums > mHeader->rowDirCapacity) {
+        LOG_ERROR("Row %{public}" PRIu32 " is out of %{public}" PRIu32 " row pages.", row, mHeader->rowPageNums);
+        return nullptr;
+    }
+    uint32_t *rowDir = static_cast<uint32_t *>(OffsetToPtr(mHeader->rowDirOffset, (page + 1) * sizeof(uint32_t)));
+    if (rowDir == nullptr) {
+        LOG_ERROR("Failed to get row directory in getRowOffset().");
+        return nullptr;
+    }
+    uint32_t *rowPage = static_cast<uint32_t *>(OffsetToPtr(rowDir[page], ROW_PAGE_SIZE * sizeof(uint32_t)));
+    if (rowPage == nullptr) {
+        LOG_ERROR("Failed to get row page %{public}" PRIu32 " in getRowOffset().", page);
+        return nullptr;
+    }
+    return &rowPage[row & ROW_PAGE_MASK];
+}
+
+uint32_t *SharedBlock::GetLegacyRowOffset(uint32_t row)
 {
     uint32_t rowPos = row;
 
@@ -288,42 +369,40 @@ inline uint32_t *SharedBlock::GetRowOffset(uint32_t row)
 
 uint32_t *SharedBlock::AllocRowOffset()
 {
-    uint32_t rowPos = mHeader->rowNums;
-
-    RowGroupHeader *group =
-        static_cast<RowGroupHeader *>(OffsetToPtr(mHeader->firstRowGroupOffset, sizeof(RowGroupHeader)));
-    if (group == nullptr) {
-        LOG_ERROR("Failed to get group in allocRowOffset().");
+    if (!IsRowDirectoryLayout()) {
+        LOG_ERROR("Rows can only be allocated after clear(), layout %{public}" PRIx32 ".", mHeader->layoutVersion);
         return nullptr;
     }
 
-    while (rowPos > ROW_OFFSETS_NUM) {
-        group = static_cast<RowGroupHeader *>(OffsetToPtr(group->nextGroupOffset, sizeof(RowGroupHeader)));
-        if (group == nullptr) {
-            LOG_ERROR("Failed to get group in OffsetToPtr(group->nextGroupOffset) when while loop.");
-            return nullptr;
-        }
-        rowPos -= ROW_OFFSETS_NUM;
+    uint32_t row = mHeader->rowNums;
+    uint32_t page = row >> ROW_PAGE_SHIFT;
+    if (page >= mHeader->rowDirCapacity) {
+        LOG_ERROR("Row directory is full: %{public}" PRIu32 " pages.", mHeader->rowDirCapacity);
+        return nullptr;
     }
-    if (rowPos == ROW_OFFSETS_NUM) {
-        if (!group->nextGroupOffset) {
-            /* Aligned */
-            group->nextGroupOffset = Alloc(sizeof(RowGroupHeader), true);
-            if (!group->nextGroupOffset) {
-                return nullptr;
-            }
-        }
-        group = static_cast<RowGroupHeader *>(OffsetToPtr(group->nextGroupOffset, sizeof(RowGroupHeader)));
-        if (group == nullptr) {
-            LOG_ERROR("Failed to get group in OffsetToPtr(group->nextGroupOffset).");
+    uint32_t *rowDir = static_cast<uint32_t *>(OffsetToPtr(mHeader->rowDirOffset, (page + 1) * sizeof(uint32_t)));
+    if (rowDir == nullptr) {
+        LOG_ERROR("Failed to get row directory in allocRowOffset().");
+        return nullptr;
+    }
+    /* Pages freed by FreeLastRow are kept in the directory and reused. */
+    if (page >= mHeader->rowPageNums) {
+        /* Aligned */
+        uint32_t pageOffset = Alloc(ROW_PAGE_SIZE * sizeof(uint32_t), true);
+        if (!pageOffset) {
             return nullptr;
         }
-        group->nextGroupOffset = 0;
-        rowPos = 0;
+        rowDir[page] = pageOffset;
+        mHeader->rowPageNums = page + 1;
+    }
+    uint32_t *rowPage = static_cast<uint32_t *>(OffsetToPtr(rowDir[page], ROW_PAGE_SIZE * sizeof(uint32_t)));
+    if (rowPage == nullptr) {
+        LOG_ERROR("Failed to get row page %{public}" PRIu32 " in allocRowOffset().", page);
+        return nullptr;
     }
 
     mHeader->rowNums += 1;
-    return &group->rowOffsets[rowPos];
+    return &rowPage[row & ROW_PAGE_MASK];
 }
 
 SharedBlock::CellUnit *SharedBlock::GetCellUnit(uint32_t row, uint32_t column)
@@ -360,13 +439,42 @@ int SharedBlock::PutString(uint32_t row, uint32_t column, const char *value, siz
     return PutBlobOrString(row, column, value, sizeIncludingNull, CELL_UNIT_TYPE_STRING);
 }
 
+int SharedBlock::PutLong(uint32_t row, uint32_t column, int64_t value)
+{
+    return PutLong(GetCellUnit(row, column), value);
+}
+
+int SharedBlock::PutDouble(uint32_t row, uint32_t column, double value)
+{
+    return PutDouble(GetCellUnit(row, column), value);
+}
+
+int SharedBlock::PutNull(uint32_t row, uint32_t column)
+{
+    return PutNull(GetCellUnit(row, column));
+}
+
+int SharedBlock::PutBlob(CellUnit *cellUnit, const void *value, size_t size)
+{
+    return PutBlobOrString(cellUnit, value, size, CELL_UNIT_TYPE_BLOB);
+}
+
+int SharedBlock::PutString(CellUnit *cellUnit, const char *value, size_t sizeIncludingNull)
+{
+    return PutBlobOrString(cellUnit, value, sizeIncludingNull, CELL_UNIT_TYPE_STRING);
+}
+
 int SharedBlock::PutBlobOrString(uint32_t row, uint32_t column, const void *value, size_t size, int32_t type)
+{
+    return PutBlobOrString(GetCellUnit(row, column), value, size, type);
+}
+
+int SharedBlock::PutBlobOrString(CellUnit *cellUnit, const void *value, size_t size, int32_t type)
 {
     if (mReadOnly) {
         return SHARED_BLOCK_INVALID_OPERATION;
     }
 
-    CellUnit *cellUnit = GetCellUnit(row, column);
     if (!cellUnit) {
         return SHARED_BLOCK_BAD_VALUE;
     }
@@ -394,13 +502,12 @@ int SharedBlock::PutBlobOrString(uint32_t row, uint32_t column, const void *valu
     return SHARED_BLOCK_OK;
 }
 
-int SharedBlock::PutLong(uint32_t row, uint32_t column, int64_t value)
+int SharedBlock::PutLong(CellUnit *cellUnit, int64_t value)
 {
     if (mReadOnly) {
         return SHARED_BLOCK_INVALID_OPERATION;
     }
 
-    CellUnit *cellUnit = GetCellUnit(row, column);
     if (!cellUnit) {
         return SHARED_BLOCK_BAD_VALUE;
     }
@@ -410,13 +517,12 @@ int SharedBlock::PutLong(uint32_t row, uint32_t column, int64_t value)
     return SHARED_BLOCK_OK;
 }
 
-int SharedBlock::PutDouble(uint32_t row, uint32_t column, double value)
+int SharedBlock::PutDouble(CellUnit *cellUnit, double value)
 {
     if (mReadOnly) {
         return SHARED_BLOCK_INVALID_OPERATION;
     }
 
-    CellUnit *cellUnit = GetCellUnit(row, column);
     if (!cellUnit) {
         return SHARED_BLOCK_BAD_VALUE;
     }
@@ -426,13 +532,12 @@ int SharedBlock::PutDouble(uint32_t row, uint32_t column, double value)
     return SHARED_BLOCK_OK;
 }
 
-int SharedBlock::PutNull(uint32_t row, uint32_t column)
+int SharedBlock::PutNull(CellUnit *cellUnit)
 {
     if (mReadOnly) {
         return SHARED_BLOCK_INVALID_OPERATION;
     }
 
-    CellUnit *cellUnit = GetCellUnit(row, column);
     if (!cellUnit) {
         return SHARED_BLOCK_BAD_VALUE;
     }
@@ -445,6 +550,9 @@ int SharedBlock::PutNull(uint32_t row, uint32_t column)
 
 size_t SharedBlock::SetRawData(const void *rawData, size_t size)
 {
+    if (mReadOnly) {
+        return SHARED_BLOCK_INVALID_OPERATION;
+    }
     if (size <= 0) {
         LOG_ERROR("SharedBlock rawData is less than or equal to 0M");
         return SHARED_BLOCK_INVALID_OPERATION;
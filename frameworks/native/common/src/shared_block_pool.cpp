@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "shared_block_pool"
+
+#include "shared_block_pool.h"
+
+#include <atomic>
+#include <string>
+
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace AppDataFwk;
+namespace {
+constexpr uint32_t TOKEN_ID_SHIFT = 32;
+} // namespace
+
+SharedBlockPool &SharedBlockPool::GetInstance()
+{
+    static SharedBlockPool pool;
+    return pool;
+}
+
+uint64_t SharedBlockPool::GetOwner(int32_t pid, uint32_t tokenId)
+{
+    return (static_cast<uint64_t>(tokenId) << TOKEN_ID_SHIFT) | static_cast<uint32_t>(pid);
+}
+
+std::shared_ptr<SharedBlock> SharedBlockPool::Acquire(size_t size, uint64_t owner)
+{
+    auto block = TakeIdle(size, owner);
+    if (block != nullptr) {
+        return block;
+    }
+    static std::atomic<int32_t> blockId = 0;
+    std::string name = "DataSharePool" + std::to_string(blockId.fetch_add(1));
+    SharedBlock *newBlock = nullptr;
+    if (SharedBlock::Create(name, size, newBlock) != SharedBlock::SHARED_BLOCK_OK || newBlock == nullptr) {
+        LOG_ERROR("create block failed, size %{public}zu", size);
+        return nullptr;
+    }
+    return std::shared_ptr<SharedBlock>(newBlock);
+}
+
+std::shared_ptr<SharedBlock> SharedBlockPool::TakeIdle(size_t size, uint64_t owner)
+{
+    std::shared_ptr<SharedBlock> block;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = idleBlocks_.rbegin(); it != idleBlocks_.rend(); ++it) {
+            if (it->size == size && it->owner == owner) {
+                block = std::move(it->block);
+                idleBytes_ -= size;
+                idleBlocks_.erase(std::next(it).base());
+                break;
+            }
+        }
+    }
+    // The owner may map the block for another query, it must not read the rows of the last one.
+    if (block != nullptr && block->Wipe() != SharedBlock::SHARED_BLOCK_OK) {
+        LOG_WARN("wipe idle block failed, size %{public}zu", size);
+        return nullptr;
+    }
+    return block;
+}
+
+void SharedBlockPool::Recycle(std::shared_ptr<SharedBlock> block, size_t size, uint64_t owner)
+{
+    // Someone still reading the block would see the rows of the next query.
+    if (block == nullptr || block.use_count() != 1) {
+        return;
+    }
+    // The released blocks are unmapped after the lock is dropped.
+    std::list<IdleBlock> released;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size > maxIdleBytes_) {
+        return;
+    }
+    idleBlocks_.push_back(IdleBlock { size, owner, std::move(block) });
+    idleBytes_ += size;
+    TrimLocked(maxIdleBytes_, released);
+}
+
+void SharedBlockPool::Trim(size_t keepBytes)
+{
+    std::list<IdleBlock> released;
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked(keepBytes, released);
+}
+
+void SharedBlockPool::SetMaxIdleBytes(size_t maxIdleBytes)
+{
+    std::list<IdleBlock> released;
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxIdleBytes_ = maxIdleBytes;
+    TrimLocked(maxIdleBytes_, released);
+}
+
+size_t SharedBlockPool::GetIdleBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idleBytes_;
+}
+
+void SharedBlockPool::TrimLocked(size_t keepBytes, std::list<IdleBlock> &released)
+{
+    while (idleBytes_ > keepBytes && !idleBlocks_.empty()) {
+        idleBytes_ -= idleBlocks_.front().size;
+        released.splice(released.end(), idleBlocks_, idleBlocks_.begin());
+    }
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -22,6 +22,7 @@
 #include "data_ability_observer_interface.h"
 #include "datashare_business_error.h"
 #include "datashare_errno.h"
+#include "datashare_operation_statement.h"
 #include "datashare_predicates.h"
 #include "datashare_result_set.h"
 #include "datashare_values_bucket.h"
@@ -83,6 +84,25 @@ public:
 
     virtual std::pair<int32_t, int32_t> DeleteEx(const Uri &uri, const DataSharePredicates &predicates) = 0;
     virtual int32_t SetExtUri(const std::string &extUri) { return E_DATASHARE_TYPE; };
+
+    /**
+     * Inserts the rows in one transaction, results holds the result of each row. This function is supported only
+     * when using silent DataShareHelper, the non-silent one goes through ExtSpecialController.
+     */
+    virtual int32_t BatchInsert(const Uri &uri, const std::vector<DataShareValuesBucket> &values,
+        std::vector<int32_t> &results)
+    {
+        return E_DATASHARE_TYPE;
+    }
+
+    /**
+     * Executes the statements in one transaction. This function is supported only when using silent
+     * DataShareHelper, the non-silent one goes through ExtSpecialController.
+     */
+    virtual int32_t ExecuteBatch(const std::vector<OperationStatement> &statements, ExecResultSet &result)
+    {
+        return E_DATASHARE_TYPE;
+    }
 };
 } // namespace DataShare
 } // namespace OHOS
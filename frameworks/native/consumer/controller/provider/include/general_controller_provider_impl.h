@@ -16,6 +16,12 @@
 #ifndef GENERAL_CONTROLLER_PORVIDER_IMPL_H
 #define GENERAL_CONTROLLER_PORVIDER_IMPL_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "datashare_connection_base.h"
 #include "datashare_option.h"
 #include "general_controller.h"
@@ -32,7 +38,7 @@ public:
     GeneralControllerProviderImpl(std::shared_ptr<DataShareConnectionBase> connection,
         const Uri &uri, const sptr<IRemoteObject> &token);
 
-    virtual ~GeneralControllerProviderImpl() = default;
+    virtual ~GeneralControllerProviderImpl();
 
     int Insert(const Uri &uri, const DataShareValuesBucket &value) override;
 
@@ -64,9 +70,26 @@ public:
     int NotifyChangeExtProvider(const ChangeInfo &changeInfo) override;
 
 private:
+    struct ProxyCache {
+        std::shared_ptr<DataShareProxy> proxy;
+        uint64_t version = 0;
+    };
+
+    std::shared_ptr<DataShareProxy> GetDataShareProxy(const std::shared_ptr<DataShareConnectionBase> &connection);
+
     std::shared_ptr<DataShareConnectionBase> connection_ = nullptr;
     sptr<IRemoteObject> token_ = {};
     Uri uri_ = Uri("");
+    static constexpr size_t MAX_PROXY_CACHES = 8;
+    // the cache of the current proxy version, the replaced ones are kept in proxyCaches_ until the controller is
+    // destroyed because a call may still use them. Once MAX_PROXY_CACHES is reached, every call asks the connection.
+    std::atomic<const ProxyCache *> proxyCache_ = nullptr;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<const ProxyCache>> proxyCaches_;
+    // the observers registered through this controller, the pooled connection outlives it and must not re-register
+    // them once it is destroyed
+    std::mutex observerMutex_;
+    std::vector<std::pair<Uri, sptr<AAFwk::IDataAbilityObserver>>> observers_;
 };
 } // namespace DataShare
 } // namespace OHOS
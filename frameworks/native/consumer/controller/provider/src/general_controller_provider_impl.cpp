@@ -17,11 +17,60 @@
 
 #include "general_controller_provider_impl.h"
 
+#include <algorithm>
+
 #include "datashare_log.h"
 #include "datashare_string_utils.h"
 
 namespace OHOS {
 namespace DataShare {
+GeneralControllerProviderImpl::~GeneralControllerProviderImpl()
+{
+    auto connection = connection_;
+    if (connection == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(observerMutex_);
+    for (const auto &[uri, observer] : observers_) {
+        LOG_INFO("Drop observerExt provider not unregistered, uri: %{public}s",
+            DataShareStringUtils::Anonymous(uri.ToString()).c_str());
+        connection->DeleteObserverExtsProviderMap(uri, observer);
+    }
+    observers_.clear();
+}
+
+std::shared_ptr<DataShareProxy> GeneralControllerProviderImpl::GetDataShareProxy(
+    const std::shared_ptr<DataShareConnectionBase> &connection)
+{
+    const ProxyCache *cache = proxyCache_.load(std::memory_order_acquire);
+    if (cache != nullptr && cache->version == connection->GetProxyVersion()) {
+        // the cache lives as long as the controller, no need to share its ownership
+        return std::shared_ptr<DataShareProxy>(std::shared_ptr<DataShareProxy>(), cache->proxy.get());
+    }
+    // read the version first, a proxy replaced while connecting is cached with an older version and refreshed by
+    // the next call
+    uint64_t version = connection->GetProxyVersion();
+    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    if (proxy == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache = proxyCache_.load(std::memory_order_relaxed);
+    if ((cache != nullptr && cache->version == version) || proxyCaches_.size() >= MAX_PROXY_CACHES) {
+        return proxy;
+    }
+    auto newCache = std::make_unique<ProxyCache>();
+    newCache->proxy = proxy;
+    newCache->version = version;
+    proxyCache_.store(newCache.get(), std::memory_order_release);
+    proxyCaches_.push_back(std::move(newCache));
+    if (proxyCaches_.size() == MAX_PROXY_CACHES) {
+        LOG_WARN("proxy changed too often, stop caching it, uri:%{public}s",
+            DataShareStringUtils::Anonymous(uri_.ToString()).c_str());
+    }
+    return proxy;
+}
+
 int GeneralControllerProviderImpl::Insert(const Uri &uri, const DataShareValuesBucket &value)
 {
     auto connection = connection_;
@@ -29,7 +78,7 @@ int GeneralControllerProviderImpl::Insert(const Uri &uri, const DataShareValuesB
         LOG_ERROR("connection is nullptr");
         return DATA_SHARE_ERROR;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return DATA_SHARE_ERROR;
@@ -45,7 +94,7 @@ int GeneralControllerProviderImpl::Update(const Uri &uri, const DataSharePredica
         LOG_ERROR("connection is nullptr");
         return DATA_SHARE_ERROR;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return DATA_SHARE_ERROR;
@@ -60,7 +109,7 @@ int GeneralControllerProviderImpl::Delete(const Uri &uri, const DataSharePredica
         LOG_ERROR("connection is nullptr");
         return DATA_SHARE_ERROR;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return DATA_SHARE_ERROR;
@@ -76,7 +125,7 @@ std::pair<int32_t, int32_t> GeneralControllerProviderImpl::InsertEx(const Uri &u
         LOG_ERROR("connection is nullptr");
         return std::make_pair(DATA_SHARE_ERROR, 0);
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return std::make_pair(DATA_SHARE_ERROR, 0);
@@ -92,7 +141,7 @@ std::pair<int32_t, int32_t> GeneralControllerProviderImpl::UpdateEx(
         LOG_ERROR("connection is nullptr");
         return std::make_pair(DATA_SHARE_ERROR, 0);
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return std::make_pair(DATA_SHARE_ERROR, 0);
@@ -108,7 +157,7 @@ std::pair<int32_t, int32_t> GeneralControllerProviderImpl::DeleteEx(const Uri &u
         LOG_ERROR("connection is nullptr");
         return std::make_pair(DATA_SHARE_ERROR, 0);
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return std::make_pair(DATA_SHARE_ERROR, 0);
@@ -126,7 +175,7 @@ std::shared_ptr<DataShareResultSet> GeneralControllerProviderImpl::Query(const U
         LOG_ERROR("connection is nullptr");
         return nullptr;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return nullptr;
@@ -142,7 +191,7 @@ int GeneralControllerProviderImpl::RegisterObserver(const Uri &uri,
         LOG_ERROR("connection is nullptr");
         return E_PROVIDER_CONN_NULL;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return E_PROVIDER_NOT_CONNECTED;
@@ -162,7 +211,7 @@ int GeneralControllerProviderImpl::UnregisterObserver(const Uri &uri,
         LOG_ERROR("connection is nullptr");
         return E_PROVIDER_CONN_NULL;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return E_PROVIDER_NOT_CONNECTED;
@@ -181,7 +230,7 @@ void GeneralControllerProviderImpl::NotifyChange(const Uri &uri)
         LOG_ERROR("connection is nullptr");
         return;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return;
@@ -198,7 +247,7 @@ int GeneralControllerProviderImpl::RegisterObserverExtProvider(const Uri &uri,
         LOG_ERROR("connection is nullptr");
         return E_PROVIDER_CONN_NULL;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return E_PROVIDER_NOT_CONNECTED;
@@ -210,6 +259,8 @@ int GeneralControllerProviderImpl::RegisterObserverExtProvider(const Uri &uri,
     // store the observer when successfully registered.
     if (ret == E_OK) {
         connection->UpdateObserverExtsProviderMap(uri, dataObserver, isDescendants);
+        std::lock_guard<std::mutex> lock(observerMutex_);
+        observers_.emplace_back(uri, dataObserver);
     }
     return ret;
 }
@@ -223,7 +274,7 @@ int GeneralControllerProviderImpl::UnregisterObserverExtProvider(const Uri &uri,
         LOG_ERROR("connection is nullptr");
         return E_PROVIDER_CONN_NULL;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return E_PROVIDER_NOT_CONNECTED;
@@ -235,6 +286,11 @@ int GeneralControllerProviderImpl::UnregisterObserverExtProvider(const Uri &uri,
     // remove the observer from storage when successfully unregistered.
     if (ret == E_OK) {
         connection->DeleteObserverExtsProviderMap(uri, dataObserver);
+        auto matches = [&uri, &dataObserver](const auto &item) {
+            return item.first == uri && item.second == dataObserver;
+        };
+        std::lock_guard<std::mutex> lock(observerMutex_);
+        observers_.erase(std::remove_if(observers_.begin(), observers_.end(), matches), observers_.end());
     }
     return ret;
 }
@@ -247,7 +303,7 @@ int GeneralControllerProviderImpl::NotifyChangeExtProvider(const ChangeInfo &cha
         LOG_ERROR("connection is nullptr");
         return E_PROVIDER_CONN_NULL;
     }
-    auto proxy = connection->GetDataShareProxy(uri_, token_);
+    auto proxy = GetDataShareProxy(connection);
     if (proxy == nullptr) {
         LOG_ERROR("proxy is nullptr");
         return E_PROVIDER_NOT_CONNECTED;
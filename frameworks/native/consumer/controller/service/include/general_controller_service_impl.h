@@ -79,6 +79,11 @@ public:
 
     int32_t SetExtUri(const std::string &extUri) override;
 
+    int32_t BatchInsert(const Uri &uri, const std::vector<DataShareValuesBucket> &values,
+        std::vector<int32_t> &results) override;
+
+    int32_t ExecuteBatch(const std::vector<OperationStatement> &statements, ExecResultSet &result) override;
+
 private:
     void ReRegisterObserver();
 
@@ -162,6 +162,51 @@ std::pair<int32_t, int32_t> GeneralControllerServiceImpl::DeleteEx(const Uri &ur
     return proxy->DeleteEx(uri, Uri(extUri), predicates);
 }
 
+int32_t GeneralControllerServiceImpl::BatchInsert(const Uri &uri, const std::vector<DataShareValuesBucket> &values,
+    std::vector<int32_t> &results)
+{
+    auto manager = DataShareManagerImpl::GetInstance();
+    if (manager == nullptr) {
+        LOG_ERROR("Manager is nullptr");
+        return DATA_SHARE_ERROR;
+    }
+    // a batch is counted as one call, the rows are sent in one request
+    if (manager->SetCallCount(__FUNCTION__, uri.ToString())) {
+        return DATA_SHARE_ERROR;
+    }
+    auto proxy = DataShareManagerImpl::GetServiceProxy();
+    if (proxy == nullptr) {
+        LOG_ERROR("proxy is nullptr");
+        return DATA_SHARE_ERROR;
+    }
+    std::string extUri = GetExtUri();
+    return proxy->BatchInsert(uri, Uri(extUri), values, results);
+}
+
+int32_t GeneralControllerServiceImpl::ExecuteBatch(const std::vector<OperationStatement> &statements,
+    ExecResultSet &result)
+{
+    if (statements.empty()) {
+        LOG_ERROR("statements is empty");
+        return DATA_SHARE_ERROR;
+    }
+    auto manager = DataShareManagerImpl::GetInstance();
+    if (manager == nullptr) {
+        LOG_ERROR("Manager is nullptr");
+        return DATA_SHARE_ERROR;
+    }
+    if (manager->SetCallCount(__FUNCTION__, statements.front().uri)) {
+        return DATA_SHARE_ERROR;
+    }
+    auto proxy = DataShareManagerImpl::GetServiceProxy();
+    if (proxy == nullptr) {
+        LOG_ERROR("proxy is nullptr");
+        return DATA_SHARE_ERROR;
+    }
+    std::string extUri = GetExtUri();
+    return proxy->ExecuteBatch(Uri(extUri), statements, result);
+}
+
 std::shared_ptr<DataShareResultSet> GeneralControllerServiceImpl::Query(const Uri &uri,
     const DataSharePredicates &predicates, std::vector<std::string> &columns,
     DatashareBusinessError &businessError, DataShareOption &option)
@@ -16,6 +16,8 @@
 #ifndef DATASHARE_CONNECTION_BASE_H
 #define DATASHARE_CONNECTION_BASE_H
 
+#include <atomic>
+
 #include "datashare_proxy.h"
 #include "executor_pool.h"
 
@@ -35,6 +37,24 @@ public:
         const sptr<AAFwk::IDataAbilityObserver> &dataObserver, bool isDescendants) = 0;
     virtual void DeleteObserverExtsProviderMap(const Uri &uri,
         const sptr<AAFwk::IDataAbilityObserver> &dataObserver) = 0;
+
+    /**
+     * @brief get the version of the proxy, it changes whenever the proxy is replaced or dropped, so a proxy got
+     * together with a version stays usable as long as the version does not change.
+     */
+    uint64_t GetProxyVersion() const
+    {
+        return proxyVersion_.load(std::memory_order_acquire);
+    }
+
+protected:
+    void UpdateProxyVersion()
+    {
+        proxyVersion_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    std::atomic<uint64_t> proxyVersion_ = 0;
 };
 }  // namespace DataShare
 }  // namespace OHOS
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASHARE_CONNECTION_POOL_H
+#define DATASHARE_CONNECTION_POOL_H
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "executor_pool.h"
+#include "iremote_object.h"
+#include "uri.h"
+
+namespace OHOS {
+namespace DataShare {
+class DataShareConnection;
+/**
+ * @brief Shares the connection to a provider extension between the helpers created with the same token.
+ *
+ * A connection stays in the pool for a while after its last helper is released, so a helper created again
+ * shortly afterwards, or after a prewarm, does not have to wait for the extension to be connected.
+ */
+class DataShareConnectionPool {
+public:
+    struct Statistics {
+        uint64_t created = 0;
+        uint64_t reused = 0;
+        uint64_t evicted = 0;
+        uint64_t connects = 0;
+        // connect time percentiles of the recent connects, in ms
+        int64_t p50 = 0;
+        int64_t p90 = 0;
+        int64_t p99 = 0;
+        int64_t max = 0;
+    };
+
+    static DataShareConnectionPool &GetInstance();
+
+    /**
+     * @brief Returns the pooled connection to the provider of uri, creating it when there is none. The extension is
+     * connected by the first GetDataShareProxy on it, releasing the returned pointer hands the connection back.
+     */
+    std::shared_ptr<DataShareConnection> Acquire(const Uri &uri, const sptr<IRemoteObject> &token, int waitTime);
+
+    /**
+     * @brief Connects the extension of the provider of uri on a pool thread and keeps it in the pool.
+     *
+     * @return E_OK if the connection is started.
+     */
+    int32_t Prewarm(const Uri &uri, const sptr<IRemoteObject> &token, int waitTime);
+
+    int32_t Execute(ExecutorPool::Task task);
+
+    // Called with the time one connect of the extension took, the percentiles are logged every REPORT_INTERVAL times.
+    void RecordConnectTime(int64_t milliseconds);
+
+    Statistics GetStatistics();
+
+private:
+    // The token is held, so its address is not taken by another token while the connection is pooled.
+    struct Key {
+        std::string uri;
+        sptr<IRemoteObject> token;
+
+        bool operator<(const Key &other) const
+        {
+            if (uri != other.uri) {
+                return uri < other.uri;
+            }
+            return std::less<IRemoteObject *>()(token.GetRefPtr(), other.token.GetRefPtr());
+        }
+    };
+    struct Entry {
+        std::shared_ptr<DataShareConnection> connection;
+        size_t refCount = 0;
+        // changed by every acquire, an eviction scheduled before it is dropped
+        uint64_t generation = 0;
+    };
+    struct Lease {
+        Lease(const Key &key, const std::shared_ptr<DataShareConnection> &connection)
+            : key(key), connection(connection) {}
+        ~Lease();
+        Key key;
+        std::shared_ptr<DataShareConnection> connection;
+    };
+
+    DataShareConnectionPool() = default;
+    static Key GetKey(const Uri &uri, const sptr<IRemoteObject> &token);
+    static int64_t GetPercentile(const std::vector<int64_t> &sorted, int percent);
+    void Release(const Key &key);
+    void Evict(const Key &key, uint64_t generation);
+    std::shared_ptr<ExecutorPool> GetExecutor();
+
+    static constexpr int MAX_THREADS = 4;
+    static constexpr int MIN_THREADS = 0;
+    static constexpr size_t CONNECT_TIME_NUM = 128;
+    static constexpr uint64_t REPORT_INTERVAL = 32;
+    static constexpr std::chrono::milliseconds IDLE_TIME = std::chrono::seconds(10);
+
+    std::mutex mutex_;
+    std::map<Key, Entry> entries_;
+    std::shared_ptr<ExecutorPool> executor_;
+    std::chrono::milliseconds idleTime_ = IDLE_TIME;
+    // the recent connect times in ms, used as a ring once full
+    std::vector<int64_t> connectTimes_;
+    size_t nextConnectTime_ = 0;
+    Statistics statistics_;
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // DATASHARE_CONNECTION_POOL_H
@@ -90,6 +90,8 @@ public:
 
 private:
     bool CheckSize(const UpdateOperations &operations);
+    int32_t SendRequest(IDataShareInterfaceCode code, MessageParcel &data, MessageParcel &reply,
+        MessageOption &option);
     int OpenFileInner(const Uri &uri, const std::string &mode, uint32_t requestCode, int32_t &errCode);
     static inline BrokerDelegator<DataShareProxy> delegator_;
     static const size_t MTU_SIZE = 921600; // 900k
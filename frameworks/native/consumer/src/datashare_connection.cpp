@@ -20,6 +20,7 @@
 
 #include "ams_mgr_proxy.h"
 #include "datashare_common.h"
+#include "datashare_connection_pool.h"
 #include "datashare_errno.h"
 #include "datashare_log.h"
 #include "datashare_proxy.h"
@@ -59,6 +60,7 @@ void DataShareConnection::OnAbilityConnectDone(
             return;
         }
         dataShareProxy_ = std::shared_ptr<DataShareProxy>(proxy.GetRefPtr(), [holder = proxy](const auto *) {});
+        UpdateProxyVersion();
         condition_.condition.notify_all();
     }
     if (isInvalid_.load()) {
@@ -97,6 +99,7 @@ void DataShareConnection::OnAbilityDisconnectDone(const AppExecFwk::ElementName
     {
         std::lock_guard<std::mutex> lock(mutex_);
         dataShareProxy_ = nullptr;
+        UpdateProxyVersion();
         uri = uri_.ToString();
     }
     if (uri.empty()) {
@@ -244,6 +247,7 @@ std::shared_ptr<DataShareProxy> DataShareConnection::ConnectDataShareExtAbility(
         LOG_ERROR("get proxy failed uri:%{public}s", DataShareStringUtils::Change(reqUri).c_str());
         return nullptr;
     }
+    auto connectStart = std::chrono::steady_clock::now();
     ErrCode ret = instance->Connect(reqUri, this, token);
     LOG_INFO("uri = %{public}s. ret = %{public}d", DataShareStringUtils::Change(reqUri).c_str(), ret);
     if (ret != ERR_OK) {
@@ -251,24 +255,29 @@ std::shared_ptr<DataShareProxy> DataShareConnection::ConnectDataShareExtAbility(
     }
     std::unique_lock<std::mutex> condLock(mutex_);
     std::shared_ptr<DataShareProxy> proxy = dataShareProxy_;
-    if (proxy != nullptr) {
-        return proxy;
-    }
-    auto start = std::chrono::steady_clock::now();
-    if (condition_.condition.wait_for(condLock, std::chrono::seconds(waitTime_),
-        [this] { return dataShareProxy_ != nullptr; })) {
-        auto finish = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start);
-        if (duration >= TIME_THRESHOLD) {
-            int64_t milliseconds = duration.count();
-            LOG_WARN("over time connecting ability, uri:%{public}s, time:%{public}" PRIi64 "ms",
-                DataShareStringUtils::Change(reqUri).c_str(), milliseconds);
+    if (proxy == nullptr) {
+        auto start = std::chrono::steady_clock::now();
+        if (condition_.condition.wait_for(condLock, std::chrono::seconds(waitTime_),
+            [this] { return dataShareProxy_ != nullptr; })) {
+            auto finish = std::chrono::steady_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start);
+            if (duration >= TIME_THRESHOLD) {
+                int64_t milliseconds = duration.count();
+                LOG_WARN("over time connecting ability, uri:%{public}s, time:%{public}" PRIi64 "ms",
+                    DataShareStringUtils::Change(reqUri).c_str(), milliseconds);
+            }
+            LOG_DEBUG("connect ability ended successfully uri:%{public}s",
+                DataShareStringUtils::Change(reqUri).c_str());
+        } else {
+            LOG_WARN("connect timeout uri:%{public}s", DataShareStringUtils::Change(reqUri).c_str());
         }
-        LOG_DEBUG("connect ability ended successfully uri:%{public}s", DataShareStringUtils::Change(reqUri).c_str());
-    } else {
-        LOG_WARN("connect timeout uri:%{public}s", DataShareStringUtils::Change(reqUri).c_str());
+        proxy = dataShareProxy_;
     }
-    return dataShareProxy_;
+    condLock.unlock();
+    // timeouts are recorded as well, the caller waited for them all the same
+    DataShareConnectionPool::GetInstance().RecordConnectTime(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - connectStart).count());
+    return proxy;
 }
 
 /**
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "datashare_connection_pool"
+
+#include "datashare_connection_pool.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include "datashare_common.h"
+#include "datashare_connection.h"
+#include "datashare_errno.h"
+#include "datashare_log.h"
+#include "datashare_string_utils.h"
+#include "datashare_uri_utils.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+constexpr const char *SCHEME_SEPARATOR = "://";
+constexpr int PERCENT_50 = 50;
+constexpr int PERCENT_90 = 90;
+constexpr int PERCENT_99 = 99;
+constexpr int PERCENT_100 = 100;
+} // namespace
+
+DataShareConnectionPool &DataShareConnectionPool::GetInstance()
+{
+    // never destroyed, leases may still be released while the process exits
+    static DataShareConnectionPool *pool = new DataShareConnectionPool();
+    return *pool;
+}
+
+DataShareConnectionPool::Lease::~Lease()
+{
+    DataShareConnectionPool::GetInstance().Release(key);
+}
+
+DataShareConnectionPool::Key DataShareConnectionPool::GetKey(const Uri &uri, const sptr<IRemoteObject> &token)
+{
+    // the extension is looked up by the first path segment, keep the uri up to it and the user it is visited as
+    std::string uriStr = uri.ToString();
+    uriStr = uriStr.substr(0, uriStr.find('?'));
+    size_t pos = uriStr.find(SCHEME_SEPARATOR);
+    if (pos != std::string::npos) {
+        size_t authorityEnd = uriStr.find('/', pos + strlen(SCHEME_SEPARATOR));
+        if (authorityEnd != std::string::npos) {
+            size_t segmentStart = uriStr.find_first_not_of('/', authorityEnd);
+            if (segmentStart != std::string::npos) {
+                uriStr = uriStr.substr(0, uriStr.find('/', segmentStart));
+            }
+        }
+    }
+    auto [isValid, user] = DataShareURIUtils::GetUserFromUri(uri.ToString());
+    if (!isValid) {
+        // do not share the connection of an uri with a bad user
+        uriStr = uri.ToString();
+    }
+    return Key { uriStr + "?user=" + std::to_string(user), token };
+}
+
+std::shared_ptr<DataShareConnection> DataShareConnectionPool::Acquire(const Uri &uri,
+    const sptr<IRemoteObject> &token, int waitTime)
+{
+    Key key = GetKey(uri, token);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        sptr<DataShareConnection> connection = new (std::nothrow) DataShareConnection(uri, token, waitTime);
+        if (connection == nullptr) {
+            LOG_ERROR("Create DataShareConnection failed.");
+            return nullptr;
+        }
+        Entry entry;
+        entry.connection =
+            std::shared_ptr<DataShareConnection>(connection.GetRefPtr(), [holder = connection](const auto *) {
+                holder->SetConnectInvalid();
+                holder->DisconnectDataShareExtAbility();
+            });
+        it = entries_.emplace(key, std::move(entry)).first;
+        statistics_.created++;
+    } else {
+        statistics_.reused++;
+    }
+    Entry &entry = it->second;
+    entry.refCount++;
+    entry.generation++;
+    auto lease = std::make_shared<Lease>(key, entry.connection);
+    // shares the ownership of the lease, so the connection is handed back when the last helper using it is gone
+    return std::shared_ptr<DataShareConnection>(lease, lease->connection.get());
+}
+
+void DataShareConnectionPool::Release(const Key &key)
+{
+    // disconnected after the lock is released
+    std::shared_ptr<DataShareConnection> evicted;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.refCount == 0) {
+        return;
+    }
+    Entry &entry = it->second;
+    if (--entry.refCount > 0) {
+        return;
+    }
+    auto executor = GetExecutor();
+    if (idleTime_.count() > 0 && executor != nullptr) {
+        auto taskId = executor->Schedule(idleTime_, [this, key, generation = entry.generation]() {
+            Evict(key, generation);
+        });
+        if (taskId != ExecutorPool::INVALID_TASK_ID) {
+            return;
+        }
+    }
+    evicted = std::move(entry.connection);
+    entries_.erase(it);
+    statistics_.evicted++;
+}
+
+void DataShareConnectionPool::Evict(const Key &key, uint64_t generation)
+{
+    std::shared_ptr<DataShareConnection> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end() || it->second.refCount > 0 || it->second.generation != generation) {
+            return;
+        }
+        evicted = std::move(it->second.connection);
+        entries_.erase(it);
+        statistics_.evicted++;
+    }
+    LOG_INFO("Idle connection evicted, uri:%{public}s", DataShareStringUtils::Change(key.uri).c_str());
+}
+
+int32_t DataShareConnectionPool::Prewarm(const Uri &uri, const sptr<IRemoteObject> &token, int waitTime)
+{
+    auto connection = Acquire(uri, token, waitTime);
+    if (connection == nullptr) {
+        return E_ERROR;
+    }
+    // the connection is handed back once connected, and stays in the pool until it is idle for idleTime_
+    return Execute([connection, uri, token]() {
+        if (connection->GetDataShareProxy(uri, token) == nullptr) {
+            LOG_WARN("Prewarm failed, uri:%{public}s", DataShareStringUtils::Change(uri.ToString()).c_str());
+        }
+    });
+}
+
+int32_t DataShareConnectionPool::Execute(ExecutorPool::Task task)
+{
+    std::shared_ptr<ExecutorPool> executor;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        executor = GetExecutor();
+    }
+    if (executor == nullptr || executor->Execute(std::move(task)) == ExecutorPool::INVALID_TASK_ID) {
+        LOG_ERROR("Execute task failed");
+        return E_ERROR;
+    }
+    return E_OK;
+}
+
+std::shared_ptr<ExecutorPool> DataShareConnectionPool::GetExecutor()
+{
+    if (executor_ == nullptr) {
+        executor_ = std::make_shared<ExecutorPool>(MAX_THREADS, MIN_THREADS, DATASHARE_EXECUTOR_NAME);
+    }
+    return executor_;
+}
+
+int64_t DataShareConnectionPool::GetPercentile(const std::vector<int64_t> &sorted, int percent)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    // nearest rank
+    size_t rank = (sorted.size() * static_cast<size_t>(percent) + PERCENT_100 - 1) / PERCENT_100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+void DataShareConnectionPool::RecordConnectTime(int64_t milliseconds)
+{
+    std::vector<int64_t> sorted;
+    uint64_t connects = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connectTimes_.size() < CONNECT_TIME_NUM) {
+            connectTimes_.push_back(milliseconds);
+        } else {
+            connectTimes_[nextConnectTime_] = milliseconds;
+            nextConnectTime_ = (nextConnectTime_ + 1) % CONNECT_TIME_NUM;
+        }
+        connects = ++statistics_.connects;
+        if (connects % REPORT_INTERVAL != 0) {
+            return;
+        }
+        sorted = connectTimes_;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    LOG_INFO("Connect time of the recent %{public}zu connects, total %{public}" PRIu64 ", p50:%{public}" PRIi64
+        "ms, p90:%{public}" PRIi64 "ms, p99:%{public}" PRIi64 "ms, max:%{public}" PRIi64 "ms", sorted.size(),
+        connects, GetPercentile(sorted, PERCENT_50), GetPercentile(sorted, PERCENT_90),
+        GetPercentile(sorted, PERCENT_99), sorted.back());
+}
+
+DataShareConnectionPool::Statistics DataShareConnectionPool::GetStatistics()
+{
+    std::vector<int64_t> sorted;
+    Statistics statistics;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        statistics = statistics_;
+        sorted = connectTimes_;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    statistics.p50 = GetPercentile(sorted, PERCENT_50);
+    statistics.p90 = GetPercentile(sorted, PERCENT_90);
+    statistics.p99 = GetPercentile(sorted, PERCENT_99);
+    statistics.max = sorted.empty() ? 0 : sorted.back();
+    return statistics;
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -21,6 +21,7 @@
 #include "adaptor.h"
 #include "dataobs_mgr_client.h"
 #include "datashare_connection.h"
+#include "datashare_connection_pool.h"
 #include "datashare_sa_connection.h"
 #include "datashare_errno.h"
 #include "datashare_log.h"
@@ -136,6 +137,36 @@ std::pair<int, std::shared_ptr<DataShareHelper>> DataShareHelper::Create(const s
     return std::make_pair(E_ERROR, nullptr);
 }
 
+int DataShareHelper::CreateAsync(const sptr<IRemoteObject> &token, const std::string &strUri,
+    const std::string &extUri, std::function<void(int, std::shared_ptr<DataShareHelper>)> callback,
+    const int waitTime)
+{
+    if (callback == nullptr) {
+        LOG_ERROR("Callback is nullptr, uri:%{public}s", DataShareStringUtils::Change(strUri).c_str());
+        return E_ERROR;
+    }
+    return DataShareConnectionPool::GetInstance().Execute([token, strUri, extUri, callback, waitTime]() {
+        auto [errCode, helper] = Create(token, strUri, extUri, waitTime);
+        callback(errCode, helper);
+    });
+}
+
+int DataShareHelper::Prewarm(const sptr<IRemoteObject> &token, const std::string &strUri, const int waitTime)
+{
+    if (token == nullptr) {
+        LOG_ERROR("Prewarm failed, err: %{public}d", E_TOKEN_EMPTY);
+        return E_TOKEN_EMPTY;
+    }
+    Uri uri(strUri);
+    if (IsProxy(uri) || uri.GetQuery().find("appIndex=") != std::string::npos ||
+        DataShareURIUtils::GetSystemAbilityId(uri.ToString()).first) {
+        LOG_ERROR("Only extension uri can be prewarmed, uri:%{public}s",
+            DataShareStringUtils::Change(strUri).c_str());
+        return E_EXT_URI_INVALID;
+    }
+    return DataShareConnectionPool::GetInstance().Prewarm(uri, token, waitTime);
+}
+
 std::shared_ptr<DataShareHelper> DataShareHelper::CreateServiceHelper(const std::string &extUri,
     const std::string &bundleName, bool isSystem)
 {
@@ -179,16 +210,11 @@ std::shared_ptr<DataShareHelper> DataShareHelper::CreateExtHelper(Uri &uri, cons
         return CreateSAProviderHelper(uri, token, saId, waitTime, isSystem);
     }
 
-    sptr<DataShareConnection> connection = new (std::nothrow) DataShareConnection(uri, token, waitTime);
-    if (connection == nullptr) {
+    auto dataShareConnection = DataShareConnectionPool::GetInstance().Acquire(uri, token, waitTime);
+    if (dataShareConnection == nullptr) {
         LOG_ERROR("Create DataShareConnection failed.");
         return nullptr;
     }
-    auto dataShareConnection =
-        std::shared_ptr<DataShareConnection>(connection.GetRefPtr(), [holder = connection](const auto *) {
-            holder->SetConnectInvalid();
-            holder->DisconnectDataShareExtAbility();
-        });
     auto manager = DataShareManagerImpl::GetInstance();
     if (manager == nullptr) {
         LOG_ERROR("Manager is nullptr");
@@ -288,21 +288,46 @@ int DataShareHelperImpl::BatchInsert(Uri &uri, const std::vector<DataShareValues
 {
     DISTRIBUTED_DATA_HITRACE(std::string(LOG_TAG) + "::" + std::string(__FUNCTION__));
     auto extSpCtl = GetExtSpCtl();
-    if (extSpCtl == nullptr) {
-        LOG_ERROR("providerSepOperator is nullptr");
+    if (extSpCtl != nullptr) {
+        return extSpCtl->BatchInsert(uri, values);
+    }
+    // the silent helper has no extension, the rows are inserted by the data share service in one transaction
+    auto generalCtl = GetGeneralCtl();
+    if (generalCtl == nullptr) {
+        LOG_ERROR("generalCtl is nullptr");
         return DATA_SHARE_ERROR;
     }
-    return extSpCtl->BatchInsert(uri, values);
+    std::vector<int32_t> results;
+    DataShareServiceProxy::SetSystem(isSystem_);
+    auto errCode = generalCtl->BatchInsert(uri, values, results);
+    DataShareServiceProxy::CleanSystem();
+    if (errCode == E_OK) {
+        return static_cast<int>(results.size());
+    }
+    LOG_ERROR("BatchInsert failed, errCode:%{public}d, size:%{public}zu, failed at:%{public}zu", errCode,
+        values.size(), results.empty() ? 0 : results.size() - 1);
+    return errCode < E_OK ? errCode : DATA_SHARE_ERROR;
 }
 
 int DataShareHelperImpl::ExecuteBatch(const std::vector<OperationStatement> &statements, ExecResultSet &result)
 {
     auto extSpCtl = GetExtSpCtl();
-    if (extSpCtl == nullptr) {
-        LOG_ERROR("extSpCtl is nullptr");
+    if (extSpCtl != nullptr) {
+        return extSpCtl->ExecuteBatch(statements, result);
+    }
+    auto generalCtl = GetGeneralCtl();
+    if (generalCtl == nullptr) {
+        LOG_ERROR("generalCtl is nullptr");
         return DATA_SHARE_ERROR;
     }
-    return extSpCtl->ExecuteBatch(statements, result);
+    DataShareServiceProxy::SetSystem(isSystem_);
+    auto errCode = generalCtl->ExecuteBatch(statements, result);
+    DataShareServiceProxy::CleanSystem();
+    if (errCode != E_OK) {
+        LOG_ERROR("ExecuteBatch failed, errCode:%{public}d, size:%{public}zu", errCode, statements.size());
+        return errCode < E_OK ? errCode : DATA_SHARE_ERROR;
+    }
+    return E_OK;
 }
 
 int DataShareHelperImpl::RegisterObserver(const Uri &uri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver)
@@ -20,6 +20,7 @@
 #include <string_ex.h>
 
 #include "data_ability_observer_interface.h"
+#include "datashare_ashmem_parcel.h"
 #include "datashare_itypes_utils.h"
 #include "datashare_log.h"
 #include "datashare_result_set.h"
@@ -159,7 +160,7 @@ int DataShareProxy::Insert(const Uri &uri, const DataShareValuesBucket &value)
 {
     int index = -1;
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return index;
@@ -170,8 +171,7 @@ int DataShareProxy::Insert(const Uri &uri, const DataShareValuesBucket &value)
     }
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_INSERT), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_INSERT, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("Insert fail to SendRequest. err: %{public}d", err);
         return err == PERMISSION_ERR ? PERMISSION_ERR_CODE : index;
@@ -188,7 +188,7 @@ int DataShareProxy::InsertExt(const Uri &uri, const DataShareValuesBucket &value
 {
     int index = -1;
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return index;
@@ -199,8 +199,7 @@ int DataShareProxy::InsertExt(const Uri &uri, const DataShareValuesBucket &value
     }
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_INSERT_EXT), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_INSERT_EXT, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("Insert fail to SendRequest. err: %{public}d", err);
         return index;
@@ -216,7 +215,7 @@ int DataShareProxy::Update(const Uri &uri, const DataSharePredicates &predicates
 {
     int index = -1;
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return index;
@@ -227,8 +226,7 @@ int DataShareProxy::Update(const Uri &uri, const DataSharePredicates &predicates
     }
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_UPDATE), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_UPDATE, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("Update fail to SendRequest. err: %{public}d", err);
         return err == PERMISSION_ERR ? PERMISSION_ERR_CODE : index;
@@ -244,7 +242,7 @@ int DataShareProxy::BatchUpdate(const UpdateOperations &operations, std::vector<
 {
     int ret = -1;
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return ret;
@@ -258,8 +256,7 @@ int DataShareProxy::BatchUpdate(const UpdateOperations &operations, std::vector<
     }
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_BATCH_UPDATE), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_BATCH_UPDATE, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("BatchUpdate fail to SendRequest. err: %{public}d", err);
         return err == PERMISSION_ERR ? PERMISSION_ERR_CODE : ret;
@@ -275,7 +272,7 @@ int DataShareProxy::Delete(const Uri &uri, const DataSharePredicates &predicates
 {
     int index = -1;
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return index;
@@ -287,8 +284,7 @@ int DataShareProxy::Delete(const Uri &uri, const DataSharePredicates &predicates
 
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_DELETE), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_DELETE, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("Delete fail to SendRequest. err: %{public}d", err);
         return err == PERMISSION_ERR ? PERMISSION_ERR_CODE : index;
@@ -303,7 +299,7 @@ int DataShareProxy::Delete(const Uri &uri, const DataSharePredicates &predicates
 std::pair<int32_t, int32_t> DataShareProxy::InsertEx(const Uri &uri, const DataShareValuesBucket &value)
 {
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return std::make_pair(E_WRITE_TO_PARCE_ERROR, 0);
@@ -317,8 +313,7 @@ std::pair<int32_t, int32_t> DataShareProxy::InsertEx(const Uri &uri, const DataS
     int32_t result = -1;
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_INSERT_EX), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_INSERT_EX, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("InsertEx fail to SendRequest. err: %{public}d", err);
         return std::make_pair((err == PERMISSION_ERR ? PERMISSION_ERR_CODE : errCode), 0);
@@ -335,7 +330,7 @@ std::pair<int32_t, int32_t> DataShareProxy::UpdateEx(const Uri &uri, const DataS
     const DataShareValuesBucket &value)
 {
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return std::make_pair(E_WRITE_TO_PARCE_ERROR, 0);
@@ -349,8 +344,7 @@ std::pair<int32_t, int32_t> DataShareProxy::UpdateEx(const Uri &uri, const DataS
     int32_t result = -1;
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_UPDATE_EX), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_UPDATE_EX, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("UpdateEx fail to SendRequest. err: %{public}d", err);
         return std::make_pair((err == PERMISSION_ERR ? PERMISSION_ERR_CODE : errCode), 0);
@@ -366,7 +360,7 @@ std::pair<int32_t, int32_t> DataShareProxy::UpdateEx(const Uri &uri, const DataS
 std::pair<int32_t, int32_t> DataShareProxy::DeleteEx(const Uri &uri, const DataSharePredicates &predicates)
 {
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return std::make_pair(E_WRITE_TO_PARCE_ERROR, 0);
@@ -380,8 +374,7 @@ std::pair<int32_t, int32_t> DataShareProxy::DeleteEx(const Uri &uri, const DataS
     int32_t result = -1;
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_DELETE_EX), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_DELETE_EX, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("DeleteEx fail to SendRequest. err: %{public}d", err);
         return std::make_pair((err == PERMISSION_ERR ? PERMISSION_ERR_CODE : errCode), 0);
@@ -466,7 +459,7 @@ int DataShareProxy::BatchInsert(const Uri &uri, const std::vector<DataShareValue
 {
     int ret = -1;
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return ret;
@@ -481,8 +474,7 @@ int DataShareProxy::BatchInsert(const Uri &uri, const std::vector<DataShareValue
     }
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_BATCH_INSERT), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_BATCH_INSERT, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("fail to SendRequest. err: %{public}d", err);
         return err == PERMISSION_ERR ? PERMISSION_ERR_CODE : ret;
@@ -497,7 +489,7 @@ int DataShareProxy::BatchInsert(const Uri &uri, const std::vector<DataShareValue
 int DataShareProxy::ExecuteBatch(const std::vector<OperationStatement> &statements, ExecResultSet &result)
 {
     MessageParcel data;
-    data.SetMaxCapacity(MTU_SIZE);
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
     if (!data.WriteInterfaceToken(DataShareProxy::GetDescriptor())) {
         LOG_ERROR("WriteInterfaceToken failed");
         return -1;
@@ -509,8 +501,7 @@ int DataShareProxy::ExecuteBatch(const std::vector<OperationStatement> &statemen
 
     MessageParcel reply;
     MessageOption option;
-    int32_t err = Remote()->SendRequest(
-        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_EXECUTE_BATCH), data, reply, option);
+    int32_t err = SendRequest(IDataShareInterfaceCode::CMD_EXECUTE_BATCH, data, reply, option);
     if (err != E_OK) {
         LOG_ERROR("fail to SendRequest. err: %{public}d", err);
         return -1;
@@ -746,6 +737,24 @@ bool DataShareProxy::CheckSize(const UpdateOperations &operations)
     return true;
 }
 
+int32_t DataShareProxy::SendRequest(IDataShareInterfaceCode code, MessageParcel &data, MessageParcel &reply,
+    MessageOption &option)
+{
+    if (data.GetDataSize() <= MTU_SIZE) {
+        return Remote()->SendRequest(static_cast<uint32_t>(code), data, reply, option);
+    }
+    // too large for one binder transaction, the request is handed over in ashmem
+    MessageParcel request;
+    if (!request.WriteInterfaceToken(DataShareProxy::GetDescriptor()) ||
+        !DataShareAshmemParcel::Pack(static_cast<uint32_t>(code), data, request)) {
+        LOG_ERROR("Pack request failed, code:%{public}u, size:%{public}zu", static_cast<uint32_t>(code),
+            data.GetDataSize());
+        return E_ERROR;
+    }
+    return Remote()->SendRequest(
+        static_cast<uint32_t>(IDataShareInterfaceCode::CMD_ASHMEM_REQUEST), request, reply, option);
+}
+
 int32_t DataShareProxy::UserDefineFunc(
     MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
@@ -86,6 +86,7 @@ std::shared_ptr<DataShareProxy> DataShareSAConnection::GetDataShareProxy()
         return nullptr;
     }
     dataShareProxy_ = std::shared_ptr<DataShareProxy>(proxy.GetRefPtr(), [holder = proxy](const auto *) {});
+    UpdateProxyVersion();
     interfaceInfo_ = res.interfaceInfo_;
     return dataShareProxy_;
 }
@@ -236,6 +237,7 @@ void DataShareSAConnection::OnRemoteDied()
     {
         std::lock_guard<std::mutex> lock(mutex_);
         dataShareProxy_ = nullptr;
+        UpdateProxyVersion();
     }
     LOG_INFO("remote died, try to reconnect, saId: %{public}d", saId_);
     GetDataShareProxy();
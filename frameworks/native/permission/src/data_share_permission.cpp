@@ -19,13 +19,13 @@
 
 #include "data_share_permission.h"
 
+#include <cinttypes>
 #include <string>
 
 #include "access_token.h"
 #include "bundle_mgr_helper.h"
 #include "common_event_manager.h"
 #include "common_event_support.h"
-#include "concurrent_map.h"
 #include "data_share_called_config.h"
 #include "datashare_errno.h"
 #include "datashare_log.h"
@@ -60,31 +60,49 @@ void DataSharePermission::SubscribeCommonEvent()
     subscriber_ = subscriber;
 }
 
+DataSharePermission::TokenPermissionCache &DataSharePermission::GetTokenCache()
+{
+    static TokenPermissionCache tokenCache(CACHE_SIZE, TokenPermissionCache::DEFAULT_SHARD_NUM, CACHE_TTL);
+    return tokenCache;
+}
+
 int DataSharePermission::VerifyPermission(Security::AccessToken::AccessTokenID tokenID, const Uri &uri, bool isRead)
 {
-    if (uri.ToString().empty()) {
+    std::string uriStr = uri.ToString();
+    if (uriStr.empty()) {
         LOG_ERROR("Uri empty, tokenId:0x%{public}x", tokenID);
         return ERR_INVALID_VALUE;
     }
-    DataShareCalledConfig calledConfig(uri.ToString());
-    int32_t user = DataShareCalledConfig::GetUserByToken(tokenID);
-    auto [errCode, providerInfo] = calledConfig.GetProviderInfo(user);
-    if (errCode != E_OK) {
-        LOG_ERROR("ProviderInfo failed! token:0x%{public}x, errCode:%{public}d,uri:%{public}s", tokenID,
-            errCode, DataShareStringUtils::Anonymous(uri.ToString()).c_str());
-        return errCode;
+    std::string uriWithoutQuery = uriStr;
+    DataShareStringUtils::RemoveFromQuery(uriWithoutQuery);
+    TokenUriKey tokenUriKey(uriWithoutQuery, tokenID);
+    auto [isCached, permissionInfo] = GetTokenCache().Find(tokenUriKey);
+    if (!isCached) {
+        DataShareCalledConfig calledConfig(uriStr);
+        int32_t user = DataShareCalledConfig::GetUserByToken(tokenID);
+        auto [errCode, providerInfo] = calledConfig.GetProviderInfo(user);
+        if (errCode != E_OK) {
+            LOG_ERROR("ProviderInfo failed! token:0x%{public}x, errCode:%{public}d,uri:%{public}s", tokenID,
+                errCode, DataShareStringUtils::Anonymous(uriStr).c_str());
+            return errCode;
+        }
+        permissionInfo.bundleName = providerInfo.bundleName;
+        permissionInfo.readPermission = providerInfo.readPermission;
+        permissionInfo.writePermission = providerInfo.writePermission;
+        GetTokenCache().Emplace(tokenUriKey, permissionInfo);
     }
-    auto permission = isRead ? providerInfo.readPermission : providerInfo.writePermission;
+    // only the required permission is cached, the grant is checked on every call since it can be revoked
+    auto &permission = isRead ? permissionInfo.readPermission : permissionInfo.writePermission;
     if (permission.empty()) {
         LOG_ERROR("Reject, tokenId:0x%{public}x, uri:%{public}s", tokenID,
-            DataShareStringUtils::Anonymous(providerInfo.uri).c_str());
+            DataShareStringUtils::Anonymous(uriStr).c_str());
         return ERR_PERMISSION_DENIED;
     }
     int status =
         Security::AccessToken::AccessTokenKit::VerifyAccessToken(tokenID, permission);
     if (status != Security::AccessToken::PermissionState::PERMISSION_GRANTED) {
         LOG_ERROR("Permission denied! token:0x%{public}x,permission:%{public}s,uri:%{public}s",
-            tokenID, permission.c_str(), DataShareStringUtils::Anonymous(providerInfo.uri).c_str());
+            tokenID, permission.c_str(), DataShareStringUtils::Anonymous(uriStr).c_str());
         return ERR_PERMISSION_DENIED;
     }
     return E_OK;
@@ -203,6 +221,34 @@ void DataSharePermission::DeleteCache(std::string bundleName)
         }
         return false;
     });
+    GetTokenCache().EraseIf([&bundleName](const TokenUriKey &key, Permission &value) {
+        return value.bundleName == bundleName;
+    });
+    for (auto &[name, statistics] : GetCacheStatistics()) {
+        LOG_INFO("%{public}s cache hits %{public}" PRIu64 ", misses %{public}" PRIu64 ", evictions %{public}" PRIu64
+            ", expirations %{public}" PRIu64, name.c_str(), statistics.hits, statistics.misses,
+            statistics.evictions, statistics.expirations);
+    }
+}
+
+template<typename Statistics>
+static DataSharePermission::CacheStatistics ToCacheStatistics(const Statistics &statistics)
+{
+    DataSharePermission::CacheStatistics result;
+    result.hits = statistics.hits;
+    result.misses = statistics.misses;
+    result.evictions = statistics.evictions;
+    result.expirations = statistics.expirations;
+    return result;
+}
+
+std::map<std::string, DataSharePermission::CacheStatistics> DataSharePermission::GetCacheStatistics()
+{
+    return {
+        { "extension", ToCacheStatistics(extensionCache_.GetStatistics()) },
+        { "silent", ToCacheStatistics(silentCache_.GetStatistics()) },
+        { "token", ToCacheStatistics(GetTokenCache().GetStatistics()) },
+    };
 }
 
 std::pair<int, std::string> DataSharePermission::GetExtensionUriPermission(Uri &uri,
@@ -229,9 +275,6 @@ std::pair<int, std::string> DataSharePermission::GetExtensionUriPermission(Uri &
     permissionInfo.bundleName = extensionInfo.bundleName;
     permissionInfo.readPermission = extensionInfo.readPermission;
     permissionInfo.writePermission = extensionInfo.writePermission;
-    if (extensionCache_.Size() >= CACHE_SIZE) {
-        extensionCache_.Clear();
-    }
     extensionCache_.Emplace(uriKey, permissionInfo);
     permission = isRead ? extensionInfo.readPermission : extensionInfo.writePermission;
     return std::make_pair(E_OK, permission);
@@ -308,9 +351,6 @@ std::pair<int, std::string> DataSharePermission::GetSilentUriPermission(Uri &uri
     permissionInfo.bundleName = providerInfo.bundleName;
     permissionInfo.readPermission = providerInfo.readPermission;
     permissionInfo.writePermission = providerInfo.writePermission;
-    if (silentCache_.Size() >= CACHE_SIZE) {
-        silentCache_.Clear();
-    }
     silentCache_.Emplace(uriKey, permissionInfo);
     permission = isRead ? providerInfo.readPermission : providerInfo.writePermission;
     return std::make_pair(E_OK, permission);
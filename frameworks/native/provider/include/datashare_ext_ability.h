@@ -60,6 +60,13 @@ public:
         std::shared_ptr<AbilityHandler> &handler,
         const sptr<IRemoteObject> &token) override;
 
+    /**
+     * @brief Releases the idle result set blocks of the process on memory pressure.
+     *
+     * @param level the memory level.
+     */
+    void OnMemoryLevel(int level) override;
+
     /**
      * @brief Create Extension.
      *
@@ -293,6 +300,14 @@ public:
 
     virtual void InitResult(std::shared_ptr<ResultWrap> result);
 
+    /**
+     * @brief Whether the extension accepts a read while another read is still pending. It is declared by the
+     * metadata "ohos.extension.dataShare.reentrant" with the value "true" in the extension config.
+     *
+     * @return Returns true if reads of the extension may overlap.
+     */
+    virtual bool IsReentrant();
+
     /**
      * @brief Set a creator function.
      *
@@ -16,6 +16,10 @@
 #ifndef DATASHARE_RESULT_H
 #define DATASHARE_RESULT_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
 #include "datashare_result_set.h"
 #include "datashare_operation_statement.h"
 #include "datashare_business_error.h"
@@ -43,6 +47,20 @@ public:
         return isRecvReply_;
     }
 
+    // Called by the extension callback once the result is set, wakes up the caller waiting in WaitRecvReply.
+    void SetRecvReply()
+    {
+        std::lock_guard<std::mutex> lock(replyLock_);
+        isRecvReply_ = true;
+        replyCond_.notify_all();
+    }
+
+    bool WaitRecvReply(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(replyLock_);
+        return replyCond_.wait_for(lock, timeout, [this] { return isRecvReply_.load(); });
+    }
+
     void GetResult(int &value)
     {
         value = callbackResultNumber_;
@@ -79,7 +97,7 @@ public:
     }
 
 public:
-    bool isRecvReply_ = false;
+    std::atomic<bool> isRecvReply_ = false;
     int callbackResultNumber_ = -1;
     std::string callbackResultString_ = "";
     std::vector<std::string> callbackResultStringArr_ = {};
@@ -87,6 +105,10 @@ public:
     std::shared_ptr<DataShareResultSet> callbackResultObject_ = nullptr;
     DatashareBusinessError businessError_;
     std::vector<BatchUpdateResult> updateResults_ = {};
+
+private:
+    std::mutex replyLock_;
+    std::condition_variable replyCond_;
 };
 
 } // namespace DataShare
@@ -37,6 +37,12 @@ public:
     */
     bool VerifyPermissionAndUri(std::string uri, uint32_t tokenId);
     virtual DataShareNonSilentConfig GetConfig();
+protected:
+    /**
+     * Returns and clears the error of the last call made on this thread, for the calls whose return value
+     * can not carry one.
+    */
+    virtual int32_t TakeCallError();
 private:
     ErrCode CmdGetFileTypes(MessageParcel &data, MessageParcel &reply);
     ErrCode CmdOpenFile(MessageParcel &data, MessageParcel &reply);
@@ -60,6 +66,7 @@ private:
     ErrCode CmdUpdateEx(MessageParcel &data, MessageParcel &reply);
     ErrCode CmdDeleteEx(MessageParcel &data, MessageParcel &reply);
     ErrCode CmdUserDefineFunc(MessageParcel &data, MessageParcel &reply, MessageOption &option);
+    ErrCode CmdAshmemRequest(MessageParcel &data, MessageParcel &reply, MessageOption &option);
     ErrCode CmdRegisterObserverExtProvider(MessageParcel &data, MessageParcel &reply);
     ErrCode CmdUnregisterObserverExtProvider(MessageParcel &data, MessageParcel &reply);
     ErrCode CmdNotifyChangeExtProvider(MessageParcel &data, MessageParcel &reply);
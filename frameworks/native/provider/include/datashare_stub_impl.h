@@ -18,6 +18,7 @@
 
 #include <memory>
 #include "datashare_stub.h"
+#include "datashare_stub_scheduler.h"
 #include "datashare_uv_queue.h"
 #include "js_datashare_ext_ability.h"
 #include "sts_datashare_ext_ability.h"
@@ -33,6 +34,7 @@ public:
         : extension_(extension)
     {
         uvQueue_ = std::make_shared<DataShare::DataShareUvQueue>(env);
+        scheduler_ = std::make_shared<DataShareStubScheduler>(extension != nullptr && extension->IsReentrant());
         flag_ = 0;
     }
 
@@ -40,6 +42,7 @@ public:
         : extension_(extension)
     {
         uvQueue_ = std::make_shared<DataShare::DataShareUvQueue>();
+        scheduler_ = std::make_shared<DataShareStubScheduler>(extension != nullptr && extension->IsReentrant());
         flag_ = 1;
     }
 
@@ -86,6 +89,11 @@ public:
 
     static int32_t GetCallingUserId();
 
+    int Dump(int fd, const std::vector<std::u16string> &args) override;
+
+protected:
+    int32_t TakeCallError() override;
+
 private:
     std::shared_ptr<DataShareExtAbility> GetOwner();
     bool CheckCallingPermission(const std::string &permission);
@@ -95,10 +103,14 @@ private:
         const std::string &uri = "");
     bool VerifyPredicates(const DataSharePredicates &predicates, const CallingInfo &callingInfo,
         const std::string &func);
+    bool SyncCall(DataShareStubScheduler::CallType type, uint32_t callerId, const std::string &func,
+        std::function<void()> syncTaskFunc, std::function<bool()> getRetFunc = std::function<bool()>(),
+        std::shared_ptr<ResultWrap> result = nullptr);
     std::shared_ptr<DataShareExtAbility> extension_;
     std::shared_ptr<DataShare::DataShareUvQueue> uvQueue_;
-    std::mutex mutex_;
+    std::shared_ptr<DataShareStubScheduler> scheduler_;
     int flag_; // js:0, sts:1
+    static thread_local int32_t callError_;
 };
 } // namespace DataShare
 } // namespace OHOS
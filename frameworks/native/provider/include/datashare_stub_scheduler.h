@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASHARE_STUB_SCHEDULER_H
+#define DATASHARE_STUB_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace OHOS {
+namespace DataShare {
+/**
+ * @brief Orders the calls handed to the extension by DataShareStubImpl.
+ *
+ * Calls wait in one lane per operation class. Reads run side by side when the extension is reentrant, every
+ * other call runs alone. Waiting callers are served in turn, so one busy caller can not starve the others.
+ */
+class DataShareStubScheduler {
+public:
+    enum CallType : int32_t {
+        READ = 0,
+        WRITE,
+        CALL_TYPE_BUTT
+    };
+
+    struct Statistics {
+        uint64_t count = 0;
+        uint64_t rejected = 0;
+        uint64_t totalWaitTimeUs = 0;
+        uint64_t maxWaitTimeUs = 0;
+    };
+
+    explicit DataShareStubScheduler(bool reentrant, size_t maxReaders = MAX_READERS,
+        size_t maxWaiters = MAX_WAITERS);
+
+    /**
+     * @brief Waits until the call may run, each successful Acquire is paired with Release.
+     *
+     * @param type The operation class of the call.
+     * @param callerId The calling token, calls of the same caller keep their order.
+     * @param waitTimeUs Returns the time the call waited in the queue.
+     *
+     * @return E_OK when the call may run, E_ERROR_OVER_LIMIT_TASK when the queue is full.
+     */
+    int32_t Acquire(CallType type, uint32_t callerId, int64_t &waitTimeUs);
+
+    void Release(CallType type);
+
+    Statistics GetStatistics(CallType type);
+
+private:
+    static constexpr size_t MAX_READERS = 4;
+    static constexpr size_t MAX_WAITERS = 64;
+
+    struct Waiter {
+        CallType type;
+        bool admitted = false;
+    };
+
+    bool IsExclusive(CallType type) const;
+    bool CanAdmit(CallType type) const;
+    void Admit(CallType type);
+    void Dispatch();
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    const bool reentrant_;
+    const size_t maxReaders_;
+    const size_t maxWaiters_;
+    bool exclusive_ = false;
+    size_t activeReaders_ = 0;
+    size_t waiterCount_ = 0;
+    // Pending calls of every caller in arrival order, callers_ holds the callers to serve in turn.
+    std::map<uint32_t, std::deque<Waiter *>> waiters_;
+    std::deque<uint32_t> callers_;
+    Statistics statistics_[CALL_TYPE_BUTT];
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // DATASHARE_STUB_SCHEDULER_H
@@ -16,9 +16,12 @@
 #ifndef DATASHARE_UV_QUEUE_H
 #define DATASHARE_UV_QUEUE_H
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 #include "napi/native_api.h"
 #include "napi/native_common.h"
@@ -30,16 +33,39 @@ namespace DataShare {
 class DataShareUvQueue {
     using VoidFunc = std::function<void()>;
     using BoolFunc = std::function<bool()>;
+    // Blocks until the async reply arrives or the timeout expires, returns whether the reply arrived.
+    using WaitFunc = std::function<bool(std::chrono::milliseconds)>;
 
 public:
+    enum ReplyType : int32_t {
+        // The reply was set before the task on the js thread returned.
+        SYNC_REPLY = 0,
+        // The reply was set later by a resolved promise or callback.
+        ASYNC_REPLY,
+        REPLY_TYPE_BUTT
+    };
+
     explicit DataShareUvQueue(napi_env env);
     DataShareUvQueue() = default;
     virtual ~DataShareUvQueue() = default;
 
-    void JsSyncCall(VoidFunc func = VoidFunc(), BoolFunc retFunc = BoolFunc());
-    void StsSyncCall(VoidFunc func = VoidFunc(), BoolFunc retFunc = BoolFunc());
+    void JsSyncCall(VoidFunc func = VoidFunc(), BoolFunc retFunc = BoolFunc(), WaitFunc waitFunc = WaitFunc());
+    void StsSyncCall(VoidFunc func = VoidFunc(), BoolFunc retFunc = BoolFunc(), WaitFunc waitFunc = WaitFunc());
+
+    void CheckFuncAndExec(BoolFunc retFunc, WaitFunc waitFunc = WaitFunc(),
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now());
 
-    void CheckFuncAndExec(BoolFunc retFunc);
+    /**
+     * @brief Gets the call latency histogram of one reply type, from posting the task to receiving the reply.
+     *
+     * @return The count of calls in each bucket, bucket i counts the calls below LATENCY_BUCKETS_US[i] and the
+     * last bucket counts the remaining ones.
+     */
+    static std::vector<uint64_t> GetLatencyHistogram(ReplyType type);
+
+    static constexpr int64_t LATENCY_BUCKETS_US[] = { 100, 500, 1000, 2000, 5000, 10000, 50000, 100000, 500000,
+        1000000, 2000000 };
+    static constexpr size_t LATENCY_BUCKET_NUM = sizeof(LATENCY_BUCKETS_US) / sizeof(LATENCY_BUCKETS_US[0]) + 1;
 
 private:
     struct TaskEntry {
@@ -51,6 +77,9 @@ private:
     };
 
     static void LambdaForWork(TaskEntry* taskEntry);
+    static void RecordLatency(ReplyType type, std::chrono::steady_clock::time_point start);
+
+    static std::atomic<uint64_t> latencyHistogram_[REPLY_TYPE_BUTT][LATENCY_BUCKET_NUM];
 
     napi_env naipEnv_ = nullptr;
     uv_loop_s* loop_ = nullptr;
@@ -20,6 +20,7 @@
 #include "ability_loader.h"
 #include "connection_manager.h"
 #include "datashare_log.h"
+#include "shared_block_pool.h"
 #include "js_datashare_ext_ability.h"
 #include "sts_datashare_ext_ability.h"
 #include "runtime.h"
@@ -28,6 +29,7 @@
 namespace OHOS {
 namespace DataShare {
 using namespace OHOS::AppExecFwk;
+constexpr const char *REENTRANT_METADATA = "ohos.extension.dataShare.reentrant";
 
 CreatorFunc DataShareExtAbility::creator_ = nullptr;
 void DataShareExtAbility::SetCreator(const CreatorFunc& creator)
@@ -67,6 +69,14 @@ void DataShareExtAbility::Init(const std::shared_ptr<AbilityLocalRecord> &record
     LOG_INFO("DSExt init");
 }
 
+void DataShareExtAbility::OnMemoryLevel(int level)
+{
+    ExtensionBase<DataShareExtAbilityContext>::OnMemoryLevel(level);
+    LOG_INFO("DSExt memory level %{public}d, idle blocks %{public}zu bytes", level,
+        SharedBlockPool::GetInstance().GetIdleBytes());
+    SharedBlockPool::GetInstance().Trim();
+}
+
 std::vector<std::string> DataShareExtAbility::GetFileTypes(const Uri &uri, const std::string &mimeTypeFilter)
 {
     std::vector<std::string> ret;
@@ -185,5 +195,18 @@ void DataShareExtAbility::InitResult(std::shared_ptr<ResultWrap> result)
 {
     return;
 }
+
+bool DataShareExtAbility::IsReentrant()
+{
+    if (abilityInfo_ == nullptr) {
+        return false;
+    }
+    for (const auto &item : abilityInfo_->metadata) {
+        if (item.name == REENTRANT_METADATA) {
+            return item.value == "true";
+        }
+    }
+    return false;
+}
 } // namespace DataShare
 } // namespace OHOS
\ No newline at end of file
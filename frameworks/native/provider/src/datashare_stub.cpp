@@ -21,6 +21,7 @@
 
 #include "accesstoken_kit.h"
 #include "data_ability_observer_interface.h"
+#include "datashare_ashmem_parcel.h"
 #include "datashare_itypes_utils.h"
 #include "datashare_log.h"
 #include "hiview_datashare.h"
@@ -100,6 +101,8 @@ int DataShareStub::OnRemoteRequest(uint32_t code, MessageParcel& data, MessagePa
     } else if (code == static_cast<uint32_t>(IDataShareInterfaceCode::CMD_USER_DEFINE_FUNC)) {
         isCodeValid = true;
         ret = CmdUserDefineFunc(data, reply, option);
+    } else if (code == static_cast<uint32_t>(IDataShareInterfaceCode::CMD_ASHMEM_REQUEST)) {
+        return CmdAshmemRequest(data, reply, option);
     }
     if (isCodeValid) {
         auto finish = std::chrono::steady_clock::now();
@@ -180,6 +183,10 @@ ErrCode DataShareStub::CmdGetFileTypes(MessageParcel &data, MessageParcel &reply
         return ERR_INVALID_VALUE;
     }
     std::vector<std::string> types = GetFileTypes(uri, mimeTypeFilter);
+    int32_t errCode = TakeCallError();
+    if (errCode != E_OK) {
+        return errCode;
+    }
     if (!ITypesUtil::Marshal(reply, types)) {
         LOG_ERROR("Marshal value is nullptr");
         return ERR_INVALID_VALUE;
@@ -459,6 +466,10 @@ ErrCode DataShareStub::CmdGetType(MessageParcel &data, MessageParcel &reply)
         return ERR_INVALID_VALUE;
     }
     std::string type = GetType(uri);
+    int32_t errCode = TakeCallError();
+    if (errCode != E_OK) {
+        return errCode;
+    }
     if (!reply.WriteString(type)) {
         LOG_ERROR("fail to WriteString type");
         return ERR_INVALID_VALUE;
@@ -472,6 +483,21 @@ ErrCode DataShareStub::CmdUserDefineFunc(MessageParcel &data, MessageParcel &rep
     return E_OK;
 }
 
+ErrCode DataShareStub::CmdAshmemRequest(MessageParcel &data, MessageParcel &reply, MessageOption &option)
+{
+    uint32_t code = 0;
+    MessageParcel request;
+    if (!DataShareAshmemParcel::Unpack(data, code, request)) {
+        return ERR_INVALID_VALUE;
+    }
+    // only the calls of stubFuncMap_ are carried by ashmem, which also rules out an ashmem request in another one
+    if (stubFuncMap_.find(code) == stubFuncMap_.end()) {
+        LOG_ERROR("Code of ashmem request is invalid:%{public}u", code);
+        return ERR_INVALID_VALUE;
+    }
+    return OnRemoteRequest(code, request, reply, option);
+}
+
 ErrCode DataShareStub::CmdBatchInsert(MessageParcel &data, MessageParcel &reply)
 {
     Uri uri("");
@@ -552,6 +578,10 @@ ErrCode DataShareStub::CmdNotifyChange(MessageParcel &data, MessageParcel &reply
     }
 
     bool ret = NotifyChange(uri);
+    int32_t errCode = TakeCallError();
+    if (errCode != E_OK) {
+        return errCode;
+    }
     if (!reply.WriteInt32(ret)) {
         LOG_ERROR("fail to WriteInt32 ret");
         return ERR_INVALID_VALUE;
@@ -629,6 +659,10 @@ ErrCode DataShareStub::CmdNormalizeUri(MessageParcel &data, MessageParcel &reply
         return ERR_INVALID_VALUE;
     }
     auto ret = NormalizeUri(uri);
+    int32_t errCode = TakeCallError();
+    if (errCode != E_OK) {
+        return errCode;
+    }
     if (!ITypesUtil::Marshal(reply, ret)) {
         LOG_ERROR("Write to message parcel failed!");
         return ERR_INVALID_VALUE;
@@ -645,6 +679,10 @@ ErrCode DataShareStub::CmdDenormalizeUri(MessageParcel &data, MessageParcel &rep
     }
 
     auto ret = DenormalizeUri(uri);
+    int32_t errCode = TakeCallError();
+    if (errCode != E_OK) {
+        return errCode;
+    }
     if (!ITypesUtil::Marshal(reply, ret)) {
         LOG_ERROR("Write to message parcel failed!");
         return ERR_INVALID_VALUE;
@@ -748,5 +786,10 @@ DataShareNonSilentConfig DataShareStub::GetConfig()
     DataShareNonSilentConfig config;
     return config;
 }
+
+int32_t DataShareStub::TakeCallError()
+{
+    return E_OK;
+}
 } // namespace DataShare
 } // namespace OHOS
\ No newline at end of file
@@ -16,6 +16,8 @@
 #define LOG_TAG "datashare_stub_impl"
 
 #include "datashare_stub_impl.h"
+#include <cinttypes>
+#include <cstdio>
 #include <string>
 
 #include "accesstoken_kit.h"
@@ -37,6 +39,8 @@ using OHOS::Security::AccessToken::AccessTokenKit;
 
 constexpr int DEFAULT_NUMBER = -1;
 constexpr int PERMISSION_ERROR_NUMBER = -2;
+// Calls waiting longer than this in the scheduler are logged.
+constexpr int64_t SLOW_WAIT_TIME_US = 500000;
 const std::set<std::string> PROVIDER_LIST = {
     "5765880207853551549",
     "5765880207853570539",
@@ -44,6 +48,8 @@ const std::set<std::string> PROVIDER_LIST = {
     "5765880207854616753"
 }; // Allowlist corresponds to datamgr_service providerIdentifiers list
 
+thread_local int32_t DataShareStubImpl::callError_ = E_OK;
+
 std::shared_ptr<DataShareExtAbility> DataShareStubImpl::GetOwner()
 {
     if (extension_ == nullptr) {
@@ -155,11 +161,9 @@ std::vector<std::string> DataShareStubImpl::GetFileTypes(const Uri &uri, const s
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::READ, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        callError_ = E_ERROR_OVER_LIMIT_TASK;
+        return std::vector<std::string>();
     }
     return ret;
 }
@@ -187,6 +191,7 @@ int DataShareStubImpl::OpenFile(const Uri &uri, const std::string &mode)
             return PERMISSION_ERROR_NUMBER;
         }
     }
+    auto type = needWrite ? DataShareStubScheduler::WRITE : DataShareStubScheduler::READ;
     auto result = std::make_shared<ResultWrap>();
     int ret = -1;
     std::function<void()> syncTaskFunc = [extension, info, uri, mode, result]() {
@@ -202,11 +207,8 @@ int DataShareStubImpl::OpenFile(const Uri &uri, const std::string &mode)
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(type, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return DEFAULT_NUMBER;
     }
     return ret;
 }
@@ -234,16 +236,14 @@ int DataShareStubImpl::OpenRawFile(const Uri &uri, const std::string &mode)
             return PERMISSION_ERROR_NUMBER;
         }
     }
+    auto type = needWrite ? DataShareStubScheduler::WRITE : DataShareStubScheduler::READ;
     std::shared_ptr<int> ret = std::make_shared<int>(-1);
     std::function<void()> syncTaskFunc = [extension, ret, info, uri, mode]() {
         extension->SetCallingInfo(info);
         *ret = extension->OpenRawFile(uri, mode);
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc);
+    if (!SyncCall(type, info.callingTokenId, __FUNCTION__, syncTaskFunc)) {
+        return DEFAULT_NUMBER;
     }
     return *ret;
 }
@@ -283,11 +283,8 @@ int DataShareStubImpl::Insert(const Uri &uri, const DataShareValuesBucket &value
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return DEFAULT_NUMBER;
     }
     return ret;
 }
@@ -331,11 +328,8 @@ int DataShareStubImpl::Update(const Uri &uri, const DataSharePredicates &predica
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return DEFAULT_NUMBER;
     }
     return ret;
 }
@@ -373,11 +367,8 @@ int DataShareStubImpl::BatchUpdate(const UpdateOperations &operations, std::vect
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return DEFAULT_NUMBER;
     }
     return ret;
 }
@@ -420,11 +411,8 @@ int DataShareStubImpl::Delete(const Uri &uri, const DataSharePredicates &predica
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return DEFAULT_NUMBER;
     }
     return ret;
 }
@@ -462,11 +450,8 @@ std::pair<int32_t, int32_t> DataShareStubImpl::InsertEx(const Uri &uri, const Da
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return std::make_pair(E_ERROR_OVER_LIMIT_TASK, 0);
     }
     return std::make_pair(E_OK, ret);
 }
@@ -510,11 +495,8 @@ std::pair<int32_t, int32_t> DataShareStubImpl::UpdateEx(const Uri &uri, const Da
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return std::make_pair(E_ERROR_OVER_LIMIT_TASK, 0);
     }
     return std::make_pair(E_OK, ret);
 }
@@ -557,11 +539,8 @@ std::pair<int32_t, int32_t> DataShareStubImpl::DeleteEx(const Uri &uri, const Da
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return std::make_pair(E_ERROR_OVER_LIMIT_TASK, 0);
     }
     return std::make_pair(E_OK, ret);
 }
@@ -607,11 +586,9 @@ std::shared_ptr<DataShareResultSet> DataShareStubImpl::Query(const Uri &uri,
         result->GetBusinessError(businessError);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::READ, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        businessError.SetCode(E_ERROR_OVER_LIMIT_TASK);
+        return nullptr;
     }
     return resultSet;
 }
@@ -643,11 +620,9 @@ std::string DataShareStubImpl::GetType(const Uri &uri)
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::READ, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        callError_ = E_ERROR_OVER_LIMIT_TASK;
+        return "";
     }
     return ret;
 }
@@ -685,11 +660,8 @@ int DataShareStubImpl::BatchInsert(const Uri &uri, const std::vector<DataShareVa
         result->GetResult(ret);
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::WRITE, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        return DEFAULT_NUMBER;
     }
     return ret;
 }
@@ -751,11 +723,9 @@ bool DataShareStubImpl::NotifyChange(const Uri &uri)
     std::function<void()> syncTaskFunc = [extension, ret, uri, callingUserId, callingToken, callingPid]() {
         *ret = extension->NotifyChangeWithUser(uri, callingUserId, callingToken, callingPid);
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc);
+    if (!SyncCall(DataShareStubScheduler::READ, callingToken, __FUNCTION__, syncTaskFunc)) {
+        callError_ = E_ERROR_OVER_LIMIT_TASK;
+        return false;
     }
     return *ret;
 }
@@ -788,11 +758,9 @@ Uri DataShareStubImpl::NormalizeUri(const Uri &uri)
         normalizeUri = tmp;
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::READ, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        callError_ = E_ERROR_OVER_LIMIT_TASK;
+        return Uri("");
     }
     return normalizeUri;
 }
@@ -824,11 +792,9 @@ Uri DataShareStubImpl::DenormalizeUri(const Uri &uri)
         denormalizedUri = tmp;
         return isRecvReply;
     };
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (flag_ == 0) {
-        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc);
-    } else if (flag_ == 1) {
-        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc);
+    if (!SyncCall(DataShareStubScheduler::READ, info.callingTokenId, __FUNCTION__, syncTaskFunc, getRetFunc, result)) {
+        callError_ = E_ERROR_OVER_LIMIT_TASK;
+        return Uri("");
     }
     return denormalizedUri;
 }
@@ -839,5 +805,50 @@ void DataShareStubImpl::GetCallingInfo(CallingInfo& callingInfo)
     callingInfo.callingPid = GetCallingPid();
     callingInfo.callingUid = GetCallingUid();
 }
+
+bool DataShareStubImpl::SyncCall(DataShareStubScheduler::CallType type, uint32_t callerId, const std::string &func,
+    std::function<void()> syncTaskFunc, std::function<bool()> getRetFunc, std::shared_ptr<ResultWrap> result)
+{
+    int64_t waitTime = 0;
+    if (scheduler_->Acquire(type, callerId, waitTime) != E_OK) {
+        LOG_ERROR("%{public}s rejected, token %{public}u", func.c_str(), callerId);
+        return false;
+    }
+    if (waitTime > SLOW_WAIT_TIME_US) {
+        LOG_WARN("%{public}s waited %{public}" PRId64 "us in queue, token %{public}u", func.c_str(), waitTime,
+            callerId);
+    }
+    std::function<bool(std::chrono::milliseconds)> waitFunc;
+    if (result != nullptr) {
+        waitFunc = [result](std::chrono::milliseconds timeout) { return result->WaitRecvReply(timeout); };
+    }
+    if (flag_ == 0) {
+        uvQueue_->JsSyncCall(syncTaskFunc, getRetFunc, waitFunc);
+    } else if (flag_ == 1) {
+        uvQueue_->StsSyncCall(syncTaskFunc, getRetFunc, waitFunc);
+    }
+    scheduler_->Release(type);
+    return true;
+}
+
+int32_t DataShareStubImpl::TakeCallError()
+{
+    int32_t error = callError_;
+    callError_ = E_OK;
+    return error;
+}
+
+int DataShareStubImpl::Dump(int fd, const std::vector<std::u16string> &args)
+{
+    static const char *const CALL_TYPE_NAMES[DataShareStubScheduler::CALL_TYPE_BUTT] = { "read", "write" };
+    for (int32_t type = DataShareStubScheduler::READ; type < DataShareStubScheduler::CALL_TYPE_BUTT; type++) {
+        auto statistics = scheduler_->GetStatistics(static_cast<DataShareStubScheduler::CallType>(type));
+        uint64_t avgWaitTimeUs = statistics.count == 0 ? 0 : statistics.totalWaitTimeUs / statistics.count;
+        dprintf(fd, "%s calls: %" PRIu64 ", rejected: %" PRIu64 ", avg wait: %" PRIu64 "us, max wait: %" PRIu64
+            "us\n", CALL_TYPE_NAMES[type], statistics.count, statistics.rejected, avgWaitTimeUs,
+            statistics.maxWaitTimeUs);
+    }
+    return E_OK;
+}
 } // namespace DataShare
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "datashare_stub_scheduler"
+
+#include "datashare_stub_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "datashare_errno.h"
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace std::chrono;
+
+DataShareStubScheduler::DataShareStubScheduler(bool reentrant, size_t maxReaders, size_t maxWaiters)
+    : reentrant_(reentrant), maxReaders_(std::max<size_t>(maxReaders, 1)), maxWaiters_(maxWaiters)
+{
+}
+
+bool DataShareStubScheduler::IsExclusive(CallType type) const
+{
+    return type != READ || !reentrant_;
+}
+
+bool DataShareStubScheduler::CanAdmit(CallType type) const
+{
+    if (exclusive_) {
+        return false;
+    }
+    return IsExclusive(type) ? activeReaders_ == 0 : activeReaders_ < maxReaders_;
+}
+
+void DataShareStubScheduler::Admit(CallType type)
+{
+    if (IsExclusive(type)) {
+        exclusive_ = true;
+    } else {
+        activeReaders_++;
+    }
+}
+
+int32_t DataShareStubScheduler::Acquire(CallType type, uint32_t callerId, int64_t &waitTimeUs)
+{
+    if (type < READ || type >= CALL_TYPE_BUTT) {
+        LOG_ERROR("Invalid call type %{public}d", type);
+        return E_ERROR;
+    }
+    auto start = steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    Statistics &statistics = statistics_[type];
+    if (waiters_.empty() && CanAdmit(type)) {
+        Admit(type);
+        statistics.count++;
+        waitTimeUs = 0;
+        return E_OK;
+    }
+    if (waiterCount_ >= maxWaiters_) {
+        statistics.rejected++;
+        LOG_ERROR("Too many waiting calls %{public}zu, type %{public}d, token %{public}u",
+            waiterCount_, type, callerId);
+        return E_ERROR_OVER_LIMIT_TASK;
+    }
+    Waiter waiter { type };
+    auto &queue = waiters_[callerId];
+    if (queue.empty()) {
+        callers_.push_back(callerId);
+    }
+    queue.push_back(&waiter);
+    waiterCount_++;
+    Dispatch();
+    cond_.wait(lock, [&waiter] { return waiter.admitted; });
+
+    waitTimeUs = duration_cast<microseconds>(steady_clock::now() - start).count();
+    statistics.count++;
+    statistics.totalWaitTimeUs += static_cast<uint64_t>(waitTimeUs);
+    statistics.maxWaitTimeUs = std::max(statistics.maxWaitTimeUs, static_cast<uint64_t>(waitTimeUs));
+    return E_OK;
+}
+
+void DataShareStubScheduler::Release(CallType type)
+{
+    if (type < READ || type >= CALL_TYPE_BUTT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (IsExclusive(type)) {
+        exclusive_ = false;
+    } else if (activeReaders_ > 0) {
+        activeReaders_--;
+    }
+    Dispatch();
+}
+
+void DataShareStubScheduler::Dispatch()
+{
+    bool admitted = false;
+    // Serve the head call of each caller in turn, stop at the first one that has to wait, so a write queued
+    // behind running reads is not overtaken by later reads.
+    while (!callers_.empty()) {
+        uint32_t callerId = callers_.front();
+        auto it = waiters_.find(callerId);
+        if (it == waiters_.end() || it->second.empty()) {
+            callers_.pop_front();
+            continue;
+        }
+        Waiter *waiter = it->second.front();
+        if (!CanAdmit(waiter->type)) {
+            break;
+        }
+        Admit(waiter->type);
+        waiter->admitted = true;
+        admitted = true;
+        it->second.pop_front();
+        waiterCount_--;
+        callers_.pop_front();
+        if (it->second.empty()) {
+            waiters_.erase(it);
+        } else {
+            callers_.push_back(callerId);
+        }
+    }
+    if (admitted) {
+        cond_.notify_all();
+    }
+}
+
+DataShareStubScheduler::Statistics DataShareStubScheduler::GetStatistics(CallType type)
+{
+    if (type < READ || type >= CALL_TYPE_BUTT) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_[type];
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -16,6 +16,7 @@
 #define LOG_TAG "datashare_uv_queue"
 
 #include "datashare_uv_queue.h"
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include "datashare_log.h"
@@ -30,6 +31,8 @@ constexpr int SLEEP_TIME = 1;
 constexpr int TRY_TIMES = 2000;
 static constexpr const char* TASK_DATASHAREUVQUEUE_TASKENTRY = "datashare.DataShareUVQueue";
 
+std::atomic<uint64_t> DataShareUvQueue::latencyHistogram_[REPLY_TYPE_BUTT][LATENCY_BUCKET_NUM] = {};
+
 DataShareUvQueue::DataShareUvQueue(napi_env env)
     : naipEnv_(env)
 {
@@ -56,8 +59,9 @@ void DataShareUvQueue::LambdaForWork(TaskEntry* taskEntry)
     }
 }
 
-void DataShareUvQueue::JsSyncCall(VoidFunc func, BoolFunc retFunc)
+void DataShareUvQueue::JsSyncCall(VoidFunc func, BoolFunc retFunc, WaitFunc waitFunc)
 {
+    auto start = steady_clock::now();
     auto *taskEntry = new (std::nothrow)TaskEntry {std::move(func), false, {}, {}, std::atomic<int>(1)};
     if (taskEntry == nullptr) {
         LOG_ERROR("invalid taskEntry.");
@@ -83,15 +87,16 @@ void DataShareUvQueue::JsSyncCall(VoidFunc func, BoolFunc retFunc)
             LOG_WARN("function ended successfully. times %{public}" PRIu64 ".", time);
         }
     }
-    CheckFuncAndExec(retFunc);
+    CheckFuncAndExec(retFunc, waitFunc, start);
     if (taskEntry->count.fetch_sub(1) == 1) {
         delete taskEntry;
         taskEntry = nullptr;
     }
 }
 
-void DataShareUvQueue::StsSyncCall(VoidFunc func, BoolFunc retFunc)
+void DataShareUvQueue::StsSyncCall(VoidFunc func, BoolFunc retFunc, WaitFunc waitFunc)
 {
+    auto start = steady_clock::now();
     auto *taskEntry = new (std::nothrow)TaskEntry {std::move(func), false, {}, {}, std::atomic<int>(1)};
     if (taskEntry == nullptr) {
         LOG_ERROR("invalid taskEntry.");
@@ -130,25 +135,60 @@ void DataShareUvQueue::StsSyncCall(VoidFunc func, BoolFunc retFunc)
             LOG_INFO("function ended successfully. times %{public}" PRIu64 ".", time);
         }
     }
-    CheckFuncAndExec(retFunc);
+    CheckFuncAndExec(retFunc, waitFunc, start);
     if (taskEntry->count.fetch_sub(1) == 1) {
         delete taskEntry;
         taskEntry = nullptr;
     }
 }
 
-void DataShareUvQueue::CheckFuncAndExec(BoolFunc retFunc)
+void DataShareUvQueue::CheckFuncAndExec(BoolFunc retFunc, WaitFunc waitFunc, steady_clock::time_point start)
 {
-    if (retFunc) {
+    if (!retFunc) {
+        return;
+    }
+    if (retFunc()) {
+        RecordLatency(SYNC_REPLY, start);
+        return;
+    }
+    bool isReplied = false;
+    if (waitFunc) {
+        // Waits for the reply notification with the same budget as the polling below.
+        waitFunc(milliseconds(SLEEP_TIME * TRY_TIMES));
+        isReplied = retFunc();
+    } else {
         int tryTimes = TRY_TIMES;
-        while (retFunc() != true && tryTimes > 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_TIME));
+        while (!isReplied && tryTimes > 0) {
+            std::this_thread::sleep_for(milliseconds(SLEEP_TIME));
             tryTimes--;
+            isReplied = retFunc();
         }
-        if (tryTimes <= 0) {
-            LOG_ERROR("function execute timeout.");
-        }
     }
+    if (!isReplied) {
+        LOG_ERROR("function execute timeout.");
+        return;
+    }
+    RecordLatency(ASYNC_REPLY, start);
+}
+
+void DataShareUvQueue::RecordLatency(ReplyType type, steady_clock::time_point start)
+{
+    int64_t latency = duration_cast<microseconds>(steady_clock::now() - start).count();
+    auto bucket = std::upper_bound(std::begin(LATENCY_BUCKETS_US), std::end(LATENCY_BUCKETS_US), latency) -
+        std::begin(LATENCY_BUCKETS_US);
+    latencyHistogram_[type][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> DataShareUvQueue::GetLatencyHistogram(ReplyType type)
+{
+    std::vector<uint64_t> histogram;
+    if (type < SYNC_REPLY || type >= REPLY_TYPE_BUTT) {
+        return histogram;
+    }
+    for (const auto &count : latencyHistogram_[type]) {
+        histogram.push_back(count.load(std::memory_order_relaxed));
+    }
+    return histogram;
 }
 } // namespace DataShare
 } // namespace OHOS
\ No newline at end of file
@@ -103,7 +103,7 @@ void SetAsyncResult(std::shared_ptr<ResultWrap> jsResult, napi_env env, Datashar
         if (proxy == nullptr) {
             if (UnwrapBatchUpdateResult(env, result, jsResult->updateResults_)) {
                 jsResult->callbackResultNumber_ = E_OK;
-                jsResult->isRecvReply_ = true;
+                jsResult->SetRecvReply();
                 return;
             }
             OHOS::AppExecFwk::UnwrapArrayStringFromJS(env, result, jsResult->callbackResultStringArr_);
@@ -113,7 +113,7 @@ void SetAsyncResult(std::shared_ptr<ResultWrap> jsResult, napi_env env, Datashar
         }
     }
     jsResult->businessError_= businessError;
-    jsResult->isRecvReply_ = true;
+    jsResult->SetRecvReply();
 }
 
 bool MakeNapiColumn(napi_env env, napi_value &napiColumns, const std::vector<std::string> &columns);
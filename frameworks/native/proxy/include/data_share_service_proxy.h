@@ -88,6 +88,12 @@ public:
     std::pair<int32_t, int32_t> DeleteEx(const Uri &uri, const Uri &extUri,
         const DataSharePredicates &predicate) override;
 
+    int32_t BatchInsert(const Uri &uri, const Uri &extUri, const std::vector<DataShareValuesBucket> &values,
+        std::vector<int32_t> &results) override;
+
+    int32_t ExecuteBatch(const Uri &extUri, const std::vector<OperationStatement> &statements,
+        ExecResultSet &result) override;
+
     static void SetSystem(bool isSystem);
 
     std::vector<DataProxyResult> PublishProxyData(
@@ -127,6 +133,8 @@ public:
 private:
     static inline BrokerDelegator<DataShareServiceProxy> delegator_;
 
+    static constexpr size_t MTU_SIZE = 921600; // 900k
+
     uint32_t CastIPCCode(DistributedShare::DataShare::DataShareServiceInterfaceCode code);
 };
 } // namespace OHOS::DataShare
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RDB_CHANGE_DISPATCHER_H
+#define RDB_CHANGE_DISPATCHER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "datashare_template.h"
+#include "executor_pool.h"
+
+namespace OHOS {
+namespace DataShare {
+/**
+ * @brief Delivers the rdb changes sent by the service to the observers on a worker thread, in arrival order.
+ *
+ * The binder thread only queues the change, so a slow observer can not hold it. The queue is bounded, how it
+ * behaves when changes arrive faster than the observers take them is decided by the policy.
+ */
+class RdbChangeDispatcher {
+public:
+    enum Policy : int32_t {
+        // A change replaces the pending change of the same uri and template, the oldest change is dropped when
+        // the queue is full.
+        COALESCE = 0,
+        // Every change is delivered, the oldest change is dropped when the queue is full.
+        DROP_OLDEST,
+        // Every change is delivered, the sender waits while the queue is full.
+        BLOCK,
+        POLICY_BUTT
+    };
+
+    struct Statistics {
+        size_t depth = 0;
+        size_t maxDepth = 0;
+        uint64_t delivered = 0;
+        uint64_t coalesced = 0;
+        uint64_t dropped = 0;
+    };
+
+    using Deliver = std::function<void(const RdbChangeNode &changeNode)>;
+
+    explicit RdbChangeDispatcher(Deliver deliver, Policy policy = COALESCE, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Changes the policy and the capacity of the queue, the changes already queued are kept.
+     *
+     * @return E_OK on success, E_ERROR when the policy or the capacity is invalid.
+     */
+    int32_t SetPolicy(Policy policy, size_t capacity);
+
+    void Post(const RdbChangeNode &changeNode);
+
+    Statistics GetStatistics();
+
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+private:
+    using Key = std::pair<std::string, TemplateId>;
+
+    struct Event {
+        Key key;
+        RdbChangeNode changeNode;
+    };
+
+    static constexpr size_t MAX_THREADS = 1;
+    static constexpr size_t MIN_THREADS = 0;
+
+    void Drain();
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    Deliver deliver_;
+    Policy policy_;
+    size_t capacity_;
+    bool draining_ = false;
+    std::list<Event> queue_;
+    // The queued change of every key, only used by COALESCE
+    std::map<Key, std::list<Event>::iterator> pending_;
+    Statistics statistics_;
+    // Destroyed first, so a running drain finishes before the queue goes away
+    std::shared_ptr<ExecutorPool> pool_;
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // RDB_CHANGE_DISPATCHER_H
@@ -26,6 +26,7 @@
 #include "idatashare.h"
 #include "iremote_stub.h"
 #include "data_share_service_proxy.h"
+#include "rdb_change_dispatcher.h"
 
 namespace OHOS {
 namespace DataShare {
@@ -92,13 +93,17 @@ public:
         const std::vector<std::string> &uris, const TemplateId &templateId);
     void RecoverObservers(std::shared_ptr<DataShareServiceProxy> proxy);
     void Emit(const RdbChangeNode &changeNode);
+    int32_t SetDispatchPolicy(RdbChangeDispatcher::Policy policy, size_t capacity);
+    RdbChangeDispatcher::Statistics GetDispatchStatistics();
 
 private:
+    void Dispatch(const RdbChangeNode &changeNode);
     void Emit(const std::vector<Key> &keys, const std::shared_ptr<Observer> &observer);
     void EmitOnEnable(std::map<Key, std::vector<ObserverNodeOnEnabled>> &obsMap);
     RdbSubscriberManager();
     sptr<RdbObserverStub> serviceCallback_;
     ConcurrentMap<Key, RdbChangeNode> lastChangeNodeMap_;
+    RdbChangeDispatcher dispatcher_;
 };
 } // namespace DataShare
 } // namespace OHOS
@@ -197,6 +197,70 @@ std::pair<int32_t, int32_t> DataShareServiceProxy::DeleteEx(const Uri &uri, cons
     return std::make_pair(errCode, result);
 }
 
+int32_t DataShareServiceProxy::BatchInsert(const Uri &uri, const Uri &extUri,
+    const std::vector<DataShareValuesBucket> &values, std::vector<int32_t> &results)
+{
+    const std::string &uriStr = uri.ToString();
+    MessageParcel data;
+    data.SetMaxCapacity(MTU_SIZE);
+    if (!data.WriteInterfaceToken(IDataShareService::GetDescriptor())) {
+        LOG_ERROR("Write descriptor failed!");
+        return E_WRITE_TO_PARCE_ERROR;
+    }
+    // the rows are written as raw data, which is carried by ashmem instead of the parcel once it is large
+    if (!ITypesUtil::Marshal(data, uriStr, extUri.ToString()) || !ITypesUtil::MarshalValuesBucketVec(values, data)) {
+        LOG_ERROR("Write to message parcel failed!");
+        return E_MARSHAL_ERROR;
+    }
+
+    int32_t errCode = -1;
+    MessageParcel reply;
+    MessageOption option;
+    int32_t err = Remote()->SendRequest(
+        CastIPCCode(InterfaceCode::DATA_SHARE_SERVICE_CMD_BATCH_INSERT), data, reply, option);
+    if (err != NO_ERROR) {
+        LOG_ERROR("BatchInsert fail to sendRequest. uri: %{public}s, size: %{public}zu, err: %{public}d",
+            DataShareStringUtils::Anonymous(uriStr).c_str(), values.size(), err);
+        return DATA_SHARE_ERROR;
+    }
+    if (!ITypesUtil::Unmarshal(reply, errCode, results)) {
+        LOG_ERROR("fail to Unmarshal");
+        return E_UNMARSHAL_ERROR;
+    }
+    return errCode;
+}
+
+int32_t DataShareServiceProxy::ExecuteBatch(const Uri &extUri, const std::vector<OperationStatement> &statements,
+    ExecResultSet &result)
+{
+    MessageParcel data;
+    data.SetMaxCapacity(MTU_SIZE);
+    if (!data.WriteInterfaceToken(IDataShareService::GetDescriptor())) {
+        LOG_ERROR("Write descriptor failed!");
+        return E_WRITE_TO_PARCE_ERROR;
+    }
+    if (!ITypesUtil::Marshal(data, extUri.ToString()) ||
+        !ITypesUtil::MarshalOperationStatementVec(statements, data)) {
+        LOG_ERROR("Write to message parcel failed!");
+        return E_MARSHAL_ERROR;
+    }
+
+    int32_t errCode = -1;
+    MessageParcel reply;
+    MessageOption option;
+    int32_t err = Remote()->SendRequest(
+        CastIPCCode(InterfaceCode::DATA_SHARE_SERVICE_CMD_EXECUTE_BATCH), data, reply, option);
+    if (err != NO_ERROR) {
+        LOG_ERROR("ExecuteBatch fail to sendRequest. size: %{public}zu, err: %{public}d", statements.size(), err);
+        return DATA_SHARE_ERROR;
+    }
+    if (!ITypesUtil::Unmarshal(reply, errCode, result)) {
+        LOG_ERROR("fail to Unmarshal");
+        return E_UNMARSHAL_ERROR;
+    }
+    return errCode;
+}
+
 std::shared_ptr<DataShareResultSet> DataShareServiceProxy::Query(const Uri &uri, const Uri &extUri,
     const DataSharePredicates &predicates, std::vector<std::string> &columns, DatashareBusinessError &businessError)
 {
@@ -223,6 +223,8 @@ void PublishedDataSubscriberManager::RecoverObservers(std::shared_ptr<DataShareS
 
 void PublishedDataSubscriberManager::Emit(PublishedDataChangeNode &changeNode)
 {
+    // Observers and the stored last change share the slices of one arena instead of copying every blob.
+    changeNode.PackBlobs();
     std::map<std::shared_ptr<Observer>, PublishedDataChangeNode> results;
     for (auto &data : changeNode.datas_) {
         PublishedObserverMapKey key(data.key_, data.subscriberId_);
@@ -231,7 +233,7 @@ void PublishedDataSubscriberManager::Emit(PublishedDataChangeNode &changeNode)
         auto callbacks = BaseCallbacks::GetEnabledObservers(key);
         lastChangeNodeMap_.Compute(key, [&data, &changeNode](const Key &, PublishedDataChangeNode &value) {
             value.datas_.clear();
-            value.datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+            value.datas_.emplace_back(data.Clone());
             value.ownerBundleName_ = changeNode.ownerBundleName_;
             return true;
         });
@@ -242,7 +244,7 @@ void PublishedDataSubscriberManager::Emit(PublishedDataChangeNode &changeNode)
             continue;
         }
         for (auto const &obs : callbacks) {
-            results[obs].datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+            results[obs].datas_.emplace_back(data.Clone());
         }
     }
     for (auto &[callback, node] : results) {
@@ -257,7 +259,7 @@ void PublishedDataSubscriberManager::Emit(const std::vector<Key> &keys, const st
     for (auto &key : keys) {
         lastChangeNodeMap_.ComputeIfPresent(key, [&node](const Key &, PublishedDataChangeNode &value) {
             for (auto &data : value.datas_) {
-                node.datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+                node.datas_.emplace_back(data.Clone());
             }
             node.ownerBundleName_ = value.ownerBundleName_;
             return true;
@@ -278,7 +280,7 @@ void PublishedDataSubscriberManager::EmitOnEnable(std::map<Key, std::vector<Obse
                 for (auto &obs : obsVector) {
                     if (obs.isNotifyOnEnabled_) {
                         num++;
-                        results[obs.observer_].datas_.emplace_back(data.key_, data.subscriberId_, data.GetData());
+                        results[obs.observer_].datas_.emplace_back(data.Clone());
                         results[obs.observer_].ownerBundleName_ = value.ownerBundleName_;
                     }
                 }
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "rdb_change_dispatcher"
+
+#include "rdb_change_dispatcher.h"
+
+#include <algorithm>
+
+#include "datashare_errno.h"
+#include "datashare_log.h"
+#include "datashare_string_utils.h"
+
+namespace OHOS {
+namespace DataShare {
+RdbChangeDispatcher::RdbChangeDispatcher(Deliver deliver, Policy policy, size_t capacity)
+    : deliver_(std::move(deliver)), policy_(policy), capacity_(std::max<size_t>(capacity, 1)),
+      pool_(std::make_shared<ExecutorPool>(MAX_THREADS, MIN_THREADS, "RdbChangeDispatch"))
+{
+}
+
+int32_t RdbChangeDispatcher::SetPolicy(Policy policy, size_t capacity)
+{
+    if (policy < COALESCE || policy >= POLICY_BUTT || capacity == 0) {
+        LOG_ERROR("Invalid policy %{public}d or capacity %{public}zu", policy, capacity);
+        return E_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
+    capacity_ = capacity;
+    if (policy_ != COALESCE) {
+        pending_.clear();
+    }
+    cond_.notify_all();
+    return E_OK;
+}
+
+void RdbChangeDispatcher::Post(const RdbChangeNode &changeNode)
+{
+    Key key(changeNode.uri_, changeNode.templateId_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (policy_ == COALESCE) {
+        auto it = pending_.find(key);
+        if (it != pending_.end()) {
+            it->second->changeNode = changeNode;
+            statistics_.coalesced++;
+            return;
+        }
+    }
+    if (policy_ == BLOCK) {
+        cond_.wait(lock, [this] { return queue_.size() < capacity_ || policy_ != BLOCK; });
+    }
+    while (queue_.size() >= capacity_) {
+        auto it = pending_.find(queue_.front().key);
+        if (it != pending_.end() && it->second == queue_.begin()) {
+            pending_.erase(it);
+        }
+        LOG_WARN("Queue is full, drop the change of %{public}s",
+            DataShareStringUtils::Anonymous(queue_.front().key.first).c_str());
+        queue_.pop_front();
+        statistics_.dropped++;
+    }
+    auto it = queue_.insert(queue_.end(), Event { key, changeNode });
+    if (policy_ == COALESCE) {
+        pending_[key] = it;
+    }
+    statistics_.maxDepth = std::max(statistics_.maxDepth, queue_.size());
+    if (draining_) {
+        return;
+    }
+    draining_ = true;
+    if (pool_->Execute([this]() { Drain(); }) == ExecutorPool::INVALID_TASK_ID) {
+        // no worker, deliver on the calling thread as before
+        LOG_WARN("Execute drain failed, deliver directly");
+        lock.unlock();
+        Drain();
+    }
+}
+
+void RdbChangeDispatcher::Drain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!queue_.empty()) {
+        auto it = pending_.find(queue_.front().key);
+        if (it != pending_.end() && it->second == queue_.begin()) {
+            pending_.erase(it);
+        }
+        Event event = std::move(queue_.front());
+        queue_.pop_front();
+        cond_.notify_all();
+        lock.unlock();
+        deliver_(event.changeNode);
+        lock.lock();
+        statistics_.delivered++;
+    }
+    draining_ = false;
+}
+
+RdbChangeDispatcher::Statistics RdbChangeDispatcher::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statistics statistics = statistics_;
+    statistics.depth = queue_.size();
+    return statistics;
+}
+} // namespace DataShare
+} // namespace OHOS
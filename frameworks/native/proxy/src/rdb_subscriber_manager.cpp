@@ -32,6 +32,7 @@ RdbSubscriberManager &RdbSubscriberManager::GetInstance()
 }
 
 RdbSubscriberManager::RdbSubscriberManager()
+    : dispatcher_([this](const RdbChangeNode &changeNode) { Dispatch(changeNode); })
 {
     serviceCallback_ = new (std::nothrow)RdbObserverStub([this](const RdbChangeNode &changeNode) {
         Emit(changeNode);
@@ -120,10 +121,14 @@ std::vector<OperationResult> RdbSubscriberManager::DelObservers(void *subscriber
     }
     return BaseCallbacks::DelObservers(subscriber,
         [&proxy, this](const std::vector<Key> &lastDelKeys, std::vector<OperationResult> &opResult) {
-            // delete all obs by subscriber
+            // delete all obs by subscriber, one request carries all uris of a template
+            std::map<TemplateId, std::vector<std::string>> keysMap;
             for (const auto &key : lastDelKeys) {
                 lastChangeNodeMap_.Erase(key);
-                auto unsubResult = proxy->UnSubscribeRdbData(std::vector<std::string>(1, key.uri_), key.templateId_);
+                keysMap[key.templateId_].emplace_back(key.uri_);
+            }
+            for (const auto &[templateId, uris] : keysMap) {
+                auto unsubResult = proxy->UnSubscribeRdbData(uris, templateId);
                 opResult.insert(opResult.end(), unsubResult.begin(), unsubResult.end());
             }
         });
@@ -239,19 +244,38 @@ void RdbSubscriberManager::RecoverObservers(std::shared_ptr<DataShareServiceProx
 }
 
 void RdbSubscriberManager::Emit(const RdbChangeNode &changeNode)
+{
+    // the observers run on the dispatcher, not on the binder thread of the service
+    dispatcher_.Post(changeNode);
+}
+
+void RdbSubscriberManager::Dispatch(const RdbChangeNode &changeNode)
 {
     RdbObserverMapKey key(changeNode.uri_, changeNode.templateId_);
+    // recorded on delivery, so enabling an observer does not replay a change that is still queued and would reach
+    // it again from here
     lastChangeNodeMap_.InsertOrAssign(key, changeNode);
     auto callbacks = BaseCallbacks::GetObserversAndSetNotifiedOn(key);
+    LOG_DEBUG("Client send data to form, uri is %{public}s, subscriberId is %{public}" PRId64
+        ", observers %{public}zu", DataShareStringUtils::Anonymous(key.uri_).c_str(),
+        key.templateId_.subscriberId_, callbacks.size());
     for (auto &obs : callbacks) {
         if (obs != nullptr) {
-            LOG_INFO("Client send data to form, uri is %{public}s, subscriberId is %{public}" PRId64,
-                DataShareStringUtils::Anonymous(key.uri_).c_str(), key.templateId_.subscriberId_);
             obs->OnChange(changeNode);
         }
     }
 }
 
+int32_t RdbSubscriberManager::SetDispatchPolicy(RdbChangeDispatcher::Policy policy, size_t capacity)
+{
+    return dispatcher_.SetPolicy(policy, capacity);
+}
+
+RdbChangeDispatcher::Statistics RdbSubscriberManager::GetDispatchStatistics()
+{
+    return dispatcher_.GetStatistics();
+}
+
 void RdbSubscriberManager::Emit(const std::vector<Key> &keys, const std::shared_ptr<Observer> &observer)
 {
     for (auto const &key : keys) {
@@ -47,8 +47,14 @@ pub enum SharedResultCode {
 }
 
 /// Total number of valid function codes (C++ FUNC_BUTT equivalent).
+///
+/// The C++ `FUNC_FILL_WINDOW` and `FUNC_FILL_WINDOWS` codes come after these and are rejected here with
+/// `IPC_STUB_UNKNOW_TRANS_ERR`, a C++ consumer then falls back to `FUNC_ON_GO`.
 const FUNC_BUTT: u32 = 4;
 
+/// C++ `IPC_STUB_UNKNOW_TRANS_ERR` from `ipc_types.h`, returned for codes the stub does not serve.
+const IPC_STUB_UNKNOW_TRANS_ERR: i32 = 305;
+
 /// Error codes matching C++ `datashare_errno.h`.
 pub(crate) const E_OK: i32 = 0;
 
@@ -162,7 +168,7 @@ impl RemoteStub for ISharedResultSetStub {
 
         // Validate command code range (C++ checks code >= FUNC_BUTT)
         if code >= FUNC_BUTT {
-            return -1;
+            return IPC_STUB_UNKNOW_TRANS_ERR;
         }
 
         let start = Instant::now();
@@ -234,7 +240,7 @@ mod tests {
         let stub = ISharedResultSetStub::new(DataShareResultSet::new());
         let mut data = prepare_request();
         let mut reply = MsgParcel::new();
-        assert_eq!(stub.on_remote_request(99, &mut data, &mut reply), -1);
+        assert_eq!(stub.on_remote_request(99, &mut data, &mut reply), IPC_STUB_UNKNOW_TRANS_ERR);
     }
 
     #[test]
@@ -45,6 +45,14 @@ pub const CELL_UNIT_TYPE_BLOB: i32 = 4;
 
 pub const COL_MAX_NUM: u32 = 32767;
 pub const ROW_OFFSETS_NUM: usize = 100;
+pub const INVALID_ROW_RECORD: u32 = 0xFFFF_FFFF;
+
+/// Row offsets held by one page of the row directory.
+pub const ROW_PAGE_SHIFT: u32 = 8;
+pub const ROW_PAGE_SIZE: u32 = 1 << ROW_PAGE_SHIFT;
+pub const ROW_PAGE_MASK: u32 = ROW_PAGE_SIZE - 1;
+/// Layout tag of blocks using the paged row directory.
+pub const LAYOUT_ROW_DIRECTORY: u32 = 0x5342_0002;
 
 // ---------------------------------------------------------------------------
 // Binary-compatible structs
@@ -60,8 +68,13 @@ pub struct SharedBlockHeader {
     pub start_pos: u32,
     pub last_pos: u32,
     pub block_pos: u32,
+    pub layout_version: u32,
+    pub row_dir_offset: u32,
+    pub row_dir_capacity: u32,
+    pub row_page_nums: u32,
 }
 
+/// Row group of the legacy layout, only used to read blocks from older writers.
 #[repr(C)]
 #[derive(Clone, Copy)]
 pub struct RowGroupHeader {
@@ -161,29 +174,11 @@ impl SharedBlock {
             return Err(SHARED_BLOCK_ASHMEM_ERROR);
         }
 
-        // Initialize header to a known-empty state (matches C++ CreateSharedBlock
-        // behaviour — the backing ashmem is zeroed by the kernel, so after Init
-        // we install default header values for the first row group too).
-        unsafe {
-            let header = block.header_ptr_mut();
-            (*header).unused_offset = std::mem::size_of::<SharedBlockHeader>() as u32
-                + std::mem::size_of::<RowGroupHeader>() as u32;
-            (*header).first_row_group_offset = std::mem::size_of::<SharedBlockHeader>() as u32;
-            (*header).row_nums = 0;
-            (*header).column_nums = 0;
-            (*header).start_pos = 0;
-            (*header).last_pos = 0;
-            (*header).block_pos = 0;
-
-            // First row group lives right after the header.
-            if let Some(first) = block.offset_to_ptr(
-                (*header).first_row_group_offset,
-                std::mem::size_of::<RowGroupHeader>() as u32,
-            ) {
-                let group = first as *mut RowGroupHeader;
-                std::ptr::write_bytes(group, 0, 1);
-                (*group).next_group_offset = 0;
-            }
+        // Initialize header to a known-empty state with an empty row directory,
+        // the backing ashmem is zeroed by the kernel.
+        let ret = block.clear();
+        if ret != SHARED_BLOCK_OK {
+            return Err(ret);
         }
 
         Ok(block)
@@ -275,23 +270,30 @@ impl SharedBlock {
         if self.read_only {
             return SHARED_BLOCK_INVALID_OPERATION;
         }
+        // Every row takes at least its row offset, which bounds the pages the
+        // row directory needs. Mirrors C++ `SharedBlock::Clear`.
+        let header_size = std::mem::size_of::<SharedBlockHeader>();
+        let max_rows = self.size.saturating_sub(header_size) / std::mem::size_of::<u32>();
+        let dir_capacity = ((max_rows + ROW_PAGE_MASK as usize) >> ROW_PAGE_SHIFT) as u32;
+        let dir_size = dir_capacity * std::mem::size_of::<u32>() as u32;
+        if dir_capacity == 0 || self.offset_to_ptr(header_size as u32, dir_size).is_none() {
+            return SHARED_BLOCK_BAD_VALUE;
+        }
         let header = self.header_ptr_mut();
         unsafe {
-            (*header).unused_offset = std::mem::size_of::<SharedBlockHeader>() as u32
-                + std::mem::size_of::<RowGroupHeader>() as u32;
-            (*header).first_row_group_offset = std::mem::size_of::<SharedBlockHeader>() as u32;
+            (*header).unused_offset = header_size as u32 + dir_size;
+            // Readers of the legacy layout fail to find the first row group
+            // instead of misreading the block.
+            (*header).first_row_group_offset = INVALID_ROW_RECORD;
             (*header).row_nums = 0;
             (*header).column_nums = 0;
             (*header).start_pos = 0;
             (*header).last_pos = 0;
             (*header).block_pos = 0;
-            let first_off = (*header).first_row_group_offset;
-            let group_size = std::mem::size_of::<RowGroupHeader>() as u32;
-            let group_ptr = match self.offset_to_ptr(first_off, group_size) {
-                Some(p) => p as *mut RowGroupHeader,
-                None => return SHARED_BLOCK_BAD_VALUE,
-            };
-            std::ptr::addr_of_mut!((*group_ptr).next_group_offset).write_unaligned(0);
+            (*header).layout_version = LAYOUT_ROW_DIRECTORY;
+            (*header).row_dir_offset = header_size as u32;
+            (*header).row_dir_capacity = dir_capacity;
+            (*header).row_page_nums = 0;
         }
         SHARED_BLOCK_OK
     }
@@ -649,7 +651,56 @@ impl SharedBlock {
         }
     }
 
+    #[inline]
+    fn is_row_directory_layout(&self) -> bool {
+        unsafe { (*self.header_ptr()).layout_version == LAYOUT_ROW_DIRECTORY }
+    }
+
+    /// Returns a pointer to the row directory holding at least `pages` entries.
+    fn row_dir(&self, pages: u32) -> *mut u32 {
+        let dir_off = unsafe { (*self.header_ptr()).row_dir_offset };
+        match self.offset_to_ptr(dir_off, pages * std::mem::size_of::<u32>() as u32) {
+            Some(p) => p as *mut u32,
+            None => std::ptr::null_mut(),
+        }
+    }
+
+    /// Returns a pointer to the row page at offset `page_off`.
+    fn row_page(&self, page_off: u32) -> *mut u32 {
+        match self.offset_to_ptr(page_off, ROW_PAGE_SIZE * std::mem::size_of::<u32>() as u32) {
+            Some(p) => p as *mut u32,
+            None => std::ptr::null_mut(),
+        }
+    }
+
     fn get_row_offset(&self, row: u32) -> *mut u32 {
+        if !self.is_row_directory_layout() {
+            return self.get_legacy_row_offset(row);
+        }
+        let page = row >> ROW_PAGE_SHIFT;
+        let (page_nums, dir_capacity) = unsafe {
+            (
+                (*self.header_ptr()).row_page_nums,
+                (*self.header_ptr()).row_dir_capacity,
+            )
+        };
+        if page >= page_nums || page_nums > dir_capacity {
+            return std::ptr::null_mut();
+        }
+        let dir = self.row_dir(page + 1);
+        if dir.is_null() {
+            return std::ptr::null_mut();
+        }
+        // SAFETY: `row_dir` validated `page + 1` entries are inside the mmap.
+        let page_ptr = self.row_page(unsafe { dir.add(page as usize).read_unaligned() });
+        if page_ptr.is_null() {
+            return std::ptr::null_mut();
+        }
+        // SAFETY: `row_page` validated the whole page is inside the mmap.
+        unsafe { page_ptr.add((row & ROW_PAGE_MASK) as usize) }
+    }
+
+    fn get_legacy_row_offset(&self, row: u32) -> *mut u32 {
         let mut row_pos = row;
         let group_size = std::mem::size_of::<RowGroupHeader>() as u32;
         let first_off = unsafe { (*self.header_ptr()).first_row_group_offset };
@@ -669,45 +720,44 @@ impl SharedBlock {
     }
 
     fn alloc_row_offset(&mut self) -> *mut u32 {
-        let mut row_pos = unsafe { (*self.header_ptr()).row_nums };
-        let group_size = std::mem::size_of::<RowGroupHeader>() as u32;
-        let first_off = unsafe { (*self.header_ptr()).first_row_group_offset };
-        let mut group_ptr = match self.offset_to_ptr(first_off, group_size) {
-            Some(p) => p as *mut RowGroupHeader,
-            None => return std::ptr::null_mut(),
-        };
-        while row_pos > ROW_OFFSETS_NUM as u32 {
-            let next = unsafe { (*group_ptr).next_group_offset };
-            group_ptr = match self.offset_to_ptr(next, group_size) {
-                Some(p) => p as *mut RowGroupHeader,
-                None => return std::ptr::null_mut(),
-            };
-            row_pos -= ROW_OFFSETS_NUM as u32;
+        // Rows can only be allocated after `clear`.
+        if !self.is_row_directory_layout() {
+            return std::ptr::null_mut();
         }
-        if row_pos == ROW_OFFSETS_NUM as u32 {
-            let next_existing = unsafe { (*group_ptr).next_group_offset };
-            if next_existing == 0 {
-                let new_off = self.alloc(std::mem::size_of::<RowGroupHeader>(), true);
-                if new_off == 0 {
-                    return std::ptr::null_mut();
-                }
-                unsafe {
-                    (*group_ptr).next_group_offset = new_off;
-                }
+        let (row, dir_capacity, page_nums) = unsafe {
+            (
+                (*self.header_ptr()).row_nums,
+                (*self.header_ptr()).row_dir_capacity,
+                (*self.header_ptr()).row_page_nums,
+            )
+        };
+        let page = row >> ROW_PAGE_SHIFT;
+        if page >= dir_capacity {
+            return std::ptr::null_mut();
+        }
+        if self.row_dir(page + 1).is_null() {
+            return std::ptr::null_mut();
+        }
+        // Pages freed by `free_last_row` are kept in the directory and reused.
+        if page >= page_nums {
+            let new_off = self.alloc(ROW_PAGE_SIZE as usize * std::mem::size_of::<u32>(), true);
+            if new_off == 0 {
+                return std::ptr::null_mut();
             }
-            let next_off = unsafe { (*group_ptr).next_group_offset };
-            group_ptr = match self.offset_to_ptr(next_off, group_size) {
-                Some(p) => p as *mut RowGroupHeader,
-                None => return std::ptr::null_mut(),
-            };
+            let dir = self.row_dir(page + 1);
             unsafe {
-                (*group_ptr).next_group_offset = 0;
+                dir.add(page as usize).write_unaligned(new_off);
+                (*self.header_ptr_mut()).row_page_nums = page + 1;
             }
-            row_pos = 0;
+        }
+        let dir = self.row_dir(page + 1);
+        let page_ptr = self.row_page(unsafe { dir.add(page as usize).read_unaligned() });
+        if page_ptr.is_null() {
+            return std::ptr::null_mut();
         }
         unsafe {
             (*self.header_ptr_mut()).row_nums += 1;
-            &mut (*group_ptr).row_offsets[row_pos as usize] as *mut u32
+            page_ptr.add((row & ROW_PAGE_MASK) as usize)
         }
     }
 
@@ -869,7 +919,7 @@ mod tests {
 
     #[test]
     fn struct_sizes_match_cpp() {
-        assert_eq!(std::mem::size_of::<SharedBlockHeader>(), 28);
+        assert_eq!(std::mem::size_of::<SharedBlockHeader>(), 44);
         assert_eq!(std::mem::size_of::<RowGroupHeader>(), 404);
         assert_eq!(std::mem::size_of::<CellUnit>(), 12);
     }
@@ -900,4 +950,23 @@ mod tests {
         let v = unsafe { cell.value.long_value };
         assert_eq!(v, 42);
     }
+
+    #[test]
+    fn rows_span_row_pages() {
+        let mut block = match SharedBlock::create("x", 1024 * 1024) {
+            Ok(b) => b,
+            Err(_) => return, // environment may not support ashmem in unit tests
+        };
+        assert_eq!(block.set_column_num(1), SHARED_BLOCK_OK);
+        let rows = ROW_PAGE_SIZE * 3 + 1;
+        for row in 0..rows {
+            assert_eq!(block.alloc_row(), SHARED_BLOCK_OK);
+            assert_eq!(block.put_long(row, 0, row as i64), SHARED_BLOCK_OK);
+        }
+        for row in 0..rows {
+            let cell = unsafe { std::ptr::read_unaligned(block.get_cell_unit(row, 0)) };
+            assert_eq!(unsafe { cell.value.long_value }, row as i64);
+        }
+        assert!(block.get_cell_unit(rows, 0).is_null());
+    }
 }
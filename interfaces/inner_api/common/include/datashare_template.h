@@ -17,9 +17,11 @@
 #define DATASHARE_TEMPLATE_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <variant>
 #include <vector>
+#include "ashmem.h"
 #include "iremote_object.h"
 
 namespace OHOS {
@@ -110,9 +112,50 @@ struct CreateOptions {
     int waitTime_ = DEFAULT_WAITTIME;
 };
 
+struct PublishedDataItem;
+
+/**
+ * One shared memory holding the blobs of several published data items, each item refers to a slice of it.
+ * The memory is unmapped and closed when the last item referring to it is released.
+ */
+class PublishedDataArena {
+public:
+    /** A slice of the arena, offset and size in bytes. */
+    struct Slice {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    explicit PublishedDataArena(sptr<Ashmem> ashmem);
+    ~PublishedDataArena();
+    PublishedDataArena(const PublishedDataArena &) = delete;
+    PublishedDataArena &operator=(const PublishedDataArena &) = delete;
+
+    /**
+     * Copies the blobs of the items into one new arena, slices has one entry per item, empty for string items.
+     */
+    static std::shared_ptr<PublishedDataArena> Pack(const std::vector<PublishedDataItem> &datas,
+        std::vector<Slice> &slices);
+
+    sptr<Ashmem> GetAshmem() const;
+    const uint8_t *Read(const Slice &slice) const;
+
+private:
+    sptr<Ashmem> ashmem_;
+};
+
+/** A read only view of a blob, valid while the item it comes from is alive. */
+struct BlobSpan {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+};
+
 struct AshmemNode {
     sptr<Ashmem> ashmem;
     bool isManaged;
+    /** Set when the blob is a slice of a shared arena, ashmem is null then. */
+    std::shared_ptr<PublishedDataArena> arena = nullptr;
+    PublishedDataArena::Slice slice;
 };
 
 /**
@@ -131,14 +174,22 @@ struct PublishedDataItem {
     PublishedDataItem &operator=(const PublishedDataItem &) = delete;
     virtual ~PublishedDataItem();
     PublishedDataItem(const std::string &key, int64_t subscriberId, DataType value);
+    PublishedDataItem(const std::string &key, int64_t subscriberId, std::shared_ptr<PublishedDataArena> arena,
+        PublishedDataArena::Slice slice);
     PublishedDataItem(PublishedDataItem &&item);
     PublishedDataItem &operator=(PublishedDataItem &&item);
     bool IsAshmem() const;
     bool IsString() const;
+    /** Whether the blob is a slice of a shared arena, such an item can not move out its ashmem. */
+    bool IsArena() const;
     sptr<Ashmem> MoveOutAshmem();
     void SetAshmem(sptr<Ashmem> ashmem, bool isManaged = false);
     void Set(DataType &value);
     DataType GetData() const;
+    /** Gets the blob without copying it, the span is empty for string items. */
+    BlobSpan GetBlobSpan() const;
+    /** Copies the item, a slice of an arena is shared instead of copied. */
+    PublishedDataItem Clone() const;
 
 private:
     void Clear();
@@ -160,6 +211,12 @@ struct PublishedDataChangeNode {
     std::string ownerBundleName_;
     /** Specifies the datas of the callback. */
     std::vector<PublishedDataItem> datas_;
+
+    /**
+     * Moves the blobs of all items into one shared arena, so the node is sent with one shared memory instead of
+     * one per blob. Returns false and keeps the items unchanged on failure.
+     */
+    bool PackBlobs();
 };
 
 /**
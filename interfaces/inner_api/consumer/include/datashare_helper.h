@@ -16,6 +16,7 @@
 #ifndef DATASHARE_HELPER_H
 #define DATASHARE_HELPER_H
 
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -97,6 +98,32 @@ public:
     static std::pair<int, std::shared_ptr<DataShareHelper>> Create(const sptr<IRemoteObject> &token,
         const std::string &strUri, const std::string &extUri, const int waitTime = 2);
 
+    /**
+     * @brief Creates a DataShareHelper instance like Create, without blocking the calling thread.
+     *
+     * @param token Indicates the System token.
+     * @param strUri Indicates the database table or disk file to operate for silent access.
+     * @param extUri Indicates the database table or disk file to operate for non silent access.
+     * @param callback Called on a worker thread with the result of Create.
+     * @param waitTime connect extension waiting time.
+     *
+     * @return Returns E_OK if the creation is started, the callback is not called otherwise.
+     */
+    static int CreateAsync(const sptr<IRemoteObject> &token, const std::string &strUri, const std::string &extUri,
+        std::function<void(int, std::shared_ptr<DataShareHelper>)> callback, const int waitTime = 2);
+
+    /**
+     * @brief Connects the extension of the provider in the background, so that the helpers created for it in a
+     * while do not have to wait for the connection. The connection is released when no helper uses it for a while.
+     *
+     * @param token Indicates the System token.
+     * @param strUri Indicates the extension uri of the provider.
+     * @param waitTime connect extension waiting time.
+     *
+     * @return Returns E_OK if the connection is started.
+     */
+    static int Prewarm(const sptr<IRemoteObject> &token, const std::string &strUri, const int waitTime = 2);
+
     /**
      * @brief Releases the client resource of the Data share.
      * You should call this method to releases client resource after the data operations are complete.
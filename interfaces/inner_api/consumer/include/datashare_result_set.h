@@ -16,9 +16,14 @@
 #ifndef DATASHARE_RESULT_SET_H
 #define DATASHARE_RESULT_SET_H
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -37,6 +42,82 @@ class DataShareBlockWriterImpl;
  */
 class DataShareResultSet : public DataShareAbsResultSet, public DataShareSharedResultSet {
 public:
+    /**
+     * Options of the background window prefetch.
+     */
+    struct PrefetchOption {
+        // Number of windows filled ahead of the one being read, 0 turns the prefetch off.
+        uint32_t depth = 1;
+        // Rows kept before the target row when a window has to be refilled for a backward or random move.
+        uint32_t backwardRows = 0;
+    };
+
+    /**
+     * Counters of the background window prefetch.
+     */
+    struct PrefetchStatistics {
+        // Window moves served by a prefetched window.
+        uint64_t hits = 0;
+        // Window moves that had to fill a window synchronously.
+        uint64_t misses = 0;
+        // Total time GoToRow was blocked on moving the window, in microseconds.
+        uint64_t stallTimeUs = 0;
+    };
+
+    /**
+     * Bounds of the adaptive window, see EnableAdaptiveWindow.
+     */
+    struct AdaptiveWindowOption {
+        // Bounds of the block a window is filled into, in bytes.
+        size_t minBlockSize = 256 * 1024;
+        size_t maxBlockSize = 5 * 1024 * 1024;
+        // Bounds of the rows a window is sized for.
+        uint32_t minRows = 256;
+        uint32_t maxRows = 8192;
+    };
+
+    /**
+     * Counters of the adaptive window.
+     */
+    struct AdaptiveWindowStatistics {
+        // Windows filled since the adaptive window was enabled.
+        uint64_t refills = 0;
+        // Rows filled into those windows.
+        uint64_t rows = 0;
+        // Average bytes a row takes in a block, weighted towards the latest windows.
+        size_t rowBytes = 0;
+        // Size of the block of the current window, and of the largest one.
+        size_t blockSize = 0;
+        size_t peakBlockSize = 0;
+    };
+
+    /**
+     * Demand of a streaming cursor, see EnableStreaming.
+     */
+    struct StreamOption {
+        // Rows a window the cursor moves onto is filled with at most, 0 fills the window until its block is full.
+        uint32_t pageRows = 0;
+        // Rows the consumer reads at most, like a LIMIT, 0 for all rows.
+        uint32_t rowBudget = 0;
+    };
+
+    /**
+     * Values of one column fetched by GetRows, one entry per row in the type the column is requested in.
+     */
+    struct ColumnBuffer {
+        // The zero-based index of the column to fetch.
+        int columnIndex = 0;
+        // TYPE_INTEGER fills longs, TYPE_FLOAT fills doubles, TYPE_STRING and TYPE_BLOB fill offsets and arena.
+        DataType type = DataType::TYPE_STRING;
+        std::vector<int64_t> longs;
+        std::vector<double> doubles;
+        // The value of row i is arena[offsets[i], offsets[i + 1]), strings are kept without the terminating null.
+        std::vector<uint32_t> offsets;
+        std::vector<uint8_t> arena;
+        // 1 for the rows whose cell is null.
+        std::vector<uint8_t> nulls;
+    };
+
     DataShareResultSet();
     explicit DataShareResultSet(std::shared_ptr<ResultSetBridge> &bridge, size_t blockSize = DEFAULT_SHARE_BLOCK_SIZE);
     virtual ~DataShareResultSet();
@@ -61,6 +142,40 @@ public:
      */
     int GetString(int columnIndex, std::string &value) override;
 
+    /**
+     * @brief Get the string of the column without copying it out of the block.
+     *
+     * @param columnIndex the zero-based index of the target column.
+     * @param value Indicates the view of the string, valid until the cursor moves or is closed.
+     *
+     * @return Return E_OK for a string or null column, E_INVALID_OBJECT_TYPE for a column of other type.
+     */
+    int GetStringView(int columnIndex, std::string_view &value);
+
+    /**
+     * @brief Get the blob of the column without copying it out of the block.
+     *
+     * @param columnIndex the zero-based index of the target column.
+     * @param value Indicates the first byte of the blob, valid until the cursor moves or is closed.
+     * @param size Indicates the size of the blob.
+     *
+     * @return Return E_OK if the blob is got, value is null for a column without blob or string.
+     */
+    int GetBlobSpan(int columnIndex, const uint8_t *&value, size_t &size);
+
+    /**
+     * @brief Copy rowCount rows from startRow for the given columns in one pass over each block.
+     *
+     * @param startRow the zero-based position of the first row to fetch.
+     * @param rowCount the number of rows to fetch, fewer are fetched at the end of the result set.
+     * @param columns Indicates the columns to fetch, their buffers are cleared and refilled.
+     * @param fetchedRows Indicates the number of rows fetched.
+     *
+     * @return Return E_OK if the rows are fetched, the cursor is left on the last fetched row. On failure only the
+     * first fetchedRows rows of the buffers are complete.
+     */
+    int GetRows(int startRow, int rowCount, std::vector<ColumnBuffer> &columns, int &fetchedRows);
+
     /**
      * @brief Get the data whose value type is int from the database according to the columnIndex.
      *
@@ -164,6 +279,58 @@ public:
 
     std::shared_ptr<ResultSetBridge> GetBridge();
 
+    /**
+     * @brief Fills the windows following the current one in the background while the current one is read.
+     *
+     * @param option Indicates the prefetch depth and the backward-scroll window.
+     *
+     * @return Return E_OK if the option is accepted.
+     */
+    int EnablePrefetch(const PrefetchOption &option);
+
+    /**
+     * @return Return the prefetch counters since the prefetch was enabled.
+     */
+    PrefetchStatistics GetPrefetchStatistics();
+
+    /**
+     * @brief Sizes each window from the average row width and the scroll pattern seen so far, instead of refilling
+     * the block the result set was created with.
+     *
+     * A random move fills a window sized for minRows rows, each move onto the row right after the window doubles the
+     * rows of the next window up to maxRows. The adaptive window does not work together with the prefetch.
+     *
+     * @param option Indicates the bounds of the window.
+     *
+     * @return Return E_OK if the option is accepted.
+     */
+    int EnableAdaptiveWindow(const AdaptiveWindowOption &option);
+
+    /**
+     * @return Return the adaptive window counters since the adaptive window was enabled.
+     */
+    AdaptiveWindowStatistics GetAdaptiveWindowStatistics();
+
+    /**
+     * @brief Lets the cursor move without the row count and fills the windows only up to the consumer's demand.
+     *
+     * The cursor ends at the first row the provider fills no row for, or at the row budget, so a scan never has the
+     * provider count its rows. GetRowCount returns the count once the cursor reached the end, before that it asks the
+     * provider and caps the count by the row budget.
+     *
+     * @param option Indicates the demand of the cursor.
+     *
+     * @return Return E_OK if the option is accepted.
+     */
+    int EnableStreaming(const StreamOption &option);
+
+    /**
+     * @brief Lets GetStringView and GetBlobSpan read the block without locking.
+     *
+     * @param singleThreaded Indicates that one thread moves and reads the cursor, the prefetch may still run.
+     */
+    void SetSingleThreaded(bool singleThreaded);
+
     static bool Marshal(const std::shared_ptr<DataShareResultSet> resultSet, MessageParcel &parcel);
 
     static std::shared_ptr<DataShareResultSet> Unmarshal(MessageParcel &parcel);
@@ -173,14 +340,83 @@ protected:
     void ClosedBlockAndBridge();
     virtual void Finalize();
 
+    /**
+     * Fills the given block with the rows from startRowIndex, endRowIndex receives the last row filled.
+     */
+    virtual bool FillWindow(int startRowIndex, int targetRowIndex, std::shared_ptr<AppDataFwk::SharedBlock> block,
+        int &endRowIndex);
+
+    /**
+     * Fills the given blocks one after another with the rows from startRowIndex, each block going on from the row
+     * after the last one of the previous block. endRowIndexes receives the last row filled in each block, it ends
+     * at the first block no row fits in or once targetRowIndex is filled.
+     */
+    virtual bool FillWindows(int startRowIndex, int targetRowIndex,
+        const std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> &blocks, std::vector<int> &endRowIndexes);
+
+    /**
+     * Most windows worth filling in one FillWindows call. A local fill saves nothing by filling several windows at
+     * once, so the prefetch hands each window over as soon as it is filled.
+     */
+    virtual uint32_t GetFillWindowsLimit();
+
+    /**
+     * Whether the provider fills the blocks the consumer hands over, the prefetch and the adaptive window need it.
+     * A provider that does not moves the cursor with OnGo only.
+     */
+    virtual bool CanFillWindow();
+
+    /**
+     * Gives the row count a streaming cursor knows without the provider, returns false if it has to be asked.
+     */
+    bool GetStreamedRowCount(int &count);
+
+    /**
+     * Caps the row count of the provider by the row budget of a streaming cursor.
+     */
+    int CapStreamedRowCount(int count);
+
+    /**
+     * Stops the background prefetch and waits for the window being filled.
+     */
+    void StopPrefetch();
+
     friend class ISharedResultSetStub;
     friend class ISharedResultSetProxy;
     bool Unmarshalling(MessageParcel &parcel);
     bool Marshalling(MessageParcel &parcel);
 
 private:
+    struct PrefetchWindow {
+        std::shared_ptr<AppDataFwk::SharedBlock> block;
+        int startRowPos;
+        int endRowPos;
+    };
+
+    int FillByBridge(int startRowIndex, int targetRowIndex, DataShareBlockWriterImpl &writer);
+    int GetCellValue(int columnIndex, int &type, const void *&value, size_t &size);
+    bool IsPrefetchEnabled();
+    bool MoveToWindow(int position, int rowCount, int &startPos, int &endPos);
+    std::shared_ptr<PrefetchWindow> TakePrefetchedWindow(int position, std::unique_lock<std::mutex> &lock);
+    void SetCurrentWindow(std::shared_ptr<PrefetchWindow> window);
+    void SchedulePrefetch();
+    void RunPrefetch();
+    std::shared_ptr<AppDataFwk::SharedBlock> AcquireWindowBlock();
+    std::shared_ptr<AppDataFwk::SharedBlock> AdoptBlockOwner(uint64_t owner);
+    bool IsAdaptiveWindowEnabled();
+    bool MoveToAdaptiveWindow(int position, int rowCount, int &startPos, int &endPos);
+    bool FillAdaptiveWindow(int position, int targetRow, size_t blockSize, int &endPos);
+    size_t GetAdaptiveBlockSize();
+    void StopAdaptiveWindow();
+    void StopFillingWindows();
+    int GetCursorRowLimit();
+    void RecycleWindowBlock(std::shared_ptr<AppDataFwk::SharedBlock> block);
+
     static const size_t DEFAULT_SHARE_BLOCK_SIZE = 2 * 1024 * 1024;
     static const size_t MAX_SHARE_BLOCK_SIZE = 5 * 1024 * 1024;
+    static constexpr uint32_t MAX_PREFETCH_DEPTH = 4;
+    // Most blocks filled in one FillWindows call, enough for a prefetch ring of the largest depth
+    static constexpr uint32_t MAX_FILL_WINDOWS = MAX_PREFETCH_DEPTH;
     static std::atomic<int32_t> blockId_;
     // The actual position of the first row of data in the shareblock
     int startRowPos_ = -1;
@@ -191,6 +427,42 @@ private:
     std::shared_ptr<AppDataFwk::SharedBlock> sharedBlock_ = nullptr;
     std::shared_ptr<DataShareBlockWriterImpl> blockWriter_ = nullptr;
     std::shared_ptr<ResultSetBridge> bridge_ = nullptr;
+    // The block comes from SharedBlockPool and goes back to it on close, with the owner of the process it was handed to
+    bool blockPooled_ = false;
+    size_t blockSize_ = 0;
+    uint64_t blockOwner_ = 0;
+    // Only the cursor thread replaces sharedBlock_ then, so it reads sharedBlock_ without mutex_
+    std::atomic<bool> singleThreaded_ = false;
+    // Serializes the bridge between the reader and the prefetch
+    std::mutex fillMutex_;
+    std::mutex prefetchMutex_;
+    std::condition_variable prefetchCond_;
+    bool prefetchEnabled_ = false;
+    bool prefetchRunning_ = false;
+    PrefetchOption prefetchOption_;
+    PrefetchStatistics prefetchStatistics_;
+    // Bumped whenever the prefetched windows are dropped, so an outdated fill is thrown away
+    uint64_t prefetchGeneration_ = 0;
+    // The first row the prefetch continues from when no window is prefetched yet, -1 if none
+    int prefetchNextRow_ = -1;
+    int prefetchRowCount_ = 0;
+    // The block the result set was created with, the windows only borrow sharedBlock_
+    std::shared_ptr<AppDataFwk::SharedBlock> baseBlock_ = nullptr;
+    std::shared_ptr<PrefetchWindow> currentWindow_ = nullptr;
+    std::deque<std::shared_ptr<PrefetchWindow>> prefetchWindows_;
+    std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> idleBlocks_;
+    // The adaptive window borrows sharedBlock_ like the prefetch does, under prefetchMutex_
+    bool adaptiveEnabled_ = false;
+    AdaptiveWindowOption adaptiveOption_;
+    AdaptiveWindowStatistics adaptiveStatistics_;
+    // Rows the next window is sized for
+    uint32_t adaptiveRows_ = 0;
+    std::shared_ptr<AppDataFwk::SharedBlock> adaptiveBlock_ = nullptr;
+    // Streaming moves the cursor without the row count, moved like the row positions by the cursor only
+    bool streaming_ = false;
+    StreamOption streamOption_;
+    // Rows of the result set once the cursor reached the end, -1 before
+    int streamRowCount_ = -1;
 };
 } // namespace DataShare
 } // namespace OHOS
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATA_SHARE_LRU_CACHE_H
+#define DATA_SHARE_LRU_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OHOS {
+namespace DataShare {
+/**
+ * @brief A bounded cache split into shards, each shard evicts its least recently used entry when full.
+ *
+ * Lookups of different keys mostly take different locks, and reaching the size limit only drops one entry
+ * instead of the whole cache. With a time to live, an entry older than it is dropped by the next lookup, so a
+ * cache nobody invalidates still picks up changes of the source.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class DataShareLruCache {
+public:
+    struct Statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t expirations = 0;
+    };
+
+    explicit DataShareLruCache(size_t capacity, size_t shardNum = DEFAULT_SHARD_NUM,
+        std::chrono::milliseconds ttl = std::chrono::milliseconds::zero()) : ttl_(ttl)
+    {
+        shardNum = std::max<size_t>(shardNum, 1);
+        size_t shardCapacity = std::max<size_t>((capacity + shardNum - 1) / shardNum, 1);
+        for (size_t i = 0; i < shardNum; i++) {
+            shards_.emplace_back(std::make_unique<Shard>(shardCapacity));
+        }
+    }
+
+    std::pair<bool, Value> Find(const Key &key)
+    {
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end() && IsExpired(*it->second)) {
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+            it = shard.index.end();
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (it == shard.index.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return std::make_pair(false, Value());
+        }
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return std::make_pair(true, it->second->value);
+    }
+
+    void Emplace(const Key &key, const Value &value)
+    {
+        Shard &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        auto time = std::chrono::steady_clock::now();
+        if (it != shard.index.end()) {
+            it->second->value = value;
+            it->second->time = time;
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            return;
+        }
+        if (shard.entries.size() >= shard.capacity) {
+            shard.index.erase(shard.entries.back().key);
+            shard.entries.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.entries.push_front(Entry { key, value, time });
+        shard.index.emplace(key, shard.entries.begin());
+    }
+
+    size_t EraseIf(const std::function<bool(const Key &key, Value &value)> &action)
+    {
+        size_t count = 0;
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            for (auto it = shard->entries.begin(); it != shard->entries.end();) {
+                if (!action(it->key, it->value)) {
+                    ++it;
+                    continue;
+                }
+                shard->index.erase(it->key);
+                it = shard->entries.erase(it);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    void Clear()
+    {
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->index.clear();
+            shard->entries.clear();
+        }
+    }
+
+    size_t Size()
+    {
+        size_t size = 0;
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            size += shard->entries.size();
+        }
+        return size;
+    }
+
+    Statistics GetStatistics() const
+    {
+        Statistics statistics;
+        statistics.hits = hits_.load(std::memory_order_relaxed);
+        statistics.misses = misses_.load(std::memory_order_relaxed);
+        statistics.evictions = evictions_.load(std::memory_order_relaxed);
+        statistics.expirations = expirations_.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
+    static constexpr size_t DEFAULT_SHARD_NUM = 8;
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        // when the value was put
+        std::chrono::steady_clock::time_point time;
+    };
+    using Entries = std::list<Entry>;
+
+    struct Shard {
+        explicit Shard(size_t capacity) : capacity(capacity) {}
+        const size_t capacity;
+        std::mutex mutex;
+        // most recently used entry first
+        Entries entries;
+        std::unordered_map<Key, typename Entries::iterator, Hash> index;
+    };
+
+    Shard &GetShard(const Key &key)
+    {
+        return *shards_[Hash()(key) % shards_.size()];
+    }
+
+    bool IsExpired(const Entry &entry) const
+    {
+        return ttl_ > std::chrono::milliseconds::zero() && std::chrono::steady_clock::now() - entry.time >= ttl_;
+    }
+
+    const std::chrono::milliseconds ttl_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> hits_ = 0;
+    std::atomic<uint64_t> misses_ = 0;
+    std::atomic<uint64_t> evictions_ = 0;
+    std::atomic<uint64_t> expirations_ = 0;
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // DATA_SHARE_LRU_CACHE_H
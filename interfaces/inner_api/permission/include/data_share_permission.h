@@ -16,13 +16,15 @@
 #ifndef DATA_SHARE_PERMISSION_H
 #define DATA_SHARE_PERMISSION_H
 
+#include <chrono>
+#include <map>
 #include <string>
 
 #include "access_token.h"
 #include "accesstoken_kit.h"
-#include "concurrent_map.h"
 #include "common_event_manager.h"
 #include "common_event_support.h"
+#include "data_share_lru_cache.h"
 #include "uri.h"
 
 namespace OHOS {
@@ -30,6 +32,13 @@ namespace DataShare {
 class DataSharePermission : public std::enable_shared_from_this<DataSharePermission> {
 using Uri = OHOS::Uri;
 public:
+    struct CacheStatistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t expirations = 0;
+    };
+
     DataSharePermission() = default;
     ~DataSharePermission() = default;
     /**
@@ -67,6 +76,13 @@ public:
 
     void DeleteCache(std::string bundleName);
 
+    /**
+     * @brief Obtains the statistics of the permission caches.
+
+     * @return Returns the statistics keyed by cache name: extension, silent and token.
+     */
+    std::map<std::string, CacheStatistics> GetCacheStatistics();
+
     static bool IsDataShareUri(Uri &uri);
 
     static bool IsSingletonTrustUri(const Uri &uri);
@@ -90,7 +106,9 @@ private:
         static constexpr const char *USER_ID = "userId";
     };
 
-    static constexpr int32_t CACHE_SIZE = 32;
+    static constexpr int32_t CACHE_SIZE = 256;
+    // Bounds how long a cache without the package events serves the permissions of an updated provider.
+    static constexpr std::chrono::milliseconds CACHE_TTL = std::chrono::seconds(60);
     struct Permission {
         std::string bundleName;
         std::string readPermission;
@@ -103,18 +121,42 @@ private:
 
         UriKey(std::string &uri, int32_t userId):uri(uri), userId(userId) {}
 
-        bool operator<(const UriKey &other) const
+        bool operator==(const UriKey &other) const
         {
-            if (uri < other.uri) {
-                return true;
-            }
-            if (userId < other.userId) {
-                return true;
-            }
-            return false;
+            return userId == other.userId && uri == other.uri;
         }
     };
 
+    // The provider permissions depend on the uri without query and the user of the token only.
+    struct TokenUriKey {
+        std::string uri;
+        uint32_t tokenId;
+
+        TokenUriKey(std::string &uri, uint32_t tokenId):uri(uri), tokenId(tokenId) {}
+
+        bool operator==(const TokenUriKey &other) const
+        {
+            return tokenId == other.tokenId && uri == other.uri;
+        }
+    };
+
+    struct UriKeyHash {
+        size_t operator()(const UriKey &key) const
+        {
+            return std::hash<std::string>()(key.uri) ^ (std::hash<int32_t>()(key.userId) << 1);
+        }
+    };
+
+    struct TokenUriKeyHash {
+        size_t operator()(const TokenUriKey &key) const
+        {
+            return std::hash<std::string>()(key.uri) ^ (std::hash<uint32_t>()(key.tokenId) << 1);
+        }
+    };
+
+    using PermissionCache = DataShareLruCache<UriKey, Permission, UriKeyHash>;
+    using TokenPermissionCache = DataShareLruCache<TokenUriKey, Permission, TokenUriKeyHash>;
+
     static constexpr const char *SCHEME_DATASHARE = "datashare";
     static constexpr const char *SCHEME_DATASHARE_PROXY = "datashareproxy";
     static constexpr const char *SCHEME_PREFERENCE = "sharepreferences";
@@ -126,9 +168,11 @@ private:
     static int VerifyDataObsPermissionInner(Security::AccessToken::AccessTokenID tokenID,
         Uri &uri, bool isRead, bool &isTrust);
 
+    static TokenPermissionCache &GetTokenCache();
+
     std::shared_ptr<SysEventSubscriber> subscriber_ = nullptr;
-    ConcurrentMap<UriKey, Permission> extensionCache_;
-    ConcurrentMap<UriKey, Permission> silentCache_;
+    PermissionCache extensionCache_ { CACHE_SIZE, PermissionCache::DEFAULT_SHARD_NUM, CACHE_TTL };
+    PermissionCache silentCache_ { CACHE_SIZE, PermissionCache::DEFAULT_SHARD_NUM, CACHE_TTL };
 };
 } // namespace DataShare
 } // namespace OHOS
@@ -16,8 +16,13 @@
 #ifndef DATASHARE_RESULT_SET_BRIDGE_H
 #define DATASHARE_RESULT_SET_BRIDGE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+
+#include "datashare_errno.h"
+
 namespace OHOS {
 namespace DataShare {
 // build the bridge between the database's ResultSet and DataShare's ResultSet
@@ -25,6 +30,33 @@ class ResultSetBridge {
 public:
     class Writer {
     public:
+        /**
+         * A cell written by WriteRow or WriteColumn. A string or blob cell points to bytes owned by the caller,
+         * which are only read during the call.
+         */
+        struct Cell {
+            enum Type : int32_t {
+                TYPE_NULL = 0,
+                TYPE_INTEGER,
+                TYPE_FLOAT,
+                TYPE_STRING,
+                TYPE_BLOB,
+            };
+
+            Cell() = default;
+            explicit Cell(int64_t value) : type(TYPE_INTEGER), longValue(value) {}
+            explicit Cell(double value) : type(TYPE_FLOAT), doubleValue(value) {}
+            Cell(const char *text, size_t sizeIncludingNull)
+                : type(TYPE_STRING), value(text), size(sizeIncludingNull) {}
+            Cell(const uint8_t *blob, size_t blobSize) : type(TYPE_BLOB), value(blob), size(blobSize) {}
+
+            Type type = TYPE_NULL;
+            int64_t longValue = 0;
+            double doubleValue = 0;
+            const void *value = nullptr;
+            size_t size = 0;
+        };
+
         /**
          * Allocate a row unit and its directory.
          */
@@ -59,6 +91,56 @@ public:
          * Write string data to the shared block.
          */
         virtual int Write(uint32_t column, const char *value, size_t size) = 0;
+
+        /**
+         * Allocate a row and write the cells to its first count columns in one call. The row is freed if a cell
+         * can not be written, so a full block never keeps a partial row.
+         */
+        virtual int WriteRow(const Cell *cells, uint32_t count)
+        {
+            if (cells == nullptr && count != 0) {
+                return E_ERROR;
+            }
+            int result = AllocRow();
+            if (result != E_OK) {
+                return result;
+            }
+            for (uint32_t column = 0; column < count && result == E_OK; column++) {
+                result = WriteCell(column, cells[column]);
+            }
+            if (result != E_OK) {
+                FreeLastRow();
+            }
+            return result;
+        }
+
+        /**
+         * Write a chunk of one column to the rows from startRow, which have been allocated in the current block.
+         * startRow counts from the first row of the block. Writers that can only write the last row return E_ERROR.
+         */
+        virtual int WriteColumn(uint32_t column, uint32_t startRow, const Cell *cells, uint32_t count)
+        {
+            return E_ERROR;
+        }
+
+    protected:
+        int WriteCell(uint32_t column, const Cell &cell)
+        {
+            switch (cell.type) {
+                case Cell::TYPE_NULL:
+                    return Write(column);
+                case Cell::TYPE_INTEGER:
+                    return Write(column, cell.longValue);
+                case Cell::TYPE_FLOAT:
+                    return Write(column, cell.doubleValue);
+                case Cell::TYPE_STRING:
+                    return Write(column, static_cast<const char *>(cell.value), cell.size);
+                case Cell::TYPE_BLOB:
+                    return Write(column, static_cast<const uint8_t *>(cell.value), cell.size);
+                default:
+                    return E_ERROR;
+            }
+        }
     };
 
     virtual ~ResultSetBridge() {}
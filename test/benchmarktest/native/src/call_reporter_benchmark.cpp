@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "call_reporter_benchmark"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "call_reporter.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+const std::vector<std::string> FUNC_NAMES = { "Insert", "Update", "Delete", "Query" };
+const std::string URI = "datashare:///com.acts.benchmark/entry/DB00/TBL00";
+DataShareCallReporter g_reporter;
+} // namespace
+
+/**
+ * Cost of accounting one call, with state.threads() threads calling the same few functions concurrently.
+ */
+static void BM_CallReporter_Count(benchmark::State &state)
+{
+    size_t index = static_cast<size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(g_reporter.Count(FUNC_NAMES[index % FUNC_NAMES.size()], URI));
+        index++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallReporter_Count)->ThreadRange(1, 8)->UseRealTime();
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
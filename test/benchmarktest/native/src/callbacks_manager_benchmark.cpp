@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "callbacks_manager_benchmark"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "callbacks_manager.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+constexpr int64_t OBSERVERS_PER_KEY = 4;
+
+// Stands in for the observer keys of the subscriber managers, without a service behind them.
+struct BenchmarkKey {
+    explicit BenchmarkKey(int64_t id) : uri_("datashareproxy://com.acts.benchmark/key" + std::to_string(id)) {}
+    bool operator<(const BenchmarkKey &other) const
+    {
+        return uri_ < other.uri_;
+    }
+    operator std::string() const
+    {
+        return uri_;
+    }
+    std::string uri_;
+};
+
+struct BenchmarkObserver {
+    void OnChange()
+    {
+        changes++;
+    }
+    uint64_t changes = 0;
+};
+
+using BenchmarkCallbacks = CallbacksManager<BenchmarkKey, BenchmarkObserver>;
+
+void OnLocalAdd(const std::vector<BenchmarkKey> &, const std::shared_ptr<BenchmarkObserver> &) {}
+
+void OnFirstAdd(const std::vector<BenchmarkKey> &keys, const std::shared_ptr<BenchmarkObserver> &,
+    std::vector<OperationResult> &result)
+{
+    for (auto &key : keys) {
+        result.emplace_back(key, E_OK);
+    }
+}
+
+std::vector<BenchmarkKey> CreateKeys(int64_t keyNum)
+{
+    std::vector<BenchmarkKey> keys;
+    keys.reserve(keyNum);
+    for (int64_t i = 0; i < keyNum; i++) {
+        keys.emplace_back(i);
+    }
+    return keys;
+}
+
+// Subscribers are only compared by address, so indexes into a vector are enough.
+std::vector<int64_t> CreateSubscribers(int64_t subscriberNum)
+{
+    return std::vector<int64_t>(subscriberNum);
+}
+} // namespace
+
+/**
+ * Cost of registering range(0) subscribers on one key and removing them again.
+ */
+static void BM_CallbacksManager_AddDel(benchmark::State &state)
+{
+    std::vector<BenchmarkKey> keys = CreateKeys(1);
+    auto subscribers = CreateSubscribers(state.range(0));
+    auto observer = std::make_shared<BenchmarkObserver>();
+    for (auto _ : state) {
+        BenchmarkCallbacks callbacks;
+        for (auto &subscriber : subscribers) {
+            callbacks.AddObservers(keys, &subscriber, observer, OnLocalAdd, OnFirstAdd);
+        }
+        for (auto &subscriber : subscribers) {
+            callbacks.DelObservers(keys, &subscriber);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CallbacksManager_AddDel)->RangeMultiplier(10)->Range(10, 1000);
+
+/**
+ * Cost of looking up and notifying the observers of one key, with range(0) keys registered.
+ */
+static void BM_CallbacksManager_Emit(benchmark::State &state)
+{
+    std::vector<BenchmarkKey> keys = CreateKeys(state.range(0));
+    auto subscribers = CreateSubscribers(OBSERVERS_PER_KEY);
+    BenchmarkCallbacks callbacks;
+    for (auto &subscriber : subscribers) {
+        callbacks.AddObservers(keys, &subscriber, std::make_shared<BenchmarkObserver>(), OnLocalAdd, OnFirstAdd);
+    }
+    size_t index = 0;
+    for (auto _ : state) {
+        for (auto &observer : callbacks.GetEnabledObservers(keys[index])) {
+            observer->OnChange();
+        }
+        index = (index + 1) % keys.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallbacksManager_Emit)->RangeMultiplier(10)->Range(10, 10000);
+
+/**
+ * Cost of removing one subscriber by address, while OBSERVERS_PER_KEY other subscribers keep range(0) keys.
+ */
+static void BM_CallbacksManager_DelSubscriber(benchmark::State &state)
+{
+    std::vector<BenchmarkKey> keys = CreateKeys(state.range(0));
+    std::vector<BenchmarkKey> ownKeys = { keys.front() };
+    auto subscribers = CreateSubscribers(OBSERVERS_PER_KEY + 1);
+    BenchmarkCallbacks callbacks;
+    for (size_t i = 1; i < subscribers.size(); i++) {
+        callbacks.AddObservers(keys, &subscribers[i], std::make_shared<BenchmarkObserver>(), OnLocalAdd, OnFirstAdd);
+    }
+    auto observer = std::make_shared<BenchmarkObserver>();
+    for (auto _ : state) {
+        callbacks.AddObservers(ownKeys, &subscribers[0], observer, OnLocalAdd, OnFirstAdd);
+        callbacks.DelObservers(&subscribers[0]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallbacksManager_DelSubscriber)->RangeMultiplier(10)->Range(10, 10000);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
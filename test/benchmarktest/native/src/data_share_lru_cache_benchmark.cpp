@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "data_share_lru_cache.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+constexpr int64_t CACHE_SIZE = 256;
+
+// Stands in for the provider permissions cached by DataSharePermission.
+struct BenchmarkPermission {
+    std::string bundleName;
+    std::string readPermission;
+    std::string writePermission;
+};
+
+using BenchmarkCache = DataShareLruCache<std::string, BenchmarkPermission>;
+
+std::vector<std::string> CreateUris(int64_t uriNum)
+{
+    std::vector<std::string> uris;
+    uris.reserve(uriNum);
+    for (int64_t i = 0; i < uriNum; i++) {
+        uris.emplace_back("datashare:///com.acts.benchmark/entry/DB00/TBL" + std::to_string(i));
+    }
+    return uris;
+}
+
+void FillCache(BenchmarkCache &cache, const std::vector<std::string> &uris)
+{
+    BenchmarkPermission permission { "com.acts.benchmark", "ohos.permission.READ", "ohos.permission.WRITE" };
+    for (auto &uri : uris) {
+        cache.Emplace(uri, permission);
+    }
+}
+
+// Shared by the threads of one run, so it is filled once before any of them looks it up.
+BenchmarkCache &GetFilledCache(const std::vector<std::string> &uris)
+{
+    static BenchmarkCache cache(CACHE_SIZE);
+    static std::once_flag filled;
+    std::call_once(filled, [&uris]() { FillCache(cache, uris); });
+    return cache;
+}
+} // namespace
+
+/**
+ * Cost of a cache hit, with state.threads() threads looking up the CACHE_SIZE cached uris concurrently.
+ */
+static void BM_DataShareLruCache_Hit(benchmark::State &state)
+{
+    static const std::vector<std::string> uris = CreateUris(CACHE_SIZE);
+    BenchmarkCache &cache = GetFilledCache(uris);
+    size_t index = static_cast<size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.Find(uris[index % uris.size()]));
+        index++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DataShareLruCache_Hit)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * Cost of a miss followed by the insert that evicts the least recently used entry, cycling through range(0) uris
+ * so every lookup misses once the cache is full.
+ */
+static void BM_DataShareLruCache_MissEvict(benchmark::State &state)
+{
+    BenchmarkCache cache(CACHE_SIZE);
+    std::vector<std::string> uris = CreateUris(state.range(0));
+    BenchmarkPermission permission { "com.acts.benchmark", "ohos.permission.READ", "ohos.permission.WRITE" };
+    size_t index = 0;
+    for (auto _ : state) {
+        auto &uri = uris[index];
+        if (!cache.Find(uri).first) {
+            cache.Emplace(uri, permission);
+        }
+        index = (index + 1) % uris.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DataShareLruCache_MissEvict)->Arg(CACHE_SIZE * 2)->Arg(CACHE_SIZE * 8);
+
+/**
+ * Cost of dropping the entries of one provider, as a package update does, from a full cache.
+ */
+static void BM_DataShareLruCache_EraseIf(benchmark::State &state)
+{
+    BenchmarkCache cache(CACHE_SIZE);
+    std::vector<std::string> uris = CreateUris(CACHE_SIZE);
+    for (auto _ : state) {
+        state.PauseTiming();
+        FillCache(cache, uris);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(cache.EraseIf([](const std::string &, BenchmarkPermission &value) {
+            return value.bundleName == "com.acts.benchmark";
+        }));
+    }
+    state.SetItemsProcessed(state.iterations() * CACHE_SIZE);
+}
+BENCHMARK(BM_DataShareLruCache_EraseIf);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
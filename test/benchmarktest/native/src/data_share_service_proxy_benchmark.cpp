@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "data_share_service_proxy_benchmark"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "data_share_service_loopback.h"
+#include "data_share_service_proxy.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+const std::string URI = "datashareproxy://com.acts.benchmark/entry/DB00/TBL00";
+constexpr size_t ROW_COUNT = 10000;
+
+std::vector<DataShareValuesBucket> GetRows()
+{
+    std::vector<DataShareValuesBucket> values(ROW_COUNT);
+    for (size_t i = 0; i < ROW_COUNT; i++) {
+        values[i].Put("name", "benchmark" + std::to_string(i));
+        values[i].Put("age", static_cast<int>(i));
+        values[i].Put("score", 99.5);
+    }
+    return values;
+}
+} // namespace
+
+/**
+ * Inserts 10k rows one request per row, the way the silent helper did it without a batch.
+ */
+static void BM_ServiceInsertEx_10k(benchmark::State &state)
+{
+    sptr<DataShareServiceLoopback> service = new DataShareServiceLoopback();
+    DataShareServiceProxy proxy(service);
+    Uri uri(URI);
+    Uri extUri("");
+    auto values = GetRows();
+    for (auto _ : state) {
+        for (const auto &value : values) {
+            benchmark::DoNotOptimize(proxy.InsertEx(uri, extUri, value));
+        }
+        state.PauseTiming();
+        service->Clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * ROW_COUNT);
+}
+BENCHMARK(BM_ServiceInsertEx_10k)->Unit(benchmark::kMillisecond);
+
+/**
+ * Inserts 10k rows in one BatchInsert request.
+ */
+static void BM_ServiceBatchInsert_10k(benchmark::State &state)
+{
+    sptr<DataShareServiceLoopback> service = new DataShareServiceLoopback();
+    DataShareServiceProxy proxy(service);
+    Uri uri(URI);
+    Uri extUri("");
+    auto values = GetRows();
+    std::vector<int32_t> results;
+    for (auto _ : state) {
+        results.clear();
+        benchmark::DoNotOptimize(proxy.BatchInsert(uri, extUri, values, results));
+        state.PauseTiming();
+        service->Clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * ROW_COUNT);
+}
+BENCHMARK(BM_ServiceBatchInsert_10k)->Unit(benchmark::kMillisecond);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
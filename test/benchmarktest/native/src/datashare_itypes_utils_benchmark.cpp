@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "datashare_itypes_utils.h"
+#include "datashare_operation_statement.h"
+#include "message_parcel.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+constexpr int64_t COLUMN_NUM = 8;
+
+std::vector<DataShareValuesBucket> CreateBuckets(int64_t rowNum)
+{
+    std::vector<DataShareValuesBucket> buckets;
+    buckets.reserve(rowNum);
+    for (int64_t row = 0; row < rowNum; row++) {
+        DataShareValuesBucket bucket;
+        for (int64_t column = 0; column < COLUMN_NUM; column++) {
+            std::string key = "column" + std::to_string(column);
+            if (column % 2 == 0) {
+                bucket.Put(key, row * COLUMN_NUM + column);
+            } else {
+                bucket.Put(key, "value of row " + std::to_string(row));
+            }
+        }
+        buckets.emplace_back(std::move(bucket));
+    }
+    return buckets;
+}
+} // namespace
+
+/**
+ * Cost of encoding a BatchInsert payload into a parcel.
+ */
+static void BM_ITypesUtil_MarshalValuesBucketVec(benchmark::State &state)
+{
+    auto buckets = CreateBuckets(state.range(0));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        MessageParcel parcel;
+        if (!ITypesUtil::MarshalValuesBucketVec(buckets, parcel)) {
+            state.SkipWithError("marshal failed");
+            return;
+        }
+        bytes = parcel.GetDataSize() + parcel.GetRawDataSize();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ITypesUtil_MarshalValuesBucketVec)->RangeMultiplier(10)->Range(1000, 100000);
+
+/**
+ * Cost of decoding a BatchInsert payload from a parcel.
+ */
+static void BM_ITypesUtil_UnmarshalValuesBucketVec(benchmark::State &state)
+{
+    auto buckets = CreateBuckets(state.range(0));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        MessageParcel parcel;
+        if (!ITypesUtil::MarshalValuesBucketVec(buckets, parcel)) {
+            state.SkipWithError("marshal failed");
+            return;
+        }
+        bytes = parcel.GetDataSize() + parcel.GetRawDataSize();
+        std::vector<DataShareValuesBucket> result;
+        state.ResumeTiming();
+        if (!ITypesUtil::UnmarshalValuesBucketVec(result, parcel)) {
+            state.SkipWithError("unmarshal failed");
+            return;
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ITypesUtil_UnmarshalValuesBucketVec)->RangeMultiplier(10)->Range(1000, 100000);
+
+/**
+ * Round trip of predicates carrying an IN list, as sent by every query.
+ */
+static void BM_ITypesUtil_Predicates(benchmark::State &state)
+{
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        names.emplace_back("name" + std::to_string(i));
+    }
+    DataSharePredicates predicates;
+    predicates.EqualTo("age", 10)->And()->In("name", names)->OrderByAsc("age");
+    for (auto _ : state) {
+        MessageParcel parcel;
+        DataSharePredicates result;
+        if (!ITypesUtil::MarshalPredicates(predicates, parcel) || !ITypesUtil::UnmarshalPredicates(result, parcel)) {
+            state.SkipWithError("round trip failed");
+            return;
+        }
+        benchmark::DoNotOptimize(result.GetOperationList().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ITypesUtil_Predicates)->RangeMultiplier(10)->Range(10, 1000);
+
+/**
+ * Round trip of an ExecuteBatch payload of range(0) statements.
+ */
+static void BM_ITypesUtil_OperationStatementVec(benchmark::State &state)
+{
+    auto buckets = CreateBuckets(state.range(0));
+    std::vector<OperationStatement> statements;
+    statements.reserve(buckets.size());
+    for (size_t i = 0; i < buckets.size(); i++) {
+        OperationStatement statement;
+        statement.operationType = i % 2 == 0 ? Operation::INSERT : Operation::UPDATE;
+        statement.uri = "datashare:///com.acts.benchmark/entry/table";
+        statement.predicates.EqualTo("column0", static_cast<int64_t>(i));
+        statement.valuesBucket = buckets[i];
+        statements.emplace_back(std::move(statement));
+    }
+    size_t bytes = 0;
+    for (auto _ : state) {
+        MessageParcel parcel;
+        std::vector<OperationStatement> result;
+        if (!ITypesUtil::MarshalOperationStatementVec(statements, parcel) ||
+            !ITypesUtil::UnmarshalOperationStatementVec(result, parcel)) {
+            state.SkipWithError("round trip failed");
+            return;
+        }
+        bytes = parcel.GetDataSize() + parcel.GetRawDataSize();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ITypesUtil_OperationStatementVec)->RangeMultiplier(10)->Range(10, 1000);
+
+/**
+ * Round trip of a published data change node with range(0) blobs, each blob in its own shared memory when
+ * range(1) is 0, all blobs in one arena otherwise. The fds counter is the number of shared memories sent.
+ */
+static void BM_ITypesUtil_PublishedDataChangeNode(benchmark::State &state)
+{
+    constexpr size_t blobSize = 256;
+    bool useArena = state.range(1) != 0;
+    PublishedDataChangeNode changeNode;
+    changeNode.ownerBundleName_ = "com.acts.datasharetest";
+    for (int64_t i = 0; i < state.range(0); i++) {
+        changeNode.datas_.emplace_back("key" + std::to_string(i), i, std::vector<uint8_t>(blobSize, i));
+    }
+    size_t fds = 0;
+    for (auto _ : state) {
+        MessageParcel parcel;
+        bool result = useArena ? ITypesUtil::Marshal(parcel, changeNode) :
+            ITypesUtil::Marshal(parcel, changeNode.ownerBundleName_, changeNode.datas_);
+        PublishedDataChangeNode received;
+        if (!result || !ITypesUtil::Unmarshal(parcel, received)) {
+            state.SkipWithError("round trip failed");
+            return;
+        }
+        for (const auto &item : received.datas_) {
+            benchmark::DoNotOptimize(item.GetBlobSpan().data);
+        }
+        fds = parcel.GetOffsetsSize();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["fds"] = fds;
+}
+BENCHMARK(BM_ITypesUtil_PublishedDataChangeNode)->ArgsProduct({ { 10, 100 }, { 0, 1 } });
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
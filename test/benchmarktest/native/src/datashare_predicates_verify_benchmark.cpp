@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "datashare_errno.h"
+#include "datashare_predicates.h"
+#include "datashare_predicates_verify.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+// Field shapes accepted by the verifier, so every operation is checked to the end.
+const std::vector<std::string> FIELDS = { "name", " (age) ", "[t_user.id]", "\"store.t_user.phone\"", "$.data" };
+
+std::string GetField(int64_t index)
+{
+    return FIELDS[index % FIELDS.size()];
+}
+} // namespace
+
+/**
+ * Verify cost of a chain of ORDER BY and comparison operations, one field each.
+ */
+static void BM_PredicatesVerify_Operations(benchmark::State &state)
+{
+    int64_t operationNum = state.range(0);
+    DataSharePredicates predicates;
+    for (int64_t i = 0; i < operationNum; i++) {
+        if (i % 2 == 0) {
+            predicates.OrderByAsc(GetField(i));
+        } else {
+            predicates.GreaterThan(GetField(i), i);
+        }
+    }
+    DataSharePredicatesVerify predicatesVerify;
+    for (auto _ : state) {
+        auto result = predicatesVerify.VerifyPredicates(predicates);
+        if (result.second != E_OK) {
+            state.SkipWithError("verify failed");
+            return;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * operationNum);
+}
+BENCHMARK(BM_PredicatesVerify_Operations)->RangeMultiplier(10)->Range(10, 10000);
+
+/**
+ * Verify cost of one GROUP BY operation with a wide field list.
+ */
+static void BM_PredicatesVerify_WideFields(benchmark::State &state)
+{
+    int64_t fieldNum = state.range(0);
+    std::vector<std::string> fields;
+    for (int64_t i = 0; i < fieldNum; i++) {
+        fields.push_back(GetField(i));
+    }
+    DataSharePredicates predicates;
+    predicates.GroupBy(fields);
+    DataSharePredicatesVerify predicatesVerify;
+    for (auto _ : state) {
+        auto result = predicatesVerify.VerifyPredicates(predicates);
+        if (result.second != E_OK) {
+            state.SkipWithError("verify failed");
+            return;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * fieldNum);
+}
+BENCHMARK(BM_PredicatesVerify_WideFields)->RangeMultiplier(10)->Range(10, 10000);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
@@ -0,0 +1,564 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "datashare_errno.h"
+#include "datashare_result_set.h"
+#include "shared_block_pool.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+constexpr int ROW_COUNT = 10000;
+constexpr int WINDOW_ROWS = 500;
+// Stands for the provider query and the IPC round trip of filling one window.
+constexpr std::chrono::microseconds WINDOW_LATENCY(500);
+// Stands for the work the consumer does per row.
+constexpr std::chrono::nanoseconds ROW_WORK(1000);
+// Rows of 1KB text and 1KB blob, all held by one window so the reads do not refill it.
+constexpr int TEXT_ROW_COUNT = 800;
+constexpr size_t TEXT_CELL_SIZE = 1024;
+
+// 10k rows of 20 columns: 10 integers, 5 doubles and 5 short strings.
+constexpr int WIDE_ROW_COUNT = 10000;
+constexpr int WIDE_LONG_COLUMNS = 10;
+constexpr int WIDE_DOUBLE_COLUMNS = 5;
+constexpr int WIDE_COLUMN_COUNT = 20;
+
+// 10k rows of an id and a blob, narrow with a 32B blob or wide with a 16KB one.
+constexpr int SCHEMA_ROW_COUNT = 10000;
+constexpr size_t NARROW_BLOB_SIZE = 32;
+constexpr size_t WIDE_BLOB_SIZE = 16 * 1024;
+
+// 1M rows of an id and a name, and the rows a streaming cursor asks for first.
+constexpr int TABLE_ROW_COUNT = 1000000;
+constexpr uint32_t TABLE_PAGE_ROWS = 100;
+// Stands for the provider stepping over one row of its query.
+constexpr std::chrono::nanoseconds ROW_STEP(50);
+
+enum ReadMode : int64_t {
+    READ_COPY = 0,
+    READ_VIEW = 1,
+    READ_VIEW_SINGLE_THREADED = 2,
+};
+
+class DelayedBridge : public ResultSetBridge {
+public:
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "id", "name" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = ROW_COUNT;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        std::this_thread::sleep_for(WINDOW_LATENCY);
+        int endRowIndex = std::min(targetRowIndex, startRowIndex + WINDOW_ROWS - 1);
+        for (int row = startRowIndex; row <= endRowIndex; row++) {
+            if (writer.AllocRow() != E_OK || writer.Write(0, static_cast<int64_t>(row)) != E_OK ||
+                writer.Write(1, "datashare", sizeof("datashare")) != E_OK) {
+                return -1;
+            }
+        }
+        return endRowIndex;
+    }
+};
+
+class TextBridge : public ResultSetBridge {
+public:
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "text", "data" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = TEXT_ROW_COUNT;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        std::string text(TEXT_CELL_SIZE - 1, 't');
+        std::vector<uint8_t> data(TEXT_CELL_SIZE, 'd');
+        for (int row = startRowIndex; row <= targetRowIndex; row++) {
+            if (writer.AllocRow() != E_OK || writer.Write(0, text.c_str(), text.size() + 1) != E_OK ||
+                writer.Write(1, data.data(), data.size()) != E_OK) {
+                return row - 1;
+            }
+        }
+        return targetRowIndex;
+    }
+};
+
+class WideBridge : public ResultSetBridge {
+public:
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames.clear();
+        for (int column = 0; column < WIDE_COLUMN_COUNT; column++) {
+            columnNames.push_back("column" + std::to_string(column));
+        }
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = WIDE_ROW_COUNT;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        for (int row = startRowIndex; row <= targetRowIndex; row++) {
+            if (writer.AllocRow() != E_OK) {
+                return row - 1;
+            }
+            std::string text = "datashare" + std::to_string(row);
+            for (uint32_t column = 0; column < WIDE_COLUMN_COUNT; column++) {
+                int result = column < WIDE_LONG_COLUMNS ? writer.Write(column, static_cast<int64_t>(row)) :
+                    column < WIDE_LONG_COLUMNS + WIDE_DOUBLE_COLUMNS ? writer.Write(column, static_cast<double>(row)) :
+                    writer.Write(column, text.c_str(), text.size() + 1);
+                if (result != E_OK) {
+                    writer.FreeLastRow();
+                    return row - 1;
+                }
+            }
+        }
+        return targetRowIndex;
+    }
+};
+
+// Serves the single row of a lookup by key.
+class LookupBridge : public ResultSetBridge {
+public:
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "id", "name" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = 1;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        const char name[] = "datashare";
+        if (writer.AllocRow() != E_OK || writer.Write(0, static_cast<int64_t>(startRowIndex)) != E_OK ||
+            writer.Write(1, name, sizeof(name)) != E_OK) {
+            return -1;
+        }
+        return startRowIndex;
+    }
+};
+
+// Serves as many rows as the block holds after the latency of a window, and counts the windows it fills.
+class SchemaBridge : public ResultSetBridge {
+public:
+    explicit SchemaBridge(size_t blobSize) : blob_(blobSize, 'b') {}
+
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "id", "data" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = SCHEMA_ROW_COUNT;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        refills_++;
+        std::this_thread::sleep_for(WINDOW_LATENCY);
+        for (int row = startRowIndex; row <= targetRowIndex; row++) {
+            if (writer.AllocRow() != E_OK) {
+                return row - 1;
+            }
+            if (writer.Write(0, static_cast<int64_t>(row)) != E_OK ||
+                writer.Write(1, blob_.data(), blob_.size()) != E_OK) {
+                writer.FreeLastRow();
+                return row - 1;
+            }
+        }
+        return targetRowIndex;
+    }
+
+    uint64_t GetRefills() const
+    {
+        return refills_;
+    }
+
+private:
+    std::vector<uint8_t> blob_;
+    std::atomic<uint64_t> refills_ = 0;
+};
+
+DataType GetWideType(int column)
+{
+    if (column < WIDE_LONG_COLUMNS) {
+        return DataType::TYPE_INTEGER;
+    }
+    return column < WIDE_LONG_COLUMNS + WIDE_DOUBLE_COLUMNS ? DataType::TYPE_FLOAT : DataType::TYPE_STRING;
+}
+
+void Work(std::chrono::nanoseconds duration)
+{
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// Serves a table whose row count costs the provider a step over every row, like counting the rows of a query.
+class TableBridge : public ResultSetBridge {
+public:
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "id", "name" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        Work(ROW_STEP * TABLE_ROW_COUNT);
+        count = TABLE_ROW_COUNT;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        const char name[] = "datashare";
+        int endRowIndex = std::min(targetRowIndex, TABLE_ROW_COUNT - 1);
+        for (int row = startRowIndex; row <= endRowIndex; row++) {
+            Work(ROW_STEP);
+            if (writer.AllocRow() != E_OK) {
+                return row - 1;
+            }
+            if (writer.Write(0, static_cast<int64_t>(row)) != E_OK || writer.Write(1, name, sizeof(name)) != E_OK) {
+                writer.FreeLastRow();
+                return row - 1;
+            }
+        }
+        return endRowIndex;
+    }
+};
+
+int64_t GetStatusKb(const std::string &name)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        int64_t value = 0;
+        fields >> key >> value;
+        if (key == name) {
+            return value;
+        }
+    }
+    return 0;
+}
+
+// Scans all rows of the schema with a fixed window of the default block, or with the adaptive window.
+uint64_t ScanSchema(size_t blobSize, bool adaptive)
+{
+    auto schema = std::make_shared<SchemaBridge>(blobSize);
+    std::shared_ptr<ResultSetBridge> bridge = schema;
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    if (adaptive && resultSet->EnableAdaptiveWindow({}) != E_OK) {
+        return 0;
+    }
+    int64_t sum = 0;
+    while (resultSet->GoToNextRow() == E_OK) {
+        int64_t value = 0;
+        resultSet->GetLong(0, value);
+        sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+    resultSet->Close();
+    return schema->GetRefills();
+}
+
+/**
+ * Scans the schema once in a child process, so the peak RSS it reports is what the scan adds to a fresh consumer.
+ */
+int64_t MeasureScanPeakRss(size_t blobSize, bool adaptive)
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return 0;
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        int64_t before = GetStatusKb("VmRSS:");
+        ScanSchema(blobSize, adaptive);
+        int64_t peak = GetStatusKb("VmHWM:") - before;
+        ssize_t size = write(fds[1], &peak, sizeof(peak));
+        _exit(size == sizeof(peak) ? 0 : 1);
+    }
+    close(fds[1]);
+    int64_t peak = 0;
+    if (pid < 0 || read(fds[0], &peak, sizeof(peak)) != sizeof(peak)) {
+        peak = 0;
+    }
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+    return peak;
+}
+} // namespace
+
+/**
+ * Sequential scan of a result set, the argument is the prefetch depth where 0 means no prefetch.
+ */
+static void BM_DataShareResultSet_Scan(benchmark::State &state)
+{
+    DataShareResultSet::PrefetchStatistics statistics;
+    for (auto _ : state) {
+        std::shared_ptr<ResultSetBridge> bridge = std::make_shared<DelayedBridge>();
+        auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+        DataShareResultSet::PrefetchOption option;
+        option.depth = static_cast<uint32_t>(state.range(0));
+        if (resultSet->EnablePrefetch(option) != E_OK) {
+            state.SkipWithError("enable prefetch failed");
+            return;
+        }
+        while (resultSet->GoToNextRow() == E_OK) {
+            int64_t value = 0;
+            resultSet->GetLong(0, value);
+            benchmark::DoNotOptimize(value);
+            Work(ROW_WORK);
+        }
+        auto current = resultSet->GetPrefetchStatistics();
+        statistics.hits += current.hits;
+        statistics.misses += current.misses;
+        statistics.stallTimeUs += current.stallTimeUs;
+        resultSet->Close();
+    }
+    state.SetItemsProcessed(state.iterations() * ROW_COUNT);
+    state.counters["hits"] = benchmark::Counter(statistics.hits, benchmark::Counter::kAvgIterations);
+    state.counters["misses"] = benchmark::Counter(statistics.misses, benchmark::Counter::kAvgIterations);
+    state.counters["stallUs"] = benchmark::Counter(statistics.stallTimeUs, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DataShareResultSet_Scan)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+
+/**
+ * Reads the 1KB text and blob of every row, the argument is the ReadMode: copies with GetString and GetBlob,
+ * views with GetStringView and GetBlobSpan, or views on a single-threaded cursor.
+ */
+static void BM_DataShareResultSet_ReadText(benchmark::State &state)
+{
+    auto mode = static_cast<ReadMode>(state.range(0));
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<TextBridge>();
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    resultSet->SetSingleThreaded(mode == READ_VIEW_SINGLE_THREADED);
+    if (resultSet->GoToLastRow() != E_OK || resultSet->GoToFirstRow() != E_OK) {
+        state.SkipWithError("fill window failed");
+        return;
+    }
+    std::string text;
+    std::vector<uint8_t> blob;
+    for (auto _ : state) {
+        size_t bytes = 0;
+        for (int row = 0; row < TEXT_ROW_COUNT; row++) {
+            resultSet->GoToRow(row);
+            if (mode == READ_COPY) {
+                resultSet->GetString(0, text);
+                resultSet->GetBlob(1, blob);
+                bytes += text.size() + blob.size();
+                continue;
+            }
+            std::string_view textView;
+            const uint8_t *data = nullptr;
+            size_t size = 0;
+            resultSet->GetStringView(0, textView);
+            resultSet->GetBlobSpan(1, data, size);
+            bytes += textView.size() + size;
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetItemsProcessed(state.iterations() * TEXT_ROW_COUNT);
+    state.SetBytesProcessed(state.iterations() * TEXT_ROW_COUNT * TEXT_CELL_SIZE * 2);
+}
+BENCHMARK(BM_DataShareResultSet_ReadText)->Arg(READ_COPY)->Arg(READ_VIEW)->Arg(READ_VIEW_SINGLE_THREADED);
+
+/**
+ * Reads 10k rows of 20 columns with GoToNextRow and one getter per cell.
+ */
+static void BM_DataShareResultSet_ReadCells(benchmark::State &state)
+{
+    std::string text;
+    for (auto _ : state) {
+        std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WideBridge>();
+        auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+        int64_t sum = 0;
+        while (resultSet->GoToNextRow() == E_OK) {
+            for (int column = 0; column < WIDE_COLUMN_COUNT; column++) {
+                int64_t longValue = 0;
+                double doubleValue = 0;
+                switch (GetWideType(column)) {
+                    case DataType::TYPE_INTEGER:
+                        resultSet->GetLong(column, longValue);
+                        sum += longValue;
+                        break;
+                    case DataType::TYPE_FLOAT:
+                        resultSet->GetDouble(column, doubleValue);
+                        sum += static_cast<int64_t>(doubleValue);
+                        break;
+                    default:
+                        resultSet->GetString(column, text);
+                        sum += static_cast<int64_t>(text.size());
+                        break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        resultSet->Close();
+    }
+    state.SetItemsProcessed(state.iterations() * WIDE_ROW_COUNT);
+}
+BENCHMARK(BM_DataShareResultSet_ReadCells)->Unit(benchmark::kMillisecond);
+
+/**
+ * Reads 10k rows of 20 columns with GetRows, the argument is the number of rows fetched per call.
+ */
+static void BM_DataShareResultSet_GetRows(benchmark::State &state)
+{
+    int batchRows = static_cast<int>(state.range(0));
+    std::vector<DataShareResultSet::ColumnBuffer> columns(WIDE_COLUMN_COUNT);
+    for (int column = 0; column < WIDE_COLUMN_COUNT; column++) {
+        columns[column].columnIndex = column;
+        columns[column].type = GetWideType(column);
+    }
+    for (auto _ : state) {
+        std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WideBridge>();
+        auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+        int64_t sum = 0;
+        int fetchedRows = 0;
+        for (int row = 0; row < WIDE_ROW_COUNT; row += fetchedRows) {
+            if (resultSet->GetRows(row, batchRows, columns, fetchedRows) != E_OK || fetchedRows == 0) {
+                state.SkipWithError("get rows failed");
+                return;
+            }
+            sum += columns[0].longs.back() + static_cast<int64_t>(columns[WIDE_COLUMN_COUNT - 1].arena.size());
+        }
+        benchmark::DoNotOptimize(sum);
+        resultSet->Close();
+    }
+    state.SetItemsProcessed(state.iterations() * WIDE_ROW_COUNT);
+}
+BENCHMARK(BM_DataShareResultSet_GetRows)->Arg(256)->Arg(WIDE_ROW_COUNT)->Unit(benchmark::kMillisecond);
+
+/**
+ * Queries of a single row, each one creating, reading and closing a result set, with the idle blocks of
+ * SharedBlockPool disabled (0) or enabled (1).
+ */
+static void BM_DataShareResultSet_Lookup(benchmark::State &state)
+{
+    auto &pool = SharedBlockPool::GetInstance();
+    pool.SetMaxIdleBytes(state.range(0) == 0 ? 0 : SharedBlockPool::DEFAULT_MAX_IDLE_BYTES);
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<LookupBridge>();
+    for (auto _ : state) {
+        auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+        int64_t id = -1;
+        if (resultSet->GoToFirstRow() != E_OK || resultSet->GetLong(0, id) != E_OK) {
+            state.SkipWithError("lookup failed");
+            break;
+        }
+        benchmark::DoNotOptimize(id);
+        resultSet->Close();
+    }
+    pool.SetMaxIdleBytes(SharedBlockPool::DEFAULT_MAX_IDLE_BYTES);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DataShareResultSet_Lookup)->Arg(0)->Arg(1);
+
+/**
+ * Sequential scan of 10k rows, the first argument is the schema (0 narrow, 1 wide) and the second one the window
+ * (0 the fixed default block, 1 the adaptive window with its default bounds).
+ */
+static void BM_DataShareResultSet_AdaptiveWindow(benchmark::State &state)
+{
+    size_t blobSize = state.range(0) == 0 ? NARROW_BLOB_SIZE : WIDE_BLOB_SIZE;
+    bool adaptive = state.range(1) != 0;
+    uint64_t refills = 0;
+    for (auto _ : state) {
+        refills += ScanSchema(blobSize, adaptive);
+    }
+    state.SetItemsProcessed(state.iterations() * SCHEMA_ROW_COUNT);
+    state.counters["refillsPer10k"] = benchmark::Counter(refills, benchmark::Counter::kAvgIterations);
+    state.counters["peakRssKB"] = MeasureScanPeakRss(blobSize, adaptive);
+}
+BENCHMARK(BM_DataShareResultSet_AdaptiveWindow)->Args({ 0, 0 })->Args({ 0, 1 })->Args({ 1, 0 })->Args({ 1, 1 })
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Time to the first row of a 1M row table, with the default cursor (0) which counts the rows and fills a full block
+ * first, or a streaming cursor (1) which fills a page of 100 rows.
+ */
+static void BM_DataShareResultSet_FirstRow(benchmark::State &state)
+{
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<TableBridge>();
+    DataShareResultSet::StreamOption option;
+    option.pageRows = TABLE_PAGE_ROWS;
+    for (auto _ : state) {
+        auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+        if (state.range(0) != 0) {
+            resultSet->EnableStreaming(option);
+        }
+        int64_t id = -1;
+        if (resultSet->GoToFirstRow() != E_OK || resultSet->GetLong(0, id) != E_OK) {
+            state.SkipWithError("first row failed");
+            break;
+        }
+        benchmark::DoNotOptimize(id);
+        resultSet->Close();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DataShareResultSet_FirstRow)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "general_controller_provider_benchmark"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "datashare_connection_base.h"
+#include "datashare_values_bucket.h"
+#include "general_controller_provider_impl.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+const std::string URI = "datashare:///com.acts.benchmark/entry/DB00/TBL00";
+
+// Answers every request at once, so the benchmarks measure the client side of a call only.
+class RemoteObjectStandIn : public IRemoteObject {
+public:
+    RemoteObjectStandIn() : IRemoteObject(u"OHOS.DataShare.IDataShare") {}
+
+    int32_t GetObjectRefCount() override
+    {
+        return 0;
+    }
+
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        reply.WriteInt32(1);
+        return 0;
+    }
+
+    bool AddDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    bool RemoveDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    int Dump(int fd, const std::vector<std::u16string> &args) override
+    {
+        return 0;
+    }
+};
+
+// Hands out the proxy under a lock like DataShareConnection does once connected.
+class ConnectionStandIn : public DataShareConnectionBase {
+public:
+    ConnectionStandIn() : proxy_(std::make_shared<DataShareProxy>(new RemoteObjectStandIn())) {}
+
+    std::shared_ptr<DataShareProxy> GetDataShareProxy(const Uri &uri, const sptr<IRemoteObject> &token) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return proxy_;
+    }
+
+    void UpdateObserverExtsProviderMap(const Uri &uri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver,
+        bool isDescendants) override {}
+
+    void DeleteObserverExtsProviderMap(const Uri &uri,
+        const sptr<AAFwk::IDataAbilityObserver> &dataObserver) override {}
+
+private:
+    std::mutex mutex_;
+    std::shared_ptr<DataShareProxy> proxy_;
+};
+
+std::shared_ptr<ConnectionStandIn> g_connection = std::make_shared<ConnectionStandIn>();
+GeneralControllerProviderImpl g_controller(g_connection, Uri(URI), nullptr);
+
+DataShareValuesBucket GetBucket()
+{
+    DataShareValuesBucket bucket;
+    bucket.Put("name", std::string("benchmark"));
+    bucket.Put("age", 18);
+    return bucket;
+}
+} // namespace
+
+/**
+ * Insert looking the proxy up from the connection on every call, the way the controller did it before.
+ */
+static void BM_ProviderInsert_ConnectionLookup(benchmark::State &state)
+{
+    Uri uri(URI);
+    auto bucket = GetBucket();
+    for (auto _ : state) {
+        auto proxy = g_connection->GetDataShareProxy(uri, nullptr);
+        benchmark::DoNotOptimize(proxy->Insert(uri, bucket));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProviderInsert_ConnectionLookup)->ThreadRange(1, 8)->UseRealTime();
+
+/**
+ * Insert through the controller, which reuses its cached proxy while the proxy version is unchanged.
+ */
+static void BM_ProviderInsert_CachedProxy(benchmark::State &state)
+{
+    Uri uri(URI);
+    auto bucket = GetBucket();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(g_controller.Insert(uri, bucket));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProviderInsert_CachedProxy)->ThreadRange(1, 8)->UseRealTime();
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
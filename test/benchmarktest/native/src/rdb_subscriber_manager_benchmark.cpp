@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_share_service_proxy.h"
+#include "rdb_subscriber_manager.h"
+
+namespace OHOS {
+namespace DataShare {
+namespace {
+constexpr int64_t SUBSCRIBER_ID = 1;
+
+// Stands in for the data share service, it only counts the requests it receives.
+class CountingRemoteObject : public IRemoteObject {
+public:
+    CountingRemoteObject() : IRemoteObject(u"OHOS.DataShare.IDataShareService") {}
+
+    int32_t GetObjectRefCount() override
+    {
+        return 0;
+    }
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    bool AddDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+    bool RemoveDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+    int Dump(int fd, const std::vector<std::u16string> &args) override
+    {
+        return 0;
+    }
+    uint64_t TakeRequests()
+    {
+        return requests_.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> requests_ = 0;
+};
+} // namespace
+
+/**
+ * Subscribes range(0) uris of one template and tears the subscriber down. The counters are the requests sent
+ * to the service by each step, they should not grow with the number of uris.
+ */
+static void BM_RdbSubscriberManager_SubscribeTeardown(benchmark::State &state)
+{
+    sptr<CountingRemoteObject> remote = new (std::nothrow) CountingRemoteObject();
+    if (remote == nullptr) {
+        state.SkipWithError("create remote failed");
+        return;
+    }
+    auto proxy = std::make_shared<DataShareServiceProxy>(remote);
+    std::vector<std::string> uris;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        uris.emplace_back("datashareproxy://com.acts.benchmark/table" + std::to_string(i));
+    }
+    TemplateId templateId = { SUBSCRIBER_ID, "com.acts.benchmark" };
+    auto &manager = RdbSubscriberManager::GetInstance();
+    int subscriber = 0;
+    uint64_t subscribeRequests = 0;
+    uint64_t unsubscribeRequests = 0;
+    for (auto _ : state) {
+        manager.AddObservers(&subscriber, proxy, uris, templateId, [](const RdbChangeNode &) {});
+        subscribeRequests = remote->TakeRequests();
+        manager.DelObservers(&subscriber, proxy);
+        unsubscribeRequests = remote->TakeRequests();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["subscribeRequests"] = subscribeRequests;
+    state.counters["unsubscribeRequests"] = unsubscribeRequests;
+}
+BENCHMARK(BM_RdbSubscriberManager_SubscribeTeardown)->Arg(1)->Arg(100)->Arg(1000);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "datashare_block_writer_impl.h"
+#include "shared_block.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace OHOS::AppDataFwk;
+namespace {
+constexpr size_t BLOCK_SIZE = 5 * 1024 * 1024;
+constexpr uint32_t COLUMN_NUM = 2;
+// Visits rows in a scattered order so every lookup resolves its row offset from scratch.
+constexpr uint32_t ROW_STRIDE = 7919;
+constexpr uint32_t CURSOR_NUM = 20;
+constexpr uint32_t CURSOR_ROW_NUM = 100000;
+using WideColumns = std::vector<std::vector<ResultSetBridge::Writer::Cell>>;
+// A wide row of 10 integer, 5 double and 5 string columns, 10k of them take most of a 5MB block.
+constexpr uint32_t WIDE_COLUMN_NUM = 20;
+constexpr uint32_t WIDE_INTEGER_END = 10;
+constexpr uint32_t WIDE_FLOAT_END = 15;
+constexpr uint32_t WIDE_ROW_NUM = 10000;
+constexpr uint32_t WIDE_CHUNK_ROW_NUM = 256;
+
+struct MemoryUsage {
+    int64_t rssKb = 0;
+    int64_t pssKb = 0;
+};
+
+std::unique_ptr<SharedBlock> CreateFilledBlock(uint32_t rowNum)
+{
+    SharedBlock *block = nullptr;
+    if (SharedBlock::Create("benchmark", BLOCK_SIZE, block) != SharedBlock::SHARED_BLOCK_OK) {
+        return nullptr;
+    }
+    std::unique_ptr<SharedBlock> holder(block);
+    if (block->Clear() != SharedBlock::SHARED_BLOCK_OK ||
+        block->SetColumnNum(COLUMN_NUM) != SharedBlock::SHARED_BLOCK_OK) {
+        return nullptr;
+    }
+    for (uint32_t row = 0; row < rowNum; row++) {
+        if (block->AllocRow() != SharedBlock::SHARED_BLOCK_OK) {
+            return nullptr;
+        }
+        block->PutLong(row, 0, row);
+        block->PutDouble(row, 1, row);
+    }
+    return holder;
+}
+
+// The cells of the wide rows, row by row, with the strings they point to.
+struct WideRows {
+    std::vector<std::string> texts;
+    std::vector<ResultSetBridge::Writer::Cell> cells;
+};
+
+const WideRows &GetWideRows()
+{
+    static WideRows rows = [] {
+        WideRows wide;
+        wide.texts.reserve(WIDE_ROW_NUM);
+        for (uint32_t row = 0; row < WIDE_ROW_NUM; row++) {
+            wide.texts.push_back("benchmark" + std::to_string(row));
+        }
+        for (uint32_t row = 0; row < WIDE_ROW_NUM; row++) {
+            const std::string &text = wide.texts[row];
+            for (uint32_t column = 0; column < WIDE_COLUMN_NUM; column++) {
+                if (column < WIDE_INTEGER_END) {
+                    wide.cells.emplace_back(static_cast<int64_t>(row + column));
+                } else if (column < WIDE_FLOAT_END) {
+                    wide.cells.emplace_back(row * 0.5 + column);
+                } else {
+                    wide.cells.emplace_back(text.c_str(), text.size() + 1);
+                }
+            }
+        }
+        return wide;
+    }();
+    return rows;
+}
+
+bool ResetBlock(DataShareBlockWriterImpl &writer)
+{
+    auto block = writer.GetBlock();
+    return block != nullptr && block->Clear() == SharedBlock::SHARED_BLOCK_OK &&
+        block->SetColumnNum(WIDE_COLUMN_NUM) == SharedBlock::SHARED_BLOCK_OK;
+}
+
+// Writes the wide rows the way providers do without the batched calls, one Write call per cell.
+bool WriteCells(DataShareBlockWriterImpl &writer, const WideRows &rows)
+{
+    const ResultSetBridge::Writer::Cell *cell = rows.cells.data();
+    for (uint32_t row = 0; row < WIDE_ROW_NUM; row++) {
+        if (writer.AllocRow() != E_OK) {
+            return false;
+        }
+        for (uint32_t column = 0; column < WIDE_COLUMN_NUM; column++, cell++) {
+            int result = E_OK;
+            if (column < WIDE_INTEGER_END) {
+                result = writer.Write(column, cell->longValue);
+            } else if (column < WIDE_FLOAT_END) {
+                result = writer.Write(column, cell->doubleValue);
+            } else {
+                result = writer.Write(column, static_cast<const char *>(cell->value), cell->size);
+            }
+            if (result != E_OK) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool WriteRows(DataShareBlockWriterImpl &writer, const WideRows &rows)
+{
+    for (uint32_t row = 0; row < WIDE_ROW_NUM; row++) {
+        if (writer.WriteRow(&rows.cells[row * WIDE_COLUMN_NUM], WIDE_COLUMN_NUM) != E_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Writes chunks of rows column by column, the way a columnar source hands its values over.
+bool WriteColumns(DataShareBlockWriterImpl &writer, const WideColumns &columns)
+{
+    for (uint32_t startRow = 0; startRow < WIDE_ROW_NUM; startRow += WIDE_CHUNK_ROW_NUM) {
+        uint32_t count = std::min(WIDE_CHUNK_ROW_NUM, WIDE_ROW_NUM - startRow);
+        for (uint32_t i = 0; i < count; i++) {
+            if (writer.AllocRow() != E_OK) {
+                return false;
+            }
+        }
+        for (uint32_t column = 0; column < WIDE_COLUMN_NUM; column++) {
+            if (writer.WriteColumn(column, startRow, &columns[column][startRow], count) != E_OK) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+MemoryUsage GetMemoryUsage()
+{
+    MemoryUsage usage;
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string line;
+    while (std::getline(smaps, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        int64_t value = 0;
+        fields >> key >> value;
+        if (key == "Rss:") {
+            usage.rssKb = value;
+        } else if (key == "Pss:") {
+            usage.pssKb = value;
+        }
+    }
+    return usage;
+}
+
+// Maps the block the way a consumer does with the block sent by the provider.
+std::unique_ptr<SharedBlock> OpenCursor(SharedBlock &block, bool readOnly)
+{
+    MessageParcel parcel;
+    if (!block.WriteMessageParcel(parcel)) {
+        return nullptr;
+    }
+    SharedBlock *cursor = nullptr;
+    if (SharedBlock::ReadMessageParcel(parcel, cursor, readOnly) != SharedBlock::SHARED_BLOCK_OK) {
+        return nullptr;
+    }
+    return std::unique_ptr<SharedBlock>(cursor);
+}
+
+int64_t ScanCursor(SharedBlock &cursor)
+{
+    int64_t sum = 0;
+    for (uint32_t row = 0; row < cursor.GetRowNum(); row++) {
+        sum += cursor.GetCellUnit(row, 0)->cell.longValue;
+    }
+    return sum;
+}
+
+/**
+ * Opens and scans all cursors in a child process while the blocks stay mapped by this process, so the memory
+ * the child reports is what a consumer pays for cursors shared with their provider.
+ */
+MemoryUsage MeasureCursors(std::vector<std::unique_ptr<SharedBlock>> &blocks, bool readOnly)
+{
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return {};
+    }
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        MemoryUsage before = GetMemoryUsage();
+        std::vector<std::unique_ptr<SharedBlock>> cursors;
+        for (auto &block : blocks) {
+            cursors.push_back(OpenCursor(*block, readOnly));
+            if (cursors.back() != nullptr) {
+                benchmark::DoNotOptimize(ScanCursor(*cursors.back()));
+            }
+        }
+        MemoryUsage after = GetMemoryUsage();
+        MemoryUsage usage = { after.rssKb - before.rssKb, after.pssKb - before.pssKb };
+        ssize_t size = write(fds[1], &usage, sizeof(usage));
+        _exit(size == sizeof(usage) ? 0 : 1);
+    }
+    close(fds[1]);
+    MemoryUsage usage;
+    if (pid < 0 || read(fds[0], &usage, sizeof(usage)) != sizeof(usage)) {
+        usage = {};
+    }
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, nullptr, 0);
+    }
+    return usage;
+}
+} // namespace
+
+/**
+ * Per-cell read cost, which should stay flat as the number of rows in the block grows.
+ */
+static void BM_SharedBlock_GetCellUnit(benchmark::State &state)
+{
+    uint32_t rowNum = static_cast<uint32_t>(state.range(0));
+    auto block = CreateFilledBlock(rowNum);
+    if (block == nullptr) {
+        state.SkipWithError("create block failed");
+        return;
+    }
+    uint32_t row = 0;
+    for (auto _ : state) {
+        row = (row + ROW_STRIDE) % rowNum;
+        benchmark::DoNotOptimize(block->GetCellUnit(row, 1));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedBlock_GetCellUnit)->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Per-cell write cost of an already allocated row.
+ */
+static void BM_SharedBlock_PutLong(benchmark::State &state)
+{
+    uint32_t rowNum = static_cast<uint32_t>(state.range(0));
+    auto block = CreateFilledBlock(rowNum);
+    if (block == nullptr) {
+        state.SkipWithError("create block failed");
+        return;
+    }
+    uint32_t row = 0;
+    for (auto _ : state) {
+        row = (row + ROW_STRIDE) % rowNum;
+        benchmark::DoNotOptimize(block->PutLong(row, 0, row));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedBlock_PutLong)->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Cost of filling a block with rows, including the row directory growth.
+ */
+static void BM_SharedBlock_AllocRow(benchmark::State &state)
+{
+    uint32_t rowNum = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CreateFilledBlock(rowNum));
+    }
+    state.SetItemsProcessed(state.iterations() * rowNum);
+}
+BENCHMARK(BM_SharedBlock_AllocRow)->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Cost of opening and scanning 20 cursors of 100k rows each, with the blocks mapped read-write (0) or read-only
+ * and sealed (1). The counters hold the Rss and Pss a consumer process adds for the 20 cursors.
+ */
+static void BM_SharedBlock_OpenCursors(benchmark::State &state)
+{
+    bool readOnly = state.range(0) != 0;
+    std::vector<std::unique_ptr<SharedBlock>> blocks;
+    for (uint32_t i = 0; i < CURSOR_NUM; i++) {
+        blocks.push_back(CreateFilledBlock(CURSOR_ROW_NUM));
+        if (blocks.back() == nullptr || (readOnly && blocks.back()->Seal() != SharedBlock::SHARED_BLOCK_OK)) {
+            state.SkipWithError("create block failed");
+            return;
+        }
+    }
+    for (auto _ : state) {
+        for (auto &block : blocks) {
+            auto cursor = OpenCursor(*block, readOnly);
+            if (cursor == nullptr) {
+                state.SkipWithError("open cursor failed");
+                return;
+            }
+            benchmark::DoNotOptimize(ScanCursor(*cursor));
+        }
+    }
+    MemoryUsage usage = MeasureCursors(blocks, readOnly);
+    state.counters["RssKB"] = usage.rssKb;
+    state.counters["PssKB"] = usage.pssKb;
+    state.SetItemsProcessed(state.iterations() * CURSOR_NUM);
+}
+BENCHMARK(BM_SharedBlock_OpenCursors)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * Cost of filling a 5MB block with 10k rows of 20 columns through the writer, with one Write call per cell (0),
+ * one WriteRow call per row (1), or one WriteColumn call per column of 256 rows (2).
+ */
+static void BM_SharedBlock_WriteWideRows(benchmark::State &state)
+{
+    int64_t mode = state.range(0);
+    const WideRows &rows = GetWideRows();
+    WideColumns columns(WIDE_COLUMN_NUM);
+    for (uint32_t i = 0; i < rows.cells.size(); i++) {
+        columns[i % WIDE_COLUMN_NUM].push_back(rows.cells[i]);
+    }
+    DataShareBlockWriterImpl writer("benchmark", BLOCK_SIZE);
+    for (auto _ : state) {
+        if (!ResetBlock(writer)) {
+            state.SkipWithError("reset block failed");
+            return;
+        }
+        bool written = mode == 0 ? WriteCells(writer, rows) :
+            (mode == 1 ? WriteRows(writer, rows) : WriteColumns(writer, columns));
+        if (!written) {
+            state.SkipWithError("write rows failed");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * WIDE_ROW_NUM);
+}
+BENCHMARK(BM_SharedBlock_WriteWideRows)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
+} // namespace DataShare
+} // namespace OHOS
+
+BENCHMARK_MAIN();
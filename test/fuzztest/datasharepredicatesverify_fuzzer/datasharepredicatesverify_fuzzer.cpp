@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define LOG_TAG "datasharepredicatesverify_fuzzer"
+
+#include <fuzzer/FuzzedDataProvider.h>
+#include "datasharepredicatesverify_fuzzer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "datashare_errno.h"
+#include "datashare_log.h"
+#include "datashare_predicates.h"
+#include "datashare_predicates_verify.h"
+
+using namespace OHOS::DataShare;
+namespace OHOS {
+// The std::regex patterns the verifier used before the hand written scanner, kept as the reference.
+static const std::regex COLNAME_OPTIONAL_BRACKETS(
+    "^\\s*([a-zA-Z0-9_]+)\\s*$|"
+    "^\\s*\\(([a-zA-Z0-9_]+)\\)\\s*$|"
+    "^\\s*\\[([a-zA-Z0-9_]+)\\]\\s*$|"
+    "^\\s*\"([a-zA-Z0-9_]+)\"\\s*$"
+);
+
+static const std::regex TABLENAME_DOT_COLNAME_OPTIONAL_BRACKETS(
+    "^\\s*([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\s*$|"
+    "^\\s*\\(([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\)\\s*$|"
+    "^\\s*\\[([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\]\\s*$|"
+    "^\\s*\"([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\"\\s*$"
+);
+
+static const std::regex AMPERSAND_DOT_COLNAME_OPTIONAL_BRACKETS(
+    "^\\s*(\\$\\.[a-zA-Z0-9_]+)\\s*$|"
+    "^\\s*\\((\\$\\.[a-zA-Z0-9_]+)\\)\\s*$|"
+    "^\\s*\\[(\\$\\.[a-zA-Z0-9_]+)\\]\\s*$|"
+    "^\\s*\"(\\$\\.[a-zA-Z0-9_]+)\"\\s*$"
+);
+
+static const std::regex STORE_TABLE_COLNAME_OPTIONAL_BRACKETS(
+    "^\\s*([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\s*$|"
+    "^\\s*\\(([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\)\\s*$|"
+    "^\\s*\\[([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\\]\\s*$|"
+    "^\\s*\"([a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+\\.[a-zA-Z0-9_]+)\"\\s*$"
+);
+
+// Characters that decide the result of the verifier, random bytes rarely hit an accepted field.
+static const char FIELD_ALPHABET[] = "aZ09_.$()[]\" \t\n\v\f\r\\x";
+static constexpr size_t MAX_FIELD_LEN = 16;
+static constexpr size_t MAX_FIELD_NUM = 8;
+
+bool LegacyVerifyField(const std::string &field)
+{
+    if (field.empty()) {
+        return true;
+    }
+    return (std::regex_match(field, COLNAME_OPTIONAL_BRACKETS) ||
+        std::regex_match(field, TABLENAME_DOT_COLNAME_OPTIONAL_BRACKETS) ||
+        std::regex_match(field, AMPERSAND_DOT_COLNAME_OPTIONAL_BRACKETS) ||
+        std::regex_match(field, STORE_TABLE_COLNAME_OPTIONAL_BRACKETS));
+}
+
+std::string ConsumeField(FuzzedDataProvider &provider)
+{
+    if (provider.ConsumeBool()) {
+        return provider.ConsumeRandomLengthString(MAX_FIELD_LEN);
+    }
+    std::string field;
+    size_t len = provider.ConsumeIntegralInRange<size_t>(0, MAX_FIELD_LEN);
+    for (size_t i = 0; i < len; i++) {
+        field.push_back(FIELD_ALPHABET[provider.ConsumeIntegralInRange<size_t>(0, sizeof(FIELD_ALPHABET) - 2)]);
+    }
+    return field;
+}
+
+void CheckField(const std::string &field)
+{
+    DataSharePredicatesVerify predicatesVerify;
+    bool expected = LegacyVerifyField(field);
+    if (predicatesVerify.VerifyField(field) != expected) {
+        LOG_ERROR("verify result differs from the regex, field %{public}s, expected %{public}d",
+            field.c_str(), expected);
+        abort();
+    }
+}
+
+void VerifyFieldFuzz(FuzzedDataProvider &provider)
+{
+    CheckField(ConsumeField(provider));
+}
+
+void VerifyPredicatesFuzz(FuzzedDataProvider &provider)
+{
+    DataSharePredicates predicates;
+    std::string field = ConsumeField(provider);
+    std::vector<std::string> fields;
+    size_t fieldNum = provider.ConsumeIntegralInRange<size_t>(0, MAX_FIELD_NUM);
+    for (size_t i = 0; i < fieldNum; i++) {
+        fields.push_back(ConsumeField(provider));
+    }
+    predicates.GreaterThan(field, 1);
+    predicates.GroupBy(fields);
+
+    bool expected = LegacyVerifyField(field);
+    for (const auto &groupField : fields) {
+        expected = expected && LegacyVerifyField(groupField);
+    }
+    DataSharePredicatesVerify predicatesVerify;
+    auto [predicatesType, errCode] = predicatesVerify.VerifyPredicates(predicates);
+    if ((errCode == E_OK) != expected) {
+        LOG_ERROR("verify predicates differs from the regex, type %{public}d, err %{public}d", predicatesType,
+            errCode);
+        abort();
+    }
+}
+} // namespace OHOS
+
+/* Fuzzer entry point */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzedDataProvider provider(data, size);
+    OHOS::VerifyFieldFuzz(provider);
+    OHOS::VerifyPredicatesFuzz(provider);
+    return 0;
+}
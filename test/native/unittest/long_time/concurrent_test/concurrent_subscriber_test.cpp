@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 #include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "accesstoken_kit.h"
 #include "callbacks_manager.h"
@@ -463,6 +466,92 @@ HWTEST_F(ConcurrentSubscriberTest, ConcurrentPublishObserverTest, TestSize.Level
     t4.join();
 }
 
+/**
+ * @tc.name: ConcurrentEmitThroughputTest
+ * @tc.desc: Measure the emit and subscribe throughput of CallbacksManager while subscribers come and go, and verify
+ *           that removing a subscriber by address leaves the observers of the other subscribers untouched.
+ * @tc.type: concurrent
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Register one long-lived observer on THROUGHPUT_KEY_NUM keys.
+    2. Start THROUGHPUT_EMIT_THREADS threads looking up and notifying the observers of the keys in turn.
+    3. Start THROUGHPUT_SUBSCRIBE_THREADS threads, each adding its own subscriber to a few keys and removing it
+       again with DelObservers(subscriber).
+    4. Run for TEST_TIME seconds, then stop and join all threads and log the operations per second.
+ * @tc.expect:
+    1. All concurrent operations complete without crashes or deadlocks, and both sides make progress.
+    2. Only the long-lived observer is left afterwards, one per key.
+ */
+HWTEST_F(ConcurrentSubscriberTest, ConcurrentEmitThroughputTest, TestSize.Level0)
+{
+    constexpr int64_t THROUGHPUT_KEY_NUM = 1000;
+    constexpr int64_t THROUGHPUT_KEYS_PER_SUBSCRIBER = 4;
+    constexpr int THROUGHPUT_EMIT_THREADS = 4;
+    constexpr int THROUGHPUT_SUBSCRIBE_THREADS = 2;
+    RdbBaseCallbacks callbacks;
+    TemplateId templateId;
+    templateId.subscriberId_ = 0;
+    templateId.bundleName_ = "bundleName0";
+    std::vector<RdbObserverMapKey> keys;
+    for (int64_t i = 0; i < THROUGHPUT_KEY_NUM; i++) {
+        keys.emplace_back("uri" + std::to_string(i), templateId);
+    }
+    auto onLocalAdd = [](const std::vector<RdbObserverMapKey> &, const std::shared_ptr<RdbObserver> &) {};
+    auto onFirstAdd = [](const std::vector<RdbObserverMapKey> &, const std::shared_ptr<RdbObserver> &,
+        std::vector<OperationResult> &) {};
+    int owner = 0;
+    callbacks.AddObservers(keys, &owner, std::make_shared<RdbObserver>(g_rbdCallback), onLocalAdd, onFirstAdd);
+
+    std::atomic<bool> stop = false;
+    std::atomic<uint64_t> emits = 0;
+    std::atomic<uint64_t> subscribes = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THROUGHPUT_EMIT_THREADS; i++) {
+        threads.emplace_back([&callbacks, &keys, &stop, &emits, i]() {
+            uint64_t count = 0;
+            for (size_t index = static_cast<size_t>(i); !stop.load(); index = (index + 1) % keys.size()) {
+                for (auto &observer : callbacks.GetEnabledObservers(keys[index])) {
+                    observer->OnChange(g_rdbChangeNode);
+                }
+                count++;
+            }
+            emits += count;
+        });
+    }
+    std::vector<int> subscribers(THROUGHPUT_SUBSCRIBE_THREADS);
+    for (int i = 0; i < THROUGHPUT_SUBSCRIBE_THREADS; i++) {
+        threads.emplace_back([&callbacks, &keys, &stop, &subscribes, &subscribers, &onLocalAdd, &onFirstAdd, i]() {
+            std::vector<RdbObserverMapKey> ownKeys(keys.begin() + i * THROUGHPUT_KEYS_PER_SUBSCRIBER,
+                keys.begin() + (i + 1) * THROUGHPUT_KEYS_PER_SUBSCRIBER);
+            auto observer = std::make_shared<RdbObserver>(g_rbdCallback);
+            uint64_t count = 0;
+            while (!stop.load()) {
+                callbacks.AddObservers(ownKeys, &subscribers[i], observer, onLocalAdd, onFirstAdd);
+                callbacks.DelObservers(&subscribers[i]);
+                count++;
+            }
+            subscribes += count;
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    sleep(TEST_TIME);
+    stop = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("emit %{public}.0f/s, subscribe and unsubscribe %{public}.0f/s",
+        emits.load() / seconds, subscribes.load() / seconds);
+    GTEST_LOG_(INFO) << "emit " << emits.load() / seconds << "/s, subscribe and unsubscribe "
+                     << subscribes.load() / seconds << "/s";
+    EXPECT_GT(emits.load(), 0);
+    EXPECT_GT(subscribes.load(), 0);
+    EXPECT_EQ(callbacks.GetAllSubscriberSize(), THROUGHPUT_KEY_NUM);
+    EXPECT_EQ(callbacks.DelObservers(&owner).size(), 0);
+    EXPECT_EQ(callbacks.GetAllSubscriberSize(), 0);
+}
+
 template <typename T>
 class ConditionLock {
 public:
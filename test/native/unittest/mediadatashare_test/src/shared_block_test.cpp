@@ -218,7 +218,7 @@ HWTEST_F(SharedBlockTest, ClearTest001, TestSize.Level0)
     sharedBlock->mReadOnly = false;
     sharedBlock->mSize = sizeof(SharedBlock::SharedBlockHeader);
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_BAD_VALUE);
-    sharedBlock->mSize = sizeof(SharedBlock::RowGroupHeader) + sizeof(SharedBlock::SharedBlockHeader);
+    sharedBlock->mSize = sizeof(SharedBlock::SharedBlockHeader) + sizeof(uint32_t);
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_BAD_VALUE);
     sharedBlock->mSize = sizeof(SharedBlock::RowGroupHeader) + sizeof(SharedBlock::SharedBlockHeader) + 1;
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_OK);
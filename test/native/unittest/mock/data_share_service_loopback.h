@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATA_SHARE_SERVICE_LOOPBACK_H
+#define DATA_SHARE_SERVICE_LOOPBACK_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "datashare_errno.h"
+#include "datashare_itypes_utils.h"
+#include "distributeddata_data_share_ipc_interface_code.h"
+#include "idata_share_service.h"
+#include "iremote_object.h"
+
+namespace OHOS {
+namespace DataShare {
+/**
+ * Serves the write requests of DataShareServiceProxy in process, so the parcels of the proxy are marshalled and
+ * unmarshalled as they are with the data share service. A row without any value fails, like a row breaking a
+ * NOT NULL constraint, and fails the transaction it belongs to.
+ */
+class DataShareServiceLoopback : public IRemoteObject {
+public:
+    using InterfaceCode = DistributedShare::DataShare::DataShareServiceInterfaceCode;
+
+    DataShareServiceLoopback() : IRemoteObject(u"OHOS.DataShare.IDataShareService") {}
+
+    int32_t GetObjectRefCount() override
+    {
+        return 0;
+    }
+
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        if (data.ReadInterfaceToken() != IDataShareService::GetDescriptor()) {
+            return E_ERROR;
+        }
+        if (code >= DistributedShare::DataShare::DATA_SHARE_CMD_SYSTEM_CODE) {
+            code -= DistributedShare::DataShare::DATA_SHARE_CMD_SYSTEM_CODE;
+        }
+        requestCount_++;
+        switch (static_cast<InterfaceCode>(code)) {
+            case InterfaceCode::DATA_SHARE_SERVICE_CMD_INSERTEX:
+                return OnInsertEx(data, reply);
+            case InterfaceCode::DATA_SHARE_SERVICE_CMD_BATCH_INSERT:
+                return OnBatchInsert(data, reply);
+            case InterfaceCode::DATA_SHARE_SERVICE_CMD_EXECUTE_BATCH:
+                return OnExecuteBatch(data, reply);
+            default:
+                return E_ERROR;
+        }
+    }
+
+    bool AddDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    bool RemoveDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    int Dump(int fd, const std::vector<std::u16string> &args) override
+    {
+        return 0;
+    }
+
+    size_t GetRowCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rows_.size();
+    }
+
+    size_t GetRequestCount() const
+    {
+        return requestCount_;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rows_.clear();
+        requestCount_ = 0;
+    }
+
+private:
+    int OnInsertEx(MessageParcel &data, MessageParcel &reply)
+    {
+        std::string uri;
+        std::string extUri;
+        DataShareValuesBucket value;
+        if (!ITypesUtil::Unmarshal(data, uri, extUri, value)) {
+            return E_ERROR;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (value.IsEmpty()) {
+            return ITypesUtil::Marshal(reply, E_ERROR, 0) ? E_OK : E_ERROR;
+        }
+        rows_.push_back(std::move(value));
+        return ITypesUtil::Marshal(reply, E_OK, static_cast<int32_t>(rows_.size())) ? E_OK : E_ERROR;
+    }
+
+    int OnBatchInsert(MessageParcel &data, MessageParcel &reply)
+    {
+        std::string uri;
+        std::string extUri;
+        std::vector<DataShareValuesBucket> values;
+        if (!ITypesUtil::Unmarshal(data, uri, extUri) || !ITypesUtil::UnmarshalValuesBucketVec(values, data)) {
+            return E_ERROR;
+        }
+        std::vector<int32_t> results;
+        std::lock_guard<std::mutex> lock(mutex_);
+        int32_t errCode = E_OK;
+        for (auto &value : values) {
+            if (value.IsEmpty()) {
+                results.push_back(E_ERROR);
+                errCode = E_ERROR;
+                break;
+            }
+            results.push_back(static_cast<int32_t>(rows_.size() + results.size() + 1));
+        }
+        if (errCode == E_OK) {
+            rows_.insert(rows_.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        }
+        return ITypesUtil::Marshal(reply, errCode, results) ? E_OK : E_ERROR;
+    }
+
+    int OnExecuteBatch(MessageParcel &data, MessageParcel &reply)
+    {
+        std::string extUri;
+        std::vector<OperationStatement> statements;
+        if (!ITypesUtil::Unmarshal(data, extUri) || !ITypesUtil::UnmarshalOperationStatementVec(statements, data)) {
+            return E_ERROR;
+        }
+        ExecResultSet result { ExecErrorCode::EXEC_SUCCESS, {} };
+        std::vector<DataShareValuesBucket> inserted;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &statement : statements) {
+            bool failed = statement.operationType == Operation::INSERT && statement.valuesBucket.IsEmpty();
+            result.results.push_back({ statement.operationType, failed ? E_ERROR : E_OK, "" });
+            if (failed) {
+                result.errorCode = ExecErrorCode::EXEC_FAILED;
+                break;
+            }
+            if (statement.operationType == Operation::INSERT) {
+                inserted.push_back(statement.valuesBucket);
+            }
+        }
+        if (result.errorCode == ExecErrorCode::EXEC_SUCCESS) {
+            rows_.insert(rows_.end(), inserted.begin(), inserted.end());
+        }
+        int32_t errCode = result.errorCode == ExecErrorCode::EXEC_SUCCESS ? E_OK : E_ERROR;
+        return ITypesUtil::Marshal(reply, errCode, result) ? E_OK : E_ERROR;
+    }
+
+    std::mutex mutex_;
+    std::vector<DataShareValuesBucket> rows_;
+    std::atomic<size_t> requestCount_ = 0;
+};
+} // namespace DataShare
+} // namespace OHOS
+#endif // DATA_SHARE_SERVICE_LOOPBACK_H
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "call_reporter_test"
+
+#include "call_reporter.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+class DataShareCallReporterTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+namespace {
+const std::string URI = "datashare:///com.acts.datasharetest/entry/DB00/TBL00";
+constexpr int64_t START_TIME = 1000;
+} // namespace
+
+/**
+ * @tc.name: CallReporter_Threshold_001
+ * @tc.desc: Verify a function is reported over threshold from its ACCESS_COUNT_THRESHOLD call in a window on, while
+ *           other functions keep their own counts.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Count ACCESS_COUNT_THRESHOLD - 1 calls of Insert at the same time.
+    2. Count one more call of Insert, then one call of Query.
+ * @tc.expect:
+    1. The calls of step 1 are not over threshold.
+    2. The last call of Insert is over threshold, the call of Query is not.
+ */
+HWTEST_F(DataShareCallReporterTest, CallReporter_Threshold_001, TestSize.Level0)
+{
+    LOG_INFO("CallReporter_Threshold_001::Start");
+    DataShareCallReporter reporter;
+    for (int i = 1; i < DataShareCallReporter::ACCESS_COUNT_THRESHOLD; i++) {
+        ASSERT_FALSE(reporter.Count("Insert", URI, START_TIME));
+    }
+    EXPECT_TRUE(reporter.Count("Insert", URI, START_TIME));
+    EXPECT_TRUE(reporter.Count("Insert", URI, START_TIME));
+    EXPECT_FALSE(reporter.Count("Query", URI, START_TIME));
+    LOG_INFO("CallReporter_Threshold_001::End");
+}
+
+/**
+ * @tc.name: CallReporter_Window_001
+ * @tc.desc: Verify the call count of a function starts over once TIME_THRESHOLD has passed since its window began.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Count ACCESS_COUNT_THRESHOLD calls of Insert at the same time.
+    2. Count one call just before and one call right at the end of the window.
+ * @tc.expect: The call before the end of the window is over threshold, the call at the end starts a new window.
+ */
+HWTEST_F(DataShareCallReporterTest, CallReporter_Window_001, TestSize.Level0)
+{
+    LOG_INFO("CallReporter_Window_001::Start");
+    DataShareCallReporter reporter;
+    bool isOverThreshold = false;
+    for (int i = 0; i < DataShareCallReporter::ACCESS_COUNT_THRESHOLD; i++) {
+        isOverThreshold = reporter.Count("Insert", URI, START_TIME);
+    }
+    EXPECT_TRUE(isOverThreshold);
+    EXPECT_TRUE(reporter.Count("Insert", URI, START_TIME + DataShareCallReporter::TIME_THRESHOLD - 1));
+    EXPECT_FALSE(reporter.Count("Insert", URI, START_TIME + DataShareCallReporter::TIME_THRESHOLD));
+    LOG_INFO("CallReporter_Window_001::End");
+}
+
+/**
+ * @tc.name: CallReporter_Concurrent_001
+ * @tc.desc: Verify calls counted from several threads at once are neither lost nor counted twice.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step: Count CALLS_PER_THREAD calls of Query on each of THREAD_NUM threads at the same time.
+ * @tc.expect: Exactly the calls from the ACCESS_COUNT_THRESHOLD one on are reported over threshold.
+ */
+HWTEST_F(DataShareCallReporterTest, CallReporter_Concurrent_001, TestSize.Level0)
+{
+    LOG_INFO("CallReporter_Concurrent_001::Start");
+    constexpr int THREAD_NUM = 4;
+    constexpr int CALLS_PER_THREAD = 1000;
+    DataShareCallReporter reporter;
+    std::atomic<int> overCount = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([&reporter, &overCount]() {
+            for (int j = 0; j < CALLS_PER_THREAD; j++) {
+                if (reporter.Count("Query", URI, START_TIME)) {
+                    overCount++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(overCount.load(), THREAD_NUM * CALLS_PER_THREAD - DataShareCallReporter::ACCESS_COUNT_THRESHOLD + 1);
+    LOG_INFO("CallReporter_Concurrent_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "datashare_ashmem_parcel_test"
+
+#include "datashare_ashmem_parcel.h"
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ashmem.h"
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+class DataShareAshmemParcelTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+namespace {
+constexpr uint32_t CODE = 4;
+const std::u16string DESCRIPTOR = u"OHOS.DataShare.IDataShare";
+constexpr size_t BLOB_SIZE = 2 * 1024 * 1024;
+} // namespace
+
+/**
+ * @tc.name: DataShareAshmemParcel_Pack_001
+ * @tc.desc: Verify a request packed into ashmem is restored with its code and content.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Write the interface token, a string and a 2MB buffer into a parcel and pack it.
+    2. Unpack the packed request.
+ * @tc.expect:
+    1. The packed request is much smaller than the original one.
+    2. The restored request has the original code, interface token, string and buffer.
+ */
+HWTEST_F(DataShareAshmemParcelTest, DataShareAshmemParcel_Pack_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareAshmemParcel_Pack_001::Start");
+    MessageParcel data;
+    data.SetMaxCapacity(DataShareAshmemParcel::MAX_SIZE);
+    std::vector<uint8_t> blob(BLOB_SIZE, 'a');
+    blob.back() = 'z';
+    ASSERT_TRUE(data.WriteInterfaceToken(DESCRIPTOR));
+    ASSERT_TRUE(data.WriteString("datashare:///com.acts.datasharetest"));
+    ASSERT_TRUE(data.WriteUint32(blob.size()) && data.WriteBuffer(blob.data(), blob.size()));
+
+    MessageParcel request;
+    ASSERT_TRUE(DataShareAshmemParcel::Pack(CODE, data, request));
+    EXPECT_LT(request.GetDataSize(), 1024);
+
+    uint32_t code = 0;
+    MessageParcel restored;
+    ASSERT_TRUE(DataShareAshmemParcel::Unpack(request, code, restored));
+    EXPECT_EQ(code, CODE);
+    EXPECT_EQ(restored.ReadInterfaceToken(), DESCRIPTOR);
+    EXPECT_EQ(restored.ReadString(), "datashare:///com.acts.datasharetest");
+    uint32_t size = restored.ReadUint32();
+    ASSERT_EQ(size, blob.size());
+    const uint8_t *buffer = restored.ReadBuffer(size);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(std::vector<uint8_t>(buffer, buffer + size), blob);
+    LOG_INFO("DataShareAshmemParcel_Pack_001::End");
+}
+
+/**
+ * @tc.name: DataShareAshmemParcel_Pack_002
+ * @tc.desc: Verify a request holding a file descriptor is not packed.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step: Write a file descriptor into a parcel and pack it.
+ * @tc.expect: Pack fails.
+ */
+HWTEST_F(DataShareAshmemParcelTest, DataShareAshmemParcel_Pack_002, TestSize.Level0)
+{
+    LOG_INFO("DataShareAshmemParcel_Pack_002::Start");
+    MessageParcel data;
+    ASSERT_TRUE(data.WriteInterfaceToken(DESCRIPTOR));
+    ASSERT_TRUE(data.WriteFileDescriptor(STDOUT_FILENO));
+    MessageParcel request;
+    EXPECT_FALSE(DataShareAshmemParcel::Pack(CODE, data, request));
+    LOG_INFO("DataShareAshmemParcel_Pack_002::End");
+}
+
+/**
+ * @tc.name: DataShareAshmemParcel_Unpack_001
+ * @tc.desc: Verify a request whose content does not match its checksum or size is rejected.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Write an ashmem with a wrong checksum into a request and unpack it.
+    2. Write the same ashmem with a size beyond the ashmem into a request and unpack it.
+ * @tc.expect: Both requests fail to unpack.
+ */
+HWTEST_F(DataShareAshmemParcelTest, DataShareAshmemParcel_Unpack_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareAshmemParcel_Unpack_001::Start");
+    std::vector<uint8_t> content(BLOB_SIZE, 'a');
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem("DataShareAshmemParcelTest", content.size());
+    ASSERT_NE(ashmem, nullptr);
+    ASSERT_TRUE(ashmem->MapReadAndWriteAshmem());
+    ASSERT_TRUE(ashmem->WriteToAshmem(content.data(), content.size(), 0));
+    ashmem->UnmapAshmem();
+    ASSERT_TRUE(ashmem->SetProtection(PROT_READ));
+    uint64_t checksum = DataShareAshmemParcel::Checksum(content.data(), content.size());
+
+    MessageParcel request;
+    ASSERT_TRUE(request.WriteUint32(CODE) && request.WriteUint64(content.size()) &&
+        request.WriteUint64(checksum + 1) && request.WriteAshmem(ashmem));
+    uint32_t code = 0;
+    MessageParcel restored;
+    EXPECT_FALSE(DataShareAshmemParcel::Unpack(request, code, restored));
+
+    MessageParcel oversized;
+    ASSERT_TRUE(oversized.WriteUint32(CODE) && oversized.WriteUint64(content.size() + 1) &&
+        oversized.WriteUint64(checksum) && oversized.WriteAshmem(ashmem));
+    MessageParcel restoredOversized;
+    EXPECT_FALSE(DataShareAshmemParcel::Unpack(oversized, code, restoredOversized));
+    ashmem->CloseAshmem();
+    LOG_INFO("DataShareAshmemParcel_Unpack_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS
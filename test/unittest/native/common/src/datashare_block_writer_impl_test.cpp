@@ -18,12 +18,16 @@
 #include <gtest/gtest.h>
 #include <unistd.h>
 
+#include <cstring>
+#include <vector>
+
 #include "datashare_block_writer_impl.h"
 #include "datashare_log.h"
 
 namespace OHOS {
 namespace DataShare {
 using namespace testing::ext;
+using Cell = ResultSetBridge::Writer::Cell;
 class DataShareBlockWriterImplTest : public testing::Test {
 public:
     static void SetUpTestCase(void){};
@@ -32,6 +36,58 @@ public:
     void TearDown(){};
 };
 
+namespace {
+// Records the cells written through the single cell Write calls, and fails a string on column failColumn.
+class RecordingWriter : public ResultSetBridge::Writer {
+public:
+    int AllocRow() override
+    {
+        rows++;
+        return E_OK;
+    }
+
+    int FreeLastRow() override
+    {
+        rows--;
+        return E_OK;
+    }
+
+    int Write(uint32_t column) override
+    {
+        types.push_back(Cell::TYPE_NULL);
+        return E_OK;
+    }
+
+    int Write(uint32_t column, int64_t value) override
+    {
+        types.push_back(Cell::TYPE_INTEGER);
+        return E_OK;
+    }
+
+    int Write(uint32_t column, double value) override
+    {
+        types.push_back(Cell::TYPE_FLOAT);
+        return E_OK;
+    }
+
+    int Write(uint32_t column, const uint8_t *value, size_t size) override
+    {
+        types.push_back(Cell::TYPE_BLOB);
+        return E_OK;
+    }
+
+    int Write(uint32_t column, const char *value, size_t size) override
+    {
+        types.push_back(Cell::TYPE_STRING);
+        return column == failColumn ? E_ERROR : E_OK;
+    }
+
+    int rows = 0;
+    uint32_t failColumn = UINT32_MAX;
+    std::vector<Cell::Type> types;
+};
+} // namespace
+
 /**
  * @tc.name: AllocRowTest001
  * @tc.desc: Verify the behavior of the AllocRow function in DataShareBlockWriterImpl when its member variable
@@ -343,5 +399,102 @@ HWTEST_F(DataShareBlockWriterImplTest, ShareBlock_Null_Test_001, TestSize.Level0
     EXPECT_EQ(result, E_ERROR);
     LOG_INFO("ShareBlock_Null_Test_001::End");
 }
+
+/**
+ * @tc.name: WriteRowTest001
+ * @tc.desc: Verify WriteRow and WriteColumn of DataShareBlockWriterImpl write whole rows and column chunks to the
+ *           shared block, and never leave a partial row when the block is full.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a writer on a 128KB block of 3 columns and write a row of a long, a string and a blob.
+    2. Write a row of 4 cells.
+    3. Allocate 2 rows and write a double and a null to their third column, then write 2 cells from the third row.
+    4. Write rows holding a 32KB blob until the block is full.
+ * @tc.expect:
+    1. The row is written with its values.
+    2. The row of 4 cells fails and no row is allocated.
+    3. The column chunk is written to the allocated rows, the chunk beyond the allocated rows fails.
+    4. The row which does not fit fails and is freed, so every row of the block is complete.
+ */
+HWTEST_F(DataShareBlockWriterImplTest, WriteRowTest001, TestSize.Level0)
+{
+    LOG_INFO("DataShareBlockWriterImplTest WriteRowTest001::Start");
+    DataShareBlockWriterImpl writer("WriteRowTest001", 128 * 1024);
+    auto block = writer.GetBlock();
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->Clear(), AppDataFwk::SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_EQ(block->SetColumnNum(3), AppDataFwk::SharedBlock::SHARED_BLOCK_OK);
+    const char text[] = "datashare";
+    const uint8_t blob[] = { 1, 2, 3 };
+    Cell row[] = { Cell(int64_t(7)), Cell(text, sizeof(text)), Cell(blob, sizeof(blob)) };
+    EXPECT_EQ(writer.WriteRow(row, 3), E_OK);
+    ASSERT_EQ(block->GetRowNum(), 1);
+    EXPECT_EQ(block->GetCellUnit(0, 0)->cell.longValue, 7);
+    size_t size = 0;
+    EXPECT_STREQ(block->GetCellUnitValueString(block->GetCellUnit(0, 1), &size), text);
+    EXPECT_EQ(size, sizeof(text));
+    EXPECT_EQ(block->GetCellUnit(0, 2)->type, AppDataFwk::SharedBlock::CELL_UNIT_TYPE_BLOB);
+    EXPECT_EQ(memcmp(block->GetCellUnitValueBlob(block->GetCellUnit(0, 2), &size), blob, sizeof(blob)), 0);
+
+    Cell wideRow[] = { Cell(), Cell(), Cell(), Cell() };
+    EXPECT_EQ(writer.WriteRow(wideRow, 4), E_ERROR);
+    EXPECT_EQ(block->GetRowNum(), 1);
+
+    ASSERT_EQ(writer.AllocRow(), E_OK);
+    ASSERT_EQ(writer.AllocRow(), E_OK);
+    Cell column[] = { Cell(1.5), Cell() };
+    EXPECT_EQ(writer.WriteColumn(2, 1, column, 2), E_OK);
+    EXPECT_EQ(block->GetCellUnit(1, 2)->cell.doubleValue, 1.5);
+    EXPECT_EQ(block->GetCellUnit(2, 2)->type, AppDataFwk::SharedBlock::CELL_UNIT_TYPE_NULL);
+    EXPECT_EQ(writer.WriteColumn(2, 2, column, 2), E_ERROR);
+
+    std::vector<uint8_t> bigBlob(32 * 1024, 'a');
+    Cell bigRow[] = { Cell(int64_t(1)), Cell(bigBlob.data(), bigBlob.size()) };
+    uint32_t rowNum = block->GetRowNum();
+    while (writer.WriteRow(bigRow, 2) == E_OK) {
+        rowNum++;
+    }
+    EXPECT_EQ(block->GetRowNum(), rowNum);
+    EXPECT_EQ(block->GetCellUnit(rowNum - 1, 1)->type, AppDataFwk::SharedBlock::CELL_UNIT_TYPE_BLOB);
+    LOG_INFO("DataShareBlockWriterImplTest WriteRowTest001::End");
+}
+
+/**
+ * @tc.name: WriteRowTest002
+ * @tc.desc: Verify the default WriteRow of ResultSetBridge::Writer writes the cells one by one, so writers of
+ *           providers which do not override it keep working.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Write a row of a null, a long, a double, a blob and a string to a writer implementing the single cell calls.
+    2. Write the row again with the string failing.
+    3. Write a column chunk.
+ * @tc.expect:
+    1. The row is allocated and each cell is written with its type.
+    2. WriteRow fails and the row is freed.
+    3. WriteColumn fails, the writer can not address rows.
+ */
+HWTEST_F(DataShareBlockWriterImplTest, WriteRowTest002, TestSize.Level0)
+{
+    LOG_INFO("DataShareBlockWriterImplTest WriteRowTest002::Start");
+    RecordingWriter writer;
+    const char text[] = "datashare";
+    const uint8_t blob[] = { 1 };
+    Cell row[] = { Cell(), Cell(int64_t(1)), Cell(1.0), Cell(blob, sizeof(blob)), Cell(text, sizeof(text)) };
+    EXPECT_EQ(writer.WriteRow(row, 5), E_OK);
+    EXPECT_EQ(writer.rows, 1);
+    std::vector<Cell::Type> types = { Cell::TYPE_NULL, Cell::TYPE_INTEGER, Cell::TYPE_FLOAT, Cell::TYPE_BLOB,
+        Cell::TYPE_STRING };
+    EXPECT_EQ(writer.types, types);
+
+    writer.failColumn = 4;
+    EXPECT_EQ(writer.WriteRow(row, 5), E_ERROR);
+    EXPECT_EQ(writer.rows, 1);
+    EXPECT_EQ(writer.WriteColumn(0, 0, row, 1), E_ERROR);
+    LOG_INFO("DataShareBlockWriterImplTest WriteRowTest002::End");
+}
 } // namespace DataShare
 } // namespace OHOS
\ No newline at end of file
@@ -15,6 +15,7 @@
 #define LOG_TAG "datashare_itypes_utils_test"
 
 #include <gtest/gtest.h>
+#include <securec.h>
 #include <unistd.h>
 #include <sstream>
 #include "datashare_errno.h"
@@ -96,9 +97,9 @@ void GenerateValuesBucket()
 {
     // empty bucket
     testBucket.Clear();
-    // each loop need to contain 90 bytes, 30 loops makeup total 2700 bytes
+    // each loop need to contain 82 bytes, 30 loops makeup total 2460 bytes
     for (int i = 0; i < 30; ++i) {
-        // 1 byte of typeID, 8 bytes + key length + 8bytes + value length, when less then 10 data length is 1
+        // 1 byte of typeID, 4 bytes + key length + 4 bytes + value length, when less then 10 data length is 1
         if (i < 10) {
             testBucket.Put("datasharete" + std::to_string(i),
                 "Initialize the vector with a large number of key value pairs.");
@@ -973,24 +974,19 @@ HWTEST_F(DatashareItypesUtilsTest, MarshalOperationStatementVecCapacity_001, Tes
     // Step 2: Initialize the vector with a large number of OperationStatement objects
     std::vector<OperationStatement> operationStatements;
 
-    // vector size 8 bytes, 2,856 bytes per loops, 46995 * 2856 + 8 = MAX_IPC_SIZE
-    int loops = 46995;
-    if (sizeof(void*) == 4) {
-        // on 32bit system size_t take less spaces, therefore more loops required
-        loops = 60000;
-    }
-    for (int i = 0; i < loops + 1; ++i) {
+    // vector size 4 bytes, 2,588 bytes per loops, 51862 * 2588 + 4 > MAX_IPC_SIZE
+    for (int i = 0; i < 51862; ++i) {
         OperationStatement statement;
         statement.operationType = Operation::INSERT;    // 4 bytes
-        // 8 bytes + data length 70
+        // 4 bytes + data length 70
         statement.uri = "datashareproxy://com.ohos.contactsdataability/contacts/settingssssssss";
-        // operationItem 8 bytes
-        // where cluase 8 bytes + data length 14
-        // whereArgs 8 bytes, order 8 bytes
+        // operationItem 4 bytes
+        // where cluase 4 bytes + data length 14
+        // whereArgs 4 bytes, order 4 bytes
         // mode 2 bytes
         statement.predicates.SetWhereClause("`DB_NUM` > 100");
-        statement.valuesBucket = testBucket;   // 8 bytes + 2700 bytes
-        statement.backReference.SetColumn("column");    // 8 bytes + data length
+        statement.valuesBucket = testBucket;   // 4 bytes + 2460 bytes
+        statement.backReference.SetColumn("column");    // 4 bytes + data length
         statement.backReference.SetFromIndex(i);    // 4 bytes
         operationStatements.emplace_back(statement);
     }
@@ -1003,14 +999,14 @@ HWTEST_F(DatashareItypesUtilsTest, MarshalOperationStatementVecCapacity_001, Tes
 
 /**
 * @tc.name: MarshalOperationStatementVecCapacity_002
-* @tc.desc: Test the marshalling functionality of OperationStatementVec with data equal MAX_IPC_SIZE.
+* @tc.desc: Test the marshalling functionality of OperationStatementVec with data close to MAX_IPC_SIZE.
 * @tc.type: FUNC
 * @tc.require: 1014
 * @tc.precon: None
 * @tc.step:
 *    1. Create a MessageParcel and a vector of OperationStatement objects.
 *    2. Initialize the vector with a large number of OperationStatement objects such that the serialized size
-*       equals MAX_IPC_SIZE(134,217,728 bytes).
+*       is the largest within MAX_IPC_SIZE(134,217,728 bytes).
 *    3. Marshal the vector to the MessageParcel and verify the operation success.
 * @tc.experct: The marshalling operation should succeed.
 */
@@ -1023,19 +1019,19 @@ HWTEST_F(DatashareItypesUtilsTest, MarshalOperationStatementVecCapacity_002, Tes
     // Step 2: Initialize the vector with a large number of OperationStatement objects
     std::vector<OperationStatement> operationStatements;
 
-    // vector size 8 bytes, 2,856 bytes per loops, 46995 * 2856 + 8 = MAX_IPC_SIZE
-    for (int i = 0; i < 46995; ++i) {
+    // vector size 4 bytes, 2,588 bytes per loops, 51861 * 2588 + 4 is the most within MAX_IPC_SIZE
+    for (int i = 0; i < 51861; ++i) {
         OperationStatement statement;
         statement.operationType = Operation::INSERT;    // 4 bytes
-        // 8 bytes + data length 70
+        // 4 bytes + data length 70
         statement.uri = "datashareproxy://com.ohos.contactsdataability/contacts/settingssssssss";
-        // operationItem 8 bytes
-        // where cluase 8 bytes + data length 14
-        // whereArgs 8 bytes, order 8 bytes
+        // operationItem 4 bytes
+        // where cluase 4 bytes + data length 14
+        // whereArgs 4 bytes, order 4 bytes
         // mode 2 bytes
         statement.predicates.SetWhereClause("`DB_NUM` > 100");
-        statement.valuesBucket = testBucket;   // 8 bytes + 2700 bytes
-        statement.backReference.SetColumn("column");    // 8 bytes + data length
+        statement.valuesBucket = testBucket;   // 4 bytes + 2460 bytes
+        statement.backReference.SetColumn("column");    // 4 bytes + data length
         statement.backReference.SetFromIndex(i);    // 4 bytes
         operationStatements.emplace_back(statement);
     }
@@ -1783,5 +1779,244 @@ HWTEST_F(DatashareItypesUtilsTest, UnmarshalDataProxyChangeInfoVec_003, TestSize
 
     LOG_INFO("UnmarshalDataProxyChangeInfoVec_003 ends");
 }
+
+/**
+* @tc.name: MarshalValuesBucketVec_FlatLayout_001
+* @tc.desc: Test the marshalling and unmarshalling of ValuesBucketVec with every value type in the flat layout.
+* @tc.type: FUNC
+* @tc.require: issueNumber
+* @tc.precon: None
+* @tc.step:
+*    1. Create a ValuesBucket that holds an int, a double, a string, a bool, a blob and a null value.
+*    2. Marshal two copies of the bucket to a MessageParcel and unmarshal them back.
+*    3. Compare the unmarshalled buckets with the original one.
+* @tc.expect: All values except the null one are restored, the null value is left out as before.
+*/
+HWTEST_F(DatashareItypesUtilsTest, MarshalValuesBucketVec_FlatLayout_001, TestSize.Level0)
+{
+    LOG_INFO("MarshalValuesBucketVec_FlatLayout_001 starts");
+    DataShareValuesBucket bucket;
+    bucket.Put("int", 1);
+    bucket.Put("double", 2.5);
+    bucket.Put("string", std::string("flat"));
+    bucket.Put("bool", true);
+    bucket.Put("blob", std::vector<uint8_t>{ 1, 2, 3 });
+    bucket.Put("null");
+    std::vector<DataShareValuesBucket> buckets = { bucket, bucket };
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypesUtil::MarshalValuesBucketVec(buckets, parcel));
+
+    std::vector<DataShareValuesBucket> result;
+    ASSERT_TRUE(ITypesUtil::UnmarshalValuesBucketVec(result, parcel));
+    ASSERT_EQ(result.size(), buckets.size());
+    bucket.valuesMap.erase("null");
+    for (const auto &item : result) {
+        EXPECT_EQ(item.valuesMap, bucket.valuesMap);
+    }
+    LOG_INFO("MarshalValuesBucketVec_FlatLayout_001 ends");
+}
+
+/**
+* @tc.name: UnmarshalPredicates_LegacyLayout_001
+* @tc.desc: Test the unmarshalling of predicates written in the legacy layout by an older peer.
+* @tc.type: FUNC
+* @tc.require: issueNumber
+* @tc.precon: None
+* @tc.step:
+*    1. Serialize predicates with a where clause in the legacy layout, which leads with the data length.
+*    2. Call UnmarshalPredicates and verify the where clause and setting mode.
+* @tc.expect: The unmarshalling operation should succeed and restore the legacy predicates.
+*/
+HWTEST_F(DatashareItypesUtilsTest, UnmarshalPredicates_LegacyLayout_001, TestSize.Level0)
+{
+    LOG_INFO("UnmarshalPredicates_LegacyLayout_001 starts");
+    std::string whereClause = "`DB_NUM` > 100";
+    size_t emptySize = 0;
+    size_t clauseSize = whereClause.size();
+    int16_t mode = 1;
+    std::ostringstream oss;
+    // operations, whereClause, whereArgs, order and mode
+    oss.write(reinterpret_cast<const char *>(&emptySize), sizeof(emptySize));
+    oss.write(reinterpret_cast<const char *>(&clauseSize), sizeof(clauseSize));
+    oss.write(whereClause.data(), clauseSize);
+    oss.write(reinterpret_cast<const char *>(&emptySize), sizeof(emptySize));
+    oss.write(reinterpret_cast<const char *>(&emptySize), sizeof(emptySize));
+    oss.write(reinterpret_cast<const char *>(&mode), sizeof(mode));
+    std::string data = oss.str();
+
+    MessageParcel parcel;
+    parcel.WriteInt32(static_cast<int32_t>(data.size()));
+    parcel.WriteRawData(reinterpret_cast<const void *>(data.data()), data.size());
+    DataSharePredicates predicates;
+    ASSERT_TRUE(ITypesUtil::UnmarshalPredicates(predicates, parcel));
+    EXPECT_EQ(predicates.GetWhereClause(), whereClause);
+    EXPECT_EQ(predicates.GetSettingMode(), mode);
+    EXPECT_TRUE(predicates.GetOperationList().empty());
+    LOG_INFO("UnmarshalPredicates_LegacyLayout_001 ends");
+}
+
+/**
+* @tc.name: UnmarshalOperationStatementVec_FlatLayout_001
+* @tc.desc: Test the unmarshalling of OperationStatementVec whose flat data claims more items than it holds.
+* @tc.type: FUNC
+* @tc.require: issueNumber
+* @tc.precon: None
+* @tc.step:
+*    1. Marshal one OperationStatement, then raise the item count in the flat data.
+*    2. Call UnmarshalOperationStatementVec and verify the operation fails.
+* @tc.expect: The unmarshalling operation should fail without reading beyond the data.
+*/
+HWTEST_F(DatashareItypesUtilsTest, UnmarshalOperationStatementVec_FlatLayout_001, TestSize.Level0)
+{
+    LOG_INFO("UnmarshalOperationStatementVec_FlatLayout_001 starts");
+    OperationStatement statement;
+    statement.operationType = Operation::INSERT;
+    statement.uri = "datashare:///com.acts.datasharetest";
+    statement.valuesBucket = testBucket;
+    std::vector<OperationStatement> statements = { statement };
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypesUtil::MarshalOperationStatementVec(statements, parcel));
+
+    int32_t head = parcel.ReadInt32();
+    int32_t size = parcel.ReadInt32();
+    ASSERT_GT(size, static_cast<int32_t>(sizeof(uint32_t)));
+    const uint8_t *raw = reinterpret_cast<const uint8_t *>(parcel.ReadRawData(size));
+    ASSERT_NE(raw, nullptr);
+    std::vector<uint8_t> data(raw, raw + size);
+    uint32_t count = UINT32_MAX;
+    ASSERT_EQ(memcpy_s(data.data(), data.size(), &count, sizeof(count)), EOK);
+
+    MessageParcel corrupted;
+    corrupted.WriteInt32(head);
+    corrupted.WriteInt32(size);
+    corrupted.WriteRawData(reinterpret_cast<const void *>(data.data()), data.size());
+    std::vector<OperationStatement> result;
+    EXPECT_FALSE(ITypesUtil::UnmarshalOperationStatementVec(result, corrupted));
+    LOG_INFO("UnmarshalOperationStatementVec_FlatLayout_001 ends");
+}
+
+namespace {
+PublishedDataChangeNode CreatePublishedDataChangeNode(size_t blobCount)
+{
+    PublishedDataChangeNode changeNode;
+    changeNode.ownerBundleName_ = "com.acts.datasharetest";
+    for (size_t i = 0; i < blobCount; i++) {
+        std::vector<uint8_t> blob(i + 1, static_cast<uint8_t>(i));
+        changeNode.datas_.emplace_back("key" + std::to_string(i), i, blob);
+    }
+    changeNode.datas_.emplace_back("stringKey", blobCount, std::string("value"));
+    return changeNode;
+}
+} // namespace
+
+/**
+* @tc.name: PublishedDataChangeNode_Arena_001
+* @tc.desc: Test the blobs of a PublishedDataChangeNode are sent in one shared memory and read without copying.
+* @tc.type: FUNC
+* @tc.require: None
+* @tc.precon: None
+* @tc.step:
+*    1. Create a change node with three blob items and one string item and marshal it.
+*    2. Unmarshal the node and read the blob items with GetBlobSpan.
+* @tc.expect:
+*    1. The parcel carries one shared memory.
+*    2. The blob items are slices of one arena and hold the original data, the string item is kept.
+*/
+HWTEST_F(DatashareItypesUtilsTest, PublishedDataChangeNode_Arena_001, TestSize.Level0)
+{
+    LOG_INFO("PublishedDataChangeNode_Arena_001 starts");
+    PublishedDataChangeNode changeNode = CreatePublishedDataChangeNode(3);
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypesUtil::Marshal(parcel, changeNode));
+    EXPECT_EQ(parcel.GetOffsetsSize(), 1);
+
+    PublishedDataChangeNode result;
+    ASSERT_TRUE(ITypesUtil::Unmarshal(parcel, result));
+    EXPECT_EQ(result.ownerBundleName_, changeNode.ownerBundleName_);
+    ASSERT_EQ(result.datas_.size(), changeNode.datas_.size());
+    auto arena = std::get<AshmemNode>(result.datas_[0].value_).arena;
+    ASSERT_NE(arena, nullptr);
+    for (size_t i = 0; i < 3; i++) {
+        const PublishedDataItem &item = result.datas_[i];
+        EXPECT_EQ(item.key_, changeNode.datas_[i].key_);
+        ASSERT_TRUE(item.IsArena());
+        EXPECT_EQ(std::get<AshmemNode>(item.value_).arena, arena);
+        BlobSpan span = item.GetBlobSpan();
+        ASSERT_NE(span.data, nullptr);
+        EXPECT_EQ(std::vector<uint8_t>(span.data, span.data + span.size),
+            std::get<std::vector<uint8_t>>(changeNode.datas_[i].GetData()));
+    }
+    ASSERT_TRUE(result.datas_[3].IsString());
+    EXPECT_EQ(std::get<std::string>(result.datas_[3].GetData()), "value");
+    LOG_INFO("PublishedDataChangeNode_Arena_001 ends");
+}
+
+/**
+* @tc.name: PublishedDataChangeNode_Arena_002
+* @tc.desc: Test a packed node keeps its data, and a node with one blob still uses the legacy layout.
+* @tc.type: FUNC
+* @tc.require: None
+* @tc.precon: None
+* @tc.step:
+*    1. Pack the blobs of a change node, clone an item and move its ashmem out.
+*    2. Marshal and unmarshal a change node with one blob item.
+* @tc.expect:
+*    1. The clone shares the slice of the arena and an arena item has no ashmem to move out.
+*    2. The single blob is sent in its own shared memory and read back unchanged.
+*/
+HWTEST_F(DatashareItypesUtilsTest, PublishedDataChangeNode_Arena_002, TestSize.Level0)
+{
+    LOG_INFO("PublishedDataChangeNode_Arena_002 starts");
+    PublishedDataChangeNode packed = CreatePublishedDataChangeNode(2);
+    ASSERT_TRUE(packed.PackBlobs());
+    ASSERT_TRUE(packed.datas_[1].IsArena());
+    PublishedDataItem clone = packed.datas_[1].Clone();
+    EXPECT_EQ(std::get<AshmemNode>(clone.value_).arena, std::get<AshmemNode>(packed.datas_[1].value_).arena);
+    EXPECT_EQ(std::get<std::vector<uint8_t>>(clone.GetData()), std::vector<uint8_t>(2, 1));
+    EXPECT_EQ(clone.MoveOutAshmem(), nullptr);
+    EXPECT_TRUE(packed.datas_[2].IsString());
+
+    PublishedDataChangeNode changeNode = CreatePublishedDataChangeNode(1);
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypesUtil::Marshal(parcel, changeNode));
+    PublishedDataChangeNode result;
+    ASSERT_TRUE(ITypesUtil::Unmarshal(parcel, result));
+    ASSERT_EQ(result.datas_.size(), 2);
+    EXPECT_FALSE(result.datas_[0].IsArena());
+    EXPECT_EQ(std::get<std::vector<uint8_t>>(result.datas_[0].GetData()), std::vector<uint8_t>(1, 0));
+    LOG_INFO("PublishedDataChangeNode_Arena_002 ends");
+}
+
+/**
+* @tc.name: PublishedDataChangeNode_Arena_003
+* @tc.desc: Test the unmarshalling of an arena layout whose slice exceeds the shared memory.
+* @tc.type: FUNC
+* @tc.require: None
+* @tc.precon: None
+* @tc.step:
+*    1. Write an arena layout with a 4 bytes shared memory and a slice at offset 2 of size 4.
+*    2. Unmarshal it as a PublishedDataChangeNode.
+* @tc.expect: The unmarshalling operation should fail.
+*/
+HWTEST_F(DatashareItypesUtilsTest, PublishedDataChangeNode_Arena_003, TestSize.Level0)
+{
+    LOG_INFO("PublishedDataChangeNode_Arena_003 starts");
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem("PublishedDataArenaTest", 4);
+    ASSERT_NE(ashmem, nullptr);
+    MessageParcel parcel;
+    ASSERT_TRUE(ITypesUtil::Marshal(parcel, std::string("com.acts.datasharetest")));
+    parcel.WriteInt32(-1);
+    parcel.WriteAshmem(ashmem);
+    parcel.WriteInt32(1);
+    ASSERT_TRUE(ITypesUtil::Marshal(parcel, std::string("key"), static_cast<int64_t>(0)));
+    parcel.WriteInt32(0);
+    parcel.WriteUint32(2);
+    parcel.WriteUint32(4);
+    ashmem->CloseAshmem();
+
+    PublishedDataChangeNode result;
+    EXPECT_FALSE(ITypesUtil::Unmarshal(parcel, result));
+    LOG_INFO("PublishedDataChangeNode_Arena_003 ends");
+}
 }
 }
\ No newline at end of file
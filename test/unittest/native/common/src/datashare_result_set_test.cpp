@@ -17,18 +17,23 @@
 
 #include <gtest/gtest.h>
 #include <unistd.h>
+#include <algorithm>
+#include <limits>
 
+#include "datashare_block_writer_impl.h"
 #include "datashare_errno.h"
 #include "datashare_itypes_utils.h"
 #include "datashare_log.h"
 #include "datashare_abs_result_set.h"
 #include "datashare_result_set.h"
 #include "ikvstore_data_service.h"
+#include "ipc_skeleton.h"
 #include "ipc_types.h"
 #include "ishared_result_set_stub.h"
 #include "itypes_util.h"
 #include "message_parcel.h"
 #include "shared_block.h"
+#include "shared_block_pool.h"
 
 namespace OHOS {
 namespace DataShare {
@@ -43,6 +48,102 @@ public:
     void TearDown(){};
 };
 
+/**
+ * Serves rowCount rows holding their own index, at most windowRows rows per window.
+ */
+class WindowedBridge : public ResultSetBridge {
+public:
+    WindowedBridge(int rowCount, int windowRows) : rowCount_(rowCount), windowRows_(windowRows) {}
+
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "id" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        rowCountCalls_++;
+        count = rowCount_;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        if (startRowIndex >= failRow_) {
+            return -1;
+        }
+        int endRowIndex = std::min({ targetRowIndex, startRowIndex + windowRows_ - 1, rowCount_ - 1 });
+        for (int row = startRowIndex; row <= endRowIndex; row++) {
+            if (writer.AllocRow() != E_OK || writer.Write(0, static_cast<int64_t>(row)) != E_OK) {
+                return -1;
+            }
+        }
+        return endRowIndex;
+    }
+
+    int GetRowCountCalls() const
+    {
+        return rowCountCalls_;
+    }
+
+    // Fails the fills of windows starting at failRow or later.
+    void FailFrom(int failRow)
+    {
+        failRow_ = failRow;
+    }
+
+private:
+    int rowCount_;
+    int windowRows_;
+    int rowCountCalls_ = 0;
+    int failRow_ = std::numeric_limits<int>::max();
+};
+
+/**
+ * Serves rows holding a text, a blob, a number and a null, at most windowRows rows per window.
+ */
+class TextBridge : public ResultSetBridge {
+public:
+    TextBridge(int rowCount, int windowRows) : rowCount_(rowCount), windowRows_(windowRows) {}
+
+    static std::string GetText(int row)
+    {
+        return "text" + std::to_string(row);
+    }
+
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "text", "data", "id", "empty" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = rowCount_;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        int endRowIndex = std::min(targetRowIndex, startRowIndex + windowRows_ - 1);
+        for (int row = startRowIndex; row <= endRowIndex; row++) {
+            std::string text = GetText(row);
+            std::vector<uint8_t> data(text.begin(), text.end());
+            if (writer.AllocRow() != E_OK || writer.Write(0, text.c_str(), text.size() + 1) != E_OK ||
+                writer.Write(1, data.data(), data.size()) != E_OK ||
+                writer.Write(2, static_cast<int64_t>(row)) != E_OK || writer.Write(3) != E_OK) {
+                return -1;
+            }
+        }
+        return endRowIndex;
+    }
+
+private:
+    int rowCount_;
+    int windowRows_;
+};
+
 /**
  * @tc.name: GetDataTypeTest001
  * @tc.desc: Verify the behavior of the GetDataType function in DataShareResultSet when its 'sharedBlock_' member is
@@ -333,5 +434,517 @@ HWTEST_F(DatashareResultSetTest, Constructor003, TestSize.Level0)
     ASSERT_EQ(dataShareResultSet->blockWriter_, nullptr);
     LOG_INFO("DatashareResultSetTest Constructor003::End");
 }
+
+/**
+ * @tc.name: PrefetchTest001
+ * @tc.desc: Verify a sequential scan with the prefetch enabled reads every row and moves onto prefetched windows.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet whose bridge fills at most 100 rows per window and enable a prefetch of depth 2.
+ *     2. Go through all rows with GoToNextRow and read each of them.
+ * @tc.expect:
+ *     1. Every row holds its own index.
+ *     2. Only the first window is a miss, the other nine window moves are hits.
+ */
+HWTEST_F(DatashareResultSetTest, PrefetchTest001, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest PrefetchTest001::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(1000, 100);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    DataShareResultSet::PrefetchOption option;
+    option.depth = 2;
+    ASSERT_EQ(resultSet->EnablePrefetch(option), E_OK);
+    int64_t expected = 0;
+    while (resultSet->GoToNextRow() == E_OK) {
+        int64_t value = -1;
+        EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+        EXPECT_EQ(value, expected);
+        expected++;
+    }
+    EXPECT_EQ(expected, 1000);
+    auto statistics = resultSet->GetPrefetchStatistics();
+    EXPECT_EQ(statistics.misses, 1);
+    EXPECT_EQ(statistics.hits, 9);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest PrefetchTest001::End");
+}
+
+/**
+ * @tc.name: PrefetchTest002
+ * @tc.desc: Verify the backward-scroll window keeps the rows before a random target in the refilled window.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet whose bridge fills at most 100 rows per window and enable a prefetch keeping
+ *        10 rows backward.
+ *     2. Go to row 500, then go back to row 495.
+ * @tc.expect:
+ *     1. The move to row 500 is a miss whose window starts at row 490.
+ *     2. Row 495 is read from the same window without another window move.
+ */
+HWTEST_F(DatashareResultSetTest, PrefetchTest002, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest PrefetchTest002::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(1000, 100);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    DataShareResultSet::PrefetchOption option;
+    option.backwardRows = 10;
+    ASSERT_EQ(resultSet->EnablePrefetch(option), E_OK);
+    ASSERT_EQ(resultSet->GoToRow(500), E_OK);
+    EXPECT_EQ(resultSet->startRowPos_, 490);
+    ASSERT_EQ(resultSet->GoToRow(495), E_OK);
+    int64_t value = -1;
+    EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+    EXPECT_EQ(value, 495);
+    auto statistics = resultSet->GetPrefetchStatistics();
+    EXPECT_EQ(statistics.misses, 1);
+    EXPECT_EQ(statistics.hits, 0);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest PrefetchTest002::End");
+}
+
+/**
+ * @tc.name: PrefetchTest003
+ * @tc.desc: Verify the prefetch options are checked and a depth of 0 turns the prefetch off.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Enable the prefetch with a depth over the limit.
+ *     2. Enable the prefetch and move onto a prefetched window, then turn the prefetch off with a depth of 0.
+ *     3. Read the current row and go to the next one.
+ * @tc.expect:
+ *     1. The depth over the limit is rejected with E_ERROR.
+ *     2. After the prefetch is off the current row is still readable and the rows are read from the base block.
+ */
+HWTEST_F(DatashareResultSetTest, PrefetchTest003, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest PrefetchTest003::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(300, 100);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    DataShareResultSet::PrefetchOption option;
+    option.depth = 100;
+    EXPECT_EQ(resultSet->EnablePrefetch(option), E_ERROR);
+    option.depth = 1;
+    ASSERT_EQ(resultSet->EnablePrefetch(option), E_OK);
+    ASSERT_EQ(resultSet->GoToRow(150), E_OK);
+    ASSERT_EQ(resultSet->GoToRow(250), E_OK);
+    EXPECT_NE(resultSet->GetBlock(), resultSet->blockWriter_->GetBlock());
+    option.depth = 0;
+    ASSERT_EQ(resultSet->EnablePrefetch(option), E_OK);
+    EXPECT_EQ(resultSet->GetBlock(), resultSet->blockWriter_->GetBlock());
+    int64_t value = -1;
+    EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+    EXPECT_EQ(value, 250);
+    ASSERT_EQ(resultSet->GoToNextRow(), E_OK);
+    EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+    EXPECT_EQ(value, 251);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest PrefetchTest003::End");
+}
+
+/**
+ * @tc.name: GetStringViewTest001
+ * @tc.desc: Verify GetStringView and GetBlobSpan read the cells of the current row without copying them.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet whose bridge fills at most 100 rows of text, blob, number and null per window.
+ *     2. Go to row 150 and read every column with GetStringView and GetBlobSpan.
+ *     3. Let the cursor be single-threaded, go through all rows and compare the views with GetString and GetBlob.
+ * @tc.expect:
+ *     1. The text and blob views point into the block and hold the values of the row.
+ *     2. The number column is rejected by GetStringView, the null column is read as an empty view.
+ *     3. The views match the copied values on every row, across window moves.
+ */
+HWTEST_F(DatashareResultSetTest, GetStringViewTest001, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest GetStringViewTest001::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<TextBridge>(300, 100);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    std::string_view text;
+    EXPECT_EQ(resultSet->GetStringView(0, text), E_ERROR);
+    ASSERT_EQ(resultSet->GoToRow(150), E_OK);
+    ASSERT_EQ(resultSet->GetStringView(0, text), E_OK);
+    EXPECT_EQ(text, TextBridge::GetText(150));
+    auto block = resultSet->GetBlock();
+    auto begin = static_cast<const char *>(block->GetHeader());
+    EXPECT_TRUE(text.data() > begin && text.data() < begin + block->Size());
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+    ASSERT_EQ(resultSet->GetBlobSpan(1, data, size), E_OK);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::string(data, data + size), TextBridge::GetText(150));
+    EXPECT_EQ(resultSet->GetStringView(2, text), E_INVALID_OBJECT_TYPE);
+    EXPECT_EQ(resultSet->GetStringView(3, text), E_OK);
+    EXPECT_TRUE(text.empty());
+    EXPECT_EQ(resultSet->GetBlobSpan(3, data, size), E_OK);
+    EXPECT_EQ(data, nullptr);
+    EXPECT_EQ(resultSet->GetStringView(4, text), E_ERROR);
+
+    resultSet->SetSingleThreaded(true);
+    ASSERT_EQ(resultSet->GoToFirstRow(), E_OK);
+    int rows = 0;
+    do {
+        std::string value;
+        std::vector<uint8_t> blob;
+        ASSERT_EQ(resultSet->GetString(0, value), E_OK);
+        ASSERT_EQ(resultSet->GetStringView(0, text), E_OK);
+        EXPECT_EQ(text, value);
+        ASSERT_EQ(resultSet->GetBlob(1, blob), E_OK);
+        ASSERT_EQ(resultSet->GetBlobSpan(1, data, size), E_OK);
+        EXPECT_EQ(std::vector<uint8_t>(data, data + size), blob);
+        rows++;
+    } while (resultSet->GoToNextRow() == E_OK);
+    EXPECT_EQ(rows, 300);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest GetStringViewTest001::End");
+}
+
+/**
+ * @tc.name: GetRowsTest001
+ * @tc.desc: Verify GetRows fetches a range of rows across windows into typed column buffers.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet whose bridge fills at most 100 rows of text, blob, number and null per window.
+ *     2. Fetch 200 rows from row 50 with the text, the blob, the number as integer and as double, and the null.
+ *     3. Fetch 100 rows from row 250, then fetch a column out of range.
+ * @tc.expect:
+ *     1. All 200 rows are fetched with their values, and the cursor is on row 249.
+ *     2. Only the 50 remaining rows are fetched, and the column out of range fails with E_INVALID_COLUMN_INDEX.
+ */
+HWTEST_F(DatashareResultSetTest, GetRowsTest001, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest GetRowsTest001::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<TextBridge>(300, 100);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    std::vector<std::pair<int, DataType>> requests = { { 0, DataType::TYPE_STRING }, { 1, DataType::TYPE_BLOB },
+        { 2, DataType::TYPE_INTEGER }, { 2, DataType::TYPE_FLOAT }, { 3, DataType::TYPE_INTEGER } };
+    std::vector<DataShareResultSet::ColumnBuffer> columns(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        columns[i].columnIndex = requests[i].first;
+        columns[i].type = requests[i].second;
+    }
+    int fetchedRows = 0;
+    ASSERT_EQ(resultSet->GetRows(50, 200, columns, fetchedRows), E_OK);
+    ASSERT_EQ(fetchedRows, 200);
+    EXPECT_EQ(resultSet->rowPos_, 249);
+    ASSERT_EQ(columns[0].offsets.size(), 201);
+    ASSERT_EQ(columns[1].offsets.size(), 201);
+    ASSERT_EQ(columns[2].longs.size(), 200);
+    ASSERT_EQ(columns[3].doubles.size(), 200);
+    ASSERT_EQ(columns[4].nulls.size(), 200);
+    for (int i = 0; i < fetchedRows; i++) {
+        const auto &text = columns[0];
+        EXPECT_EQ(std::string(text.arena.begin() + text.offsets[i], text.arena.begin() + text.offsets[i + 1]),
+            TextBridge::GetText(i + 50));
+        const auto &data = columns[1];
+        EXPECT_EQ(std::string(data.arena.begin() + data.offsets[i], data.arena.begin() + data.offsets[i + 1]),
+            TextBridge::GetText(i + 50));
+        EXPECT_EQ(columns[2].longs[i], i + 50);
+        EXPECT_EQ(columns[3].doubles[i], i + 50);
+        EXPECT_EQ(columns[2].nulls[i], 0);
+        EXPECT_EQ(columns[4].longs[i], 0);
+        EXPECT_EQ(columns[4].nulls[i], 1);
+    }
+
+    ASSERT_EQ(resultSet->GetRows(250, 100, columns, fetchedRows), E_OK);
+    EXPECT_EQ(fetchedRows, 50);
+    EXPECT_EQ(columns[2].longs.size(), 50);
+    EXPECT_EQ(columns[2].longs.back(), 299);
+    columns[0].columnIndex = 4;
+    EXPECT_EQ(resultSet->GetRows(0, 1, columns, fetchedRows), E_INVALID_COLUMN_INDEX);
+    EXPECT_EQ(fetchedRows, 0);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest GetRowsTest001::End");
+}
+
+/**
+ * @tc.name: BlockPoolTest001
+ * @tc.desc: Verify the block of a closed result set is reused by the next one, and a block handed to a process is
+ *           only reused for that process.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a result set, close it, then create another one.
+ *     2. Marshal the second result set and close it, then create a third one and marshal it before reading.
+ * @tc.expect:
+ *     1. The second result set gets the block of the first one.
+ *     2. The third result set gets a new block, which is swapped for the block handed to the process on marshalling.
+ */
+HWTEST_F(DatashareResultSetTest, BlockPoolTest001, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest BlockPoolTest001::Start");
+    SharedBlockPool::GetInstance().Trim();
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(10, 10);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    ASSERT_NE(resultSet->sharedBlock_, nullptr);
+    AppDataFwk::SharedBlock *block = resultSet->sharedBlock_.get();
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    EXPECT_EQ(SharedBlockPool::GetInstance().GetIdleBytes(), DEFAULT_SHARE_BLOCK_SIZE);
+
+    resultSet = std::make_shared<DataShareResultSet>(bridge);
+    EXPECT_EQ(resultSet->sharedBlock_.get(), block);
+    MessageParcel parcel;
+    EXPECT_TRUE(resultSet->Marshalling(parcel));
+    EXPECT_EQ(resultSet->blockOwner_,
+        SharedBlockPool::GetOwner(IPCSkeleton::GetCallingPid(), IPCSkeleton::GetCallingTokenID()));
+    EXPECT_EQ(resultSet->Close(), E_OK);
+
+    resultSet = std::make_shared<DataShareResultSet>(bridge);
+    EXPECT_NE(resultSet->sharedBlock_.get(), block);
+    MessageParcel otherParcel;
+    EXPECT_TRUE(resultSet->Marshalling(otherParcel));
+    EXPECT_EQ(resultSet->sharedBlock_.get(), block);
+    EXPECT_EQ(resultSet->GoToFirstRow(), E_OK);
+    int64_t value = -1;
+    EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    SharedBlockPool::GetInstance().Trim();
+    LOG_INFO("DatashareResultSetTest BlockPoolTest001::End");
+}
+
+/**
+ * @tc.name: AdaptiveWindowTest001
+ * @tc.desc: Verify the adaptive window grows over a sequential scan within its bounds and starts over on a random move.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet of 20000 rows and enable the adaptive window for 100 to 1600 rows per window and
+ *        blocks of 64KB to 1MB.
+ *     2. Go through all rows with GoToNextRow and read each of them.
+ *     3. Go to row 100.
+ * @tc.expect:
+ *     1. Every row holds its own index, read from 16 windows of 100, 200, 400, 800 and then 1600 rows.
+ *     2. The blocks stay within the bounds and the narrow rows end up in a block of the lower bound.
+ *     3. The window of the random move holds 100 rows again.
+ */
+HWTEST_F(DatashareResultSetTest, AdaptiveWindowTest001, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest AdaptiveWindowTest001::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(20000, 20000);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    DataShareResultSet::AdaptiveWindowOption option;
+    option.minBlockSize = 64 * 1024;
+    option.maxBlockSize = 1024 * 1024;
+    option.minRows = 100;
+    option.maxRows = 1600;
+    ASSERT_EQ(resultSet->EnableAdaptiveWindow(option), E_OK);
+    int64_t expected = 0;
+    while (resultSet->GoToNextRow() == E_OK) {
+        int64_t value = -1;
+        EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+        EXPECT_EQ(value, expected);
+        expected++;
+    }
+    EXPECT_EQ(expected, 20000);
+    auto statistics = resultSet->GetAdaptiveWindowStatistics();
+    EXPECT_EQ(statistics.refills, 16);
+    EXPECT_EQ(statistics.rows, 20000);
+    EXPECT_GT(statistics.rowBytes, 0);
+    EXPECT_LE(statistics.peakBlockSize, option.maxBlockSize);
+    EXPECT_EQ(statistics.blockSize, option.minBlockSize);
+
+    ASSERT_EQ(resultSet->GoToRow(100), E_OK);
+    EXPECT_EQ(resultSet->startRowPos_, 100);
+    EXPECT_EQ(resultSet->endRowPos_, 199);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest AdaptiveWindowTest001::End");
+}
+
+/**
+ * @tc.name: AdaptiveWindowTest002
+ * @tc.desc: Verify the adaptive window options are checked and the adaptive window excludes the prefetch.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Enable the adaptive window with a block bound over the limit, and with no rows.
+ *     2. Enable the adaptive window, then enable the prefetch.
+ * @tc.expect:
+ *     1. The invalid options are rejected with E_ERROR.
+ *     2. The prefetch is rejected with E_ERROR.
+ */
+HWTEST_F(DatashareResultSetTest, AdaptiveWindowTest002, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest AdaptiveWindowTest002::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(100, 100);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    DataShareResultSet::AdaptiveWindowOption option;
+    option.maxBlockSize = 64 * 1024 * 1024;
+    EXPECT_EQ(resultSet->EnableAdaptiveWindow(option), E_ERROR);
+    option = {};
+    option.minRows = 0;
+    EXPECT_EQ(resultSet->EnableAdaptiveWindow(option), E_ERROR);
+
+    ASSERT_EQ(resultSet->EnableAdaptiveWindow({}), E_OK);
+    DataShareResultSet::PrefetchOption prefetchOption;
+    prefetchOption.depth = 1;
+    EXPECT_EQ(resultSet->EnablePrefetch(prefetchOption), E_ERROR);
+    EXPECT_EQ(resultSet->GoToFirstRow(), E_OK);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest AdaptiveWindowTest002::End");
+}
+
+/**
+ * @tc.name: StreamTest001
+ * @tc.desc: Verify a streaming cursor scans all rows in pages without the row count and learns it at the end.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet of 1000 rows and enable streaming with pages of 50 rows.
+ *     2. Go through all rows with GoToNextRow and read each of them.
+ *     3. Get the row count and check whether the cursor ended.
+ * @tc.expect:
+ *     1. Every row holds its own index, the first window holds 50 rows and the provider is never asked to count.
+ *     2. The row count is 1000 and the cursor ended, still without asking the provider.
+ */
+HWTEST_F(DatashareResultSetTest, StreamTest001, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest StreamTest001::Start");
+    auto bridge = std::make_shared<WindowedBridge>(1000, 1000);
+    std::shared_ptr<ResultSetBridge> baseBridge = bridge;
+    auto resultSet = std::make_shared<DataShareResultSet>(baseBridge);
+    DataShareResultSet::StreamOption option;
+    option.pageRows = 50;
+    ASSERT_EQ(resultSet->EnableStreaming(option), E_OK);
+    ASSERT_EQ(resultSet->GoToFirstRow(), E_OK);
+    EXPECT_EQ(resultSet->endRowPos_, 49);
+    int64_t expected = 0;
+    do {
+        int64_t value = -1;
+        EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+        EXPECT_EQ(value, expected);
+        expected++;
+    } while (resultSet->GoToNextRow() == E_OK);
+    EXPECT_EQ(expected, 1000);
+    EXPECT_EQ(bridge->GetRowCountCalls(), 0);
+
+    int count = 0;
+    EXPECT_EQ(resultSet->GetRowCount(count), E_OK);
+    EXPECT_EQ(count, 1000);
+    bool ended = false;
+    EXPECT_EQ(resultSet->IsEnded(ended), E_OK);
+    EXPECT_TRUE(ended);
+    EXPECT_EQ(bridge->GetRowCountCalls(), 0);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest StreamTest001::End");
+}
+
+/**
+ * @tc.name: StreamTest002
+ * @tc.desc: Verify a streaming cursor stops at its row budget.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet of 1000 rows and enable streaming with a budget of 120 rows.
+ *     2. Go through the rows with GoToNextRow, then go to row 500.
+ *     3. Get the row count.
+ * @tc.expect:
+ *     1. The scan ends after 120 rows and row 500 is out of range.
+ *     2. The row count is capped to 120.
+ */
+HWTEST_F(DatashareResultSetTest, StreamTest002, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest StreamTest002::Start");
+    auto bridge = std::make_shared<WindowedBridge>(1000, 1000);
+    std::shared_ptr<ResultSetBridge> baseBridge = bridge;
+    auto resultSet = std::make_shared<DataShareResultSet>(baseBridge);
+    DataShareResultSet::StreamOption option;
+    option.rowBudget = 120;
+    ASSERT_EQ(resultSet->EnableStreaming(option), E_OK);
+    int rows = 0;
+    while (resultSet->GoToNextRow() == E_OK) {
+        rows++;
+    }
+    EXPECT_EQ(rows, 120);
+    EXPECT_EQ(resultSet->GoToRow(500), E_ERROR);
+
+    int count = 0;
+    EXPECT_EQ(resultSet->GetRowCount(count), E_OK);
+    EXPECT_EQ(count, 120);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest StreamTest002::End");
+}
+
+/**
+ * @tc.name: StreamTest003
+ * @tc.desc: Verify a streaming cursor takes a failed fill as an error, not as the end of the result set.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet of 1000 rows, enable streaming with pages of 50 rows and fail the fills from
+ *        row 100 on.
+ *     2. Go through the rows with GoToNextRow, then get the row count.
+ *     3. Let the fills succeed again and go to row 100.
+ * @tc.expect:
+ *     1. The scan stops after 100 rows, the cursor did not learn a row count and the row count is still 1000.
+ *     2. Row 100 is read once the fills succeed.
+ */
+HWTEST_F(DatashareResultSetTest, StreamTest003, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest StreamTest003::Start");
+    auto bridge = std::make_shared<WindowedBridge>(1000, 1000);
+    std::shared_ptr<ResultSetBridge> baseBridge = bridge;
+    auto resultSet = std::make_shared<DataShareResultSet>(baseBridge);
+    DataShareResultSet::StreamOption option;
+    option.pageRows = 50;
+    ASSERT_EQ(resultSet->EnableStreaming(option), E_OK);
+    bridge->FailFrom(100);
+    int rows = 0;
+    while (resultSet->GoToNextRow() == E_OK) {
+        rows++;
+    }
+    EXPECT_EQ(rows, 100);
+    int count = 0;
+    EXPECT_FALSE(resultSet->GetStreamedRowCount(count));
+    EXPECT_EQ(resultSet->GetRowCount(count), E_OK);
+    EXPECT_EQ(count, 1000);
+
+    bridge->FailFrom(std::numeric_limits<int>::max());
+    ASSERT_EQ(resultSet->GoToRow(100), E_OK);
+    int64_t value = -1;
+    EXPECT_EQ(resultSet->GetLong(0, value), E_OK);
+    EXPECT_EQ(value, 100);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest StreamTest003::End");
+}
+
+/**
+ * @tc.name: StreamTest004
+ * @tc.desc: Verify GetRows of a streaming cursor stops at the end of the result set it finds on the way.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.step:
+ *     1. Create a DataShareResultSet of 1000 rows and enable streaming with pages of 50 rows.
+ *     2. Get 200 rows from row 900, then 10 rows from row 1000.
+ * @tc.expect:
+ *     1. The first GetRows succeeds with the 100 rows from 900 to 999.
+ *     2. The second GetRows succeeds without rows.
+ */
+HWTEST_F(DatashareResultSetTest, StreamTest004, TestSize.Level0)
+{
+    LOG_INFO("DatashareResultSetTest StreamTest004::Start");
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<WindowedBridge>(1000, 1000);
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge);
+    DataShareResultSet::StreamOption option;
+    option.pageRows = 50;
+    ASSERT_EQ(resultSet->EnableStreaming(option), E_OK);
+    std::vector<DataShareResultSet::ColumnBuffer> columns(1);
+    columns[0].columnIndex = 0;
+    columns[0].type = DataType::TYPE_INTEGER;
+    int fetchedRows = 0;
+    ASSERT_EQ(resultSet->GetRows(900, 200, columns, fetchedRows), E_OK);
+    ASSERT_EQ(fetchedRows, 100);
+    ASSERT_EQ(columns[0].longs.size(), 100);
+    EXPECT_EQ(columns[0].longs.front(), 900);
+    EXPECT_EQ(columns[0].longs.back(), 999);
+
+    EXPECT_EQ(resultSet->GetRows(1000, 10, columns, fetchedRows), E_OK);
+    EXPECT_EQ(fetchedRows, 0);
+    EXPECT_EQ(resultSet->Close(), E_OK);
+    LOG_INFO("DatashareResultSetTest StreamTest004::End");
+}
 }
 }
\ No newline at end of file
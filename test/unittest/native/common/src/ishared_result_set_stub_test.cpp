@@ -18,6 +18,10 @@
 #include <gtest/gtest.h>
 #include <unistd.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cinttypes>
+#include <functional>
+#include <map>
 
 #include "datashare_errno.h"
 #include "datashare_itypes_utils.h"
@@ -26,9 +30,11 @@
 #include "datashare_result_set.h"
 #include "ikvstore_data_service.h"
 #include "ipc_types.h"
+#include "ishared_result_set_proxy.h"
 #include "ishared_result_set_stub.h"
 #include "itypes_util.h"
 #include "message_parcel.h"
+#include "shared_block.h"
 
 namespace OHOS {
 namespace DataShare {
@@ -59,6 +65,169 @@ public:
     }
 };
 
+namespace {
+constexpr int BLOB_ROW_COUNT = 2000;
+constexpr size_t BLOB_SIZE = 1024;
+constexpr size_t WINDOW_BLOCK_SIZE = 64 * 1024;
+}
+
+/**
+ * Serves rows of their own index and a 1KB blob, as many as the block holds.
+ */
+class BlobBridge : public OHOS::DataShare::ResultSetBridge {
+public:
+    int GetAllColumnNames(std::vector<std::string> &columnNames) override
+    {
+        columnNames = { "id", "data" };
+        return E_OK;
+    }
+
+    int GetRowCount(int32_t &count) override
+    {
+        count = BLOB_ROW_COUNT;
+        return E_OK;
+    }
+
+    int OnGo(int32_t startRowIndex, int32_t targetRowIndex, Writer &writer) override
+    {
+        if (onFill != nullptr) {
+            onFill();
+        }
+        std::vector<uint8_t> blob(BLOB_SIZE, 'b');
+        for (int row = startRowIndex; row <= targetRowIndex; row++) {
+            if (writer.AllocRow() != E_OK) {
+                return row - 1;
+            }
+            if (writer.Write(0, static_cast<int64_t>(row)) != E_OK ||
+                writer.Write(1, blob.data(), blob.size()) != E_OK) {
+                writer.FreeLastRow();
+                return row - 1;
+            }
+        }
+        return targetRowIndex;
+    }
+
+    // Runs at the start of each fill, while the provider writes the rows.
+    std::function<void()> onFill;
+};
+
+/**
+ * Hands the requests of ISharedResultSetProxy to a stub in process and counts them by code.
+ */
+class ResultSetLoopback : public IRemoteObject {
+public:
+    explicit ResultSetLoopback(sptr<ISharedResultSetStub> stub)
+        : IRemoteObject(u"OHOS.DataShare.ISharedResultSet"), stub_(stub) {}
+
+    int32_t GetObjectRefCount() override
+    {
+        return 0;
+    }
+
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            counts_[code]++;
+            if (code >= rejectedCode_) {
+                return IPC_STUB_UNKNOW_TRANS_ERR;
+            }
+            if (code == failedCode_) {
+                failedCode_ = static_cast<uint32_t>(ResultCode::FUNC_BUTT);
+                return ERR_DEAD_OBJECT;
+            }
+        }
+        return stub_->OnRemoteRequest(code, data, reply, option);
+    }
+
+    bool AddDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    bool RemoveDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        return true;
+    }
+
+    int Dump(int fd, const std::vector<std::u16string> &args) override
+    {
+        return 0;
+    }
+
+    size_t GetCount(ResultCode code)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return counts_[static_cast<uint32_t>(code)];
+    }
+
+    // Rejects the codes from code on, like a provider built before them.
+    void RejectFrom(ResultCode code)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rejectedCode_ = static_cast<uint32_t>(code);
+    }
+
+    // Fails the next request of code, like a provider that died during the request.
+    void FailNext(ResultCode code)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failedCode_ = static_cast<uint32_t>(code);
+    }
+
+private:
+    sptr<ISharedResultSetStub> stub_;
+    std::mutex mutex_;
+    std::map<uint32_t, size_t> counts_;
+    uint32_t rejectedCode_ = static_cast<uint32_t>(ResultCode::FUNC_BUTT);
+    uint32_t failedCode_ = static_cast<uint32_t>(ResultCode::FUNC_BUTT);
+};
+
+/**
+ * Marshals a result set of BlobBridge rows in 64KB blocks and reads it back as a proxy over the loopback.
+ */
+sptr<ISharedResultSetProxy> CreateLoopbackProxy(sptr<ResultSetLoopback> &loopback,
+    std::shared_ptr<ResultSetBridge> bridge = std::make_shared<BlobBridge>())
+{
+    auto resultSet = std::make_shared<DataShareResultSet>(bridge, WINDOW_BLOCK_SIZE);
+    loopback = new ResultSetLoopback(new ISharedResultSetStub(resultSet));
+    MessageParcel parcel;
+    if (!resultSet->Marshalling(parcel)) {
+        return nullptr;
+    }
+    sptr<ISharedResultSetProxy> proxy = new ISharedResultSetProxy(loopback);
+    if (!proxy->Unmarshalling(parcel)) {
+        return nullptr;
+    }
+    return proxy;
+}
+
+/**
+ * Scans all rows of the proxy with a prefetch of the given depth, returns the fill transactions or 0 on a wrong row.
+ */
+size_t ScanWithPrefetch(uint32_t depth)
+{
+    sptr<ResultSetLoopback> loopback;
+    auto proxy = CreateLoopbackProxy(loopback);
+    DataShareResultSet::PrefetchOption option;
+    option.depth = depth;
+    if (proxy == nullptr || proxy->EnablePrefetch(option) != E_OK) {
+        return 0;
+    }
+    int64_t expected = 0;
+    while (proxy->GoToNextRow() == E_OK) {
+        int64_t value = -1;
+        if (proxy->GetLong(0, value) != E_OK || value != expected) {
+            return 0;
+        }
+        expected++;
+    }
+    proxy->Close();
+    LOG_INFO("depth %{public}u, rows %{public}" PRIi64 ", OnGo %{public}zu, FillWindows %{public}zu", depth, expected,
+        loopback->GetCount(ResultCode::FUNC_ON_GO), loopback->GetCount(ResultCode::FUNC_FILL_WINDOWS));
+    return expected == BLOB_ROW_COUNT ? loopback->GetCount(ResultCode::FUNC_FILL_WINDOWS) : 0;
+}
+
 /**
  * @tc.name: CreateStubTestTest001
  * @tc.desc: Test the CreateStub function of ISharedResultSetStub when its internal 'resultset_' member is set to
@@ -404,5 +573,193 @@ HWTEST_F(IsharedResultSetStubTest, ResultSetStubNull_Test_001, TestSize.Level0)
     EXPECT_EQ(resultSet, nullptr);
     LOG_INFO("IsharedResultSetStubTest ResultSetStubNull_Test_001::End");
 }
+
+/**
+ * @tc.name: FillWindowsTest001
+ * @tc.desc: Verify FillWindows of the proxy fills several blocks in one transaction with consecutive rows.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a proxy whose requests go to a stub in process, on a result set of 2000 rows of 1KB.
+    2. Fill 4 blocks of 64KB from row 0 with FillWindows.
+    3. Fill more blocks than MAX_FILL_WINDOWS.
+ * @tc.expect:
+    1. The 4 blocks are filled in one FUNC_FILL_WINDOWS transaction, each block going on from the row after the last
+       row of the previous one.
+    2. Too many blocks are rejected without a transaction.
+ */
+HWTEST_F(IsharedResultSetStubTest, FillWindowsTest001, TestSize.Level0)
+{
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest001::Start");
+    sptr<ResultSetLoopback> loopback;
+    auto proxy = CreateLoopbackProxy(loopback);
+    ASSERT_NE(proxy, nullptr);
+    std::vector<std::shared_ptr<AppDataFwk::SharedBlock>> blocks;
+    for (int i = 0; i < 4; i++) {
+        AppDataFwk::SharedBlock *block = nullptr;
+        ASSERT_EQ(AppDataFwk::SharedBlock::Create("FillWindowsTest001", WINDOW_BLOCK_SIZE, block),
+            AppDataFwk::SharedBlock::SHARED_BLOCK_OK);
+        blocks.emplace_back(block);
+    }
+    std::vector<int> endRows;
+    ASSERT_TRUE(proxy->FillWindows(0, BLOB_ROW_COUNT - 1, blocks, endRows));
+    ASSERT_EQ(endRows.size(), blocks.size());
+    EXPECT_EQ(loopback->GetCount(ResultCode::FUNC_FILL_WINDOWS), 1);
+    int startRow = 0;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        ASSERT_GT(endRows[i], startRow);
+        EXPECT_EQ(blocks[i]->GetRowNum(), static_cast<uint32_t>(endRows[i] - startRow + 1));
+        auto cell = blocks[i]->GetCellUnit(0, 0);
+        ASSERT_NE(cell, nullptr);
+        EXPECT_EQ(cell->cell.longValue, startRow);
+        startRow = endRows[i] + 1;
+    }
+
+    blocks.resize(DataShareResultSet::MAX_FILL_WINDOWS + 1, blocks.front());
+    EXPECT_FALSE(proxy->FillWindows(0, BLOB_ROW_COUNT - 1, blocks, endRows));
+    EXPECT_EQ(loopback->GetCount(ResultCode::FUNC_FILL_WINDOWS), 1);
+    proxy->Close();
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest001::End");
+}
+
+/**
+ * @tc.name: FillWindowsTest002
+ * @tc.desc: Verify the prefetch of a proxy fills the free windows of its ring in one transaction.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Scan a proxy whose requests go to a stub in process with a prefetch of depth 1.
+    2. Scan it again with a prefetch of depth 4.
+ * @tc.expect:
+    1. Both scans read every row.
+    2. The scan with depth 4 takes fewer FUNC_FILL_WINDOWS transactions than the one with depth 1.
+ */
+HWTEST_F(IsharedResultSetStubTest, FillWindowsTest002, TestSize.Level0)
+{
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest002::Start");
+    size_t singleFills = ScanWithPrefetch(1);
+    size_t batchFills = ScanWithPrefetch(DataShareResultSet::MAX_PREFETCH_DEPTH);
+    EXPECT_GT(singleFills, 0);
+    EXPECT_GT(batchFills, 0);
+    EXPECT_LT(batchFills, singleFills);
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest002::End");
+}
+
+/**
+ * @tc.name: FillWindowsTest003
+ * @tc.desc: Verify a proxy whose provider rejects the fill requests falls back to OnGo.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a proxy whose requests go to a stub in process rejecting FUNC_FILL_WINDOW and FUNC_FILL_WINDOWS.
+    2. Scan it with a prefetch of depth 4, then scan another such proxy with the adaptive window.
+ * @tc.expect:
+    1. Both scans read every row with OnGo.
+    2. Each proxy sends at most one fill request.
+ */
+HWTEST_F(IsharedResultSetStubTest, FillWindowsTest003, TestSize.Level0)
+{
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest003::Start");
+    for (int adaptive = 0; adaptive < 2; adaptive++) {
+        sptr<ResultSetLoopback> loopback;
+        auto proxy = CreateLoopbackProxy(loopback);
+        ASSERT_NE(proxy, nullptr);
+        loopback->RejectFrom(ResultCode::FUNC_FILL_WINDOW);
+        DataShareResultSet::PrefetchOption option;
+        option.depth = DataShareResultSet::MAX_PREFETCH_DEPTH;
+        ASSERT_EQ(adaptive != 0 ? proxy->EnableAdaptiveWindow({}) : proxy->EnablePrefetch(option), E_OK);
+        int64_t expected = 0;
+        while (proxy->GoToNextRow() == E_OK) {
+            int64_t value = -1;
+            ASSERT_EQ(proxy->GetLong(0, value), E_OK);
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+        EXPECT_EQ(expected, BLOB_ROW_COUNT);
+        EXPECT_GT(loopback->GetCount(ResultCode::FUNC_ON_GO), 0);
+        EXPECT_LE(loopback->GetCount(ResultCode::FUNC_FILL_WINDOW) +
+            loopback->GetCount(ResultCode::FUNC_FILL_WINDOWS), 1);
+        proxy->Close();
+    }
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest003::End");
+}
+
+/**
+ * @tc.name: FillWindowsTest004
+ * @tc.desc: Verify the provider fills the rows of a window without writing through its header, which the consumer
+ *           can change during the fill.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a proxy whose requests go to a stub in process, on a result set of 2000 rows of 1KB.
+    2. Fill a block of 64KB from row 0 with FillWindow, overwriting the header of the block while the rows are
+       written.
+ * @tc.expect:
+    1. The block holds the rows from row 0 on.
+ */
+HWTEST_F(IsharedResultSetStubTest, FillWindowsTest004, TestSize.Level0)
+{
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest004::Start");
+    sptr<ResultSetLoopback> loopback;
+    auto bridge = std::make_shared<BlobBridge>();
+    auto proxy = CreateLoopbackProxy(loopback, bridge);
+    ASSERT_NE(proxy, nullptr);
+    AppDataFwk::SharedBlock *raw = nullptr;
+    ASSERT_EQ(AppDataFwk::SharedBlock::Create("FillWindowsTest004", WINDOW_BLOCK_SIZE, raw),
+        AppDataFwk::SharedBlock::SHARED_BLOCK_OK);
+    std::shared_ptr<AppDataFwk::SharedBlock> block(raw);
+    bridge->onFill = [block]() {
+        auto header = static_cast<uint8_t *>(const_cast<void *>(block->GetHeader()));
+        std::fill_n(header, sizeof(uint32_t) * 8, 0xff);
+    };
+    int endRow = -1;
+    ASSERT_TRUE(proxy->FillWindow(0, BLOB_ROW_COUNT - 1, block, endRow));
+    bridge->onFill = nullptr;
+    ASSERT_GT(endRow, 0);
+    EXPECT_EQ(block->GetRowNum(), static_cast<uint32_t>(endRow + 1));
+    auto cell = block->GetCellUnit(static_cast<uint32_t>(endRow), 0);
+    ASSERT_NE(cell, nullptr);
+    EXPECT_EQ(cell->cell.longValue, endRow);
+    proxy->Close();
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest004::End");
+}
+
+/**
+ * @tc.name: FillWindowsTest005
+ * @tc.desc: Verify a fill request failing for another reason than an unknown code only fails that request.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a proxy whose requests go to a stub in process, failing the next FUNC_FILL_WINDOW with
+       ERR_DEAD_OBJECT.
+    2. Fill a block of 64KB from row 0 with FillWindow twice.
+ * @tc.expect:
+    1. The first fill fails, the proxy still fills windows and the second fill succeeds.
+ */
+HWTEST_F(IsharedResultSetStubTest, FillWindowsTest005, TestSize.Level0)
+{
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest005::Start");
+    sptr<ResultSetLoopback> loopback;
+    auto proxy = CreateLoopbackProxy(loopback);
+    ASSERT_NE(proxy, nullptr);
+    AppDataFwk::SharedBlock *raw = nullptr;
+    ASSERT_EQ(AppDataFwk::SharedBlock::Create("FillWindowsTest005", WINDOW_BLOCK_SIZE, raw),
+        AppDataFwk::SharedBlock::SHARED_BLOCK_OK);
+    std::shared_ptr<AppDataFwk::SharedBlock> block(raw);
+    loopback->FailNext(ResultCode::FUNC_FILL_WINDOW);
+    int endRow = -1;
+    EXPECT_FALSE(proxy->FillWindow(0, BLOB_ROW_COUNT - 1, block, endRow));
+    EXPECT_TRUE(proxy->CanFillWindow());
+    EXPECT_TRUE(proxy->FillWindow(0, BLOB_ROW_COUNT - 1, block, endRow));
+    EXPECT_GT(endRow, 0);
+    EXPECT_EQ(loopback->GetCount(ResultCode::FUNC_FILL_WINDOW), 2);
+    proxy->Close();
+    LOG_INFO("IsharedResultSetStubTest FillWindowsTest005::End");
+}
 }
 }
\ No newline at end of file
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "shared_block_pool_test"
+
+#include "shared_block_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+using namespace AppDataFwk;
+class SharedBlockPoolTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp()
+    {
+        SharedBlockPool::GetInstance().SetMaxIdleBytes(SharedBlockPool::DEFAULT_MAX_IDLE_BYTES);
+        SharedBlockPool::GetInstance().Trim();
+    };
+    void TearDown()
+    {
+        SharedBlockPool::GetInstance().SetMaxIdleBytes(SharedBlockPool::DEFAULT_MAX_IDLE_BYTES);
+        SharedBlockPool::GetInstance().Trim();
+    };
+};
+
+namespace {
+constexpr size_t BLOCK_SIZE = 64 * 1024;
+constexpr int32_t OWNER = 100;
+
+bool Contains(const std::shared_ptr<SharedBlock> &block, const std::string &value)
+{
+    auto begin = static_cast<const char *>(block->GetHeader());
+    auto end = begin + block->Size();
+    return std::search(begin, end, value.begin(), value.end()) != end;
+}
+} // namespace
+
+/**
+ * @tc.name: SharedBlockPool_Recycle_001
+ * @tc.desc: Verify a recycled block is handed out cleared to the next acquire of its size and owner only.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Acquire a block, write a row to it and recycle it without owner.
+    2. Acquire a block of the size without owner, then recycle it with an owner.
+    3. Acquire a block of another owner, then of the owner.
+    4. Recycle a block still referenced elsewhere.
+ * @tc.expect:
+    1. The second acquire returns the recycled block without rows.
+    2. The block is only returned to its owner, another owner gets a new block.
+    3. A block still referenced is not kept.
+ */
+HWTEST_F(SharedBlockPoolTest, SharedBlockPool_Recycle_001, TestSize.Level0)
+{
+    LOG_INFO("SharedBlockPool_Recycle_001::Start");
+    auto &pool = SharedBlockPool::GetInstance();
+    auto block = pool.Acquire(BLOCK_SIZE);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->Clear(), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_EQ(block->SetColumnNum(1), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_EQ(block->AllocRow(), SharedBlock::SHARED_BLOCK_OK);
+    SharedBlock *raw = block.get();
+    pool.Recycle(std::move(block), BLOCK_SIZE, SharedBlockPool::NO_OWNER);
+    EXPECT_EQ(pool.GetIdleBytes(), BLOCK_SIZE);
+
+    block = pool.Acquire(BLOCK_SIZE);
+    ASSERT_EQ(block.get(), raw);
+    EXPECT_EQ(block->GetRowNum(), 0);
+    EXPECT_EQ(pool.GetIdleBytes(), 0);
+
+    pool.Recycle(std::move(block), BLOCK_SIZE, OWNER);
+    EXPECT_EQ(pool.TakeIdle(BLOCK_SIZE, SharedBlockPool::NO_OWNER), nullptr);
+    EXPECT_EQ(pool.TakeIdle(BLOCK_SIZE, OWNER + 1), nullptr);
+    auto other = pool.Acquire(BLOCK_SIZE, OWNER + 1);
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other.get(), raw);
+    block = pool.Acquire(BLOCK_SIZE, OWNER);
+    EXPECT_EQ(block.get(), raw);
+
+    auto reader = block;
+    pool.Recycle(std::move(block), BLOCK_SIZE, OWNER);
+    EXPECT_EQ(pool.GetIdleBytes(), 0);
+    LOG_INFO("SharedBlockPool_Recycle_001::End");
+}
+
+/**
+ * @tc.name: SharedBlockPool_Trim_001
+ * @tc.desc: Verify the idle blocks stay under the max idle bytes and are released by Trim.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Set the max idle bytes to 2 blocks and recycle 3 blocks.
+    2. Trim the pool to 1 block, then to nothing.
+ * @tc.expect:
+    1. Only the 2 most recently recycled blocks are kept.
+    2. The idle bytes follow each trim.
+ */
+HWTEST_F(SharedBlockPoolTest, SharedBlockPool_Trim_001, TestSize.Level0)
+{
+    LOG_INFO("SharedBlockPool_Trim_001::Start");
+    auto &pool = SharedBlockPool::GetInstance();
+    pool.SetMaxIdleBytes(2 * BLOCK_SIZE);
+    std::vector<std::shared_ptr<SharedBlock>> blocks;
+    for (int i = 0; i < 3; i++) {
+        blocks.push_back(pool.Acquire(BLOCK_SIZE));
+        ASSERT_NE(blocks.back(), nullptr);
+    }
+    SharedBlock *last = blocks.back().get();
+    for (auto &block : blocks) {
+        pool.Recycle(std::move(block), BLOCK_SIZE, SharedBlockPool::NO_OWNER);
+    }
+    EXPECT_EQ(pool.GetIdleBytes(), 2 * BLOCK_SIZE);
+
+    pool.Trim(BLOCK_SIZE);
+    EXPECT_EQ(pool.GetIdleBytes(), BLOCK_SIZE);
+    auto block = pool.TakeIdle(BLOCK_SIZE, SharedBlockPool::NO_OWNER);
+    EXPECT_EQ(block.get(), last);
+    pool.Recycle(std::move(block), BLOCK_SIZE, SharedBlockPool::NO_OWNER);
+    pool.Trim();
+    EXPECT_EQ(pool.GetIdleBytes(), 0);
+    LOG_INFO("SharedBlockPool_Trim_001::End");
+}
+
+/**
+ * @tc.name: SharedBlockPool_Wipe_001
+ * @tc.desc: Verify a block is only handed out again to the pid and token id it was recycled with, and without the
+ *           bytes of the rows it held.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Acquire a block, write a string to it and recycle it with the owner of a pid and token id.
+    2. Take an idle block for the pid with another token id, then for the pid and token id.
+ * @tc.expect:
+    1. The other token id gets no block.
+    2. The pid and token id get the block, which no longer contains the string.
+ */
+HWTEST_F(SharedBlockPoolTest, SharedBlockPool_Wipe_001, TestSize.Level0)
+{
+    LOG_INFO("SharedBlockPool_Wipe_001::Start");
+    auto &pool = SharedBlockPool::GetInstance();
+    const std::string value = "rows of the last query";
+    auto block = pool.Acquire(BLOCK_SIZE);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->Clear(), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_EQ(block->SetColumnNum(1), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_EQ(block->AllocRow(), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_EQ(block->PutString(0, 0, value.c_str(), value.size() + 1), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_TRUE(Contains(block, value));
+    SharedBlock *raw = block.get();
+    pool.Recycle(std::move(block), BLOCK_SIZE, SharedBlockPool::GetOwner(OWNER, 1));
+
+    EXPECT_EQ(pool.TakeIdle(BLOCK_SIZE, SharedBlockPool::GetOwner(OWNER, 2)), nullptr);
+    block = pool.TakeIdle(BLOCK_SIZE, SharedBlockPool::GetOwner(OWNER, 1));
+    ASSERT_EQ(block.get(), raw);
+    EXPECT_EQ(block->GetRowNum(), 0);
+    EXPECT_FALSE(Contains(block, value));
+    LOG_INFO("SharedBlockPool_Wipe_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS
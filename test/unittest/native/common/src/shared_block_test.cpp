@@ -201,7 +201,7 @@ HWTEST_F(SharedBlockTest, ClearTest001, TestSize.Level0)
     sharedBlock->mReadOnly = false;
     sharedBlock->mSize = sizeof(SharedBlock::SharedBlockHeader);
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_BAD_VALUE);
-    sharedBlock->mSize = sizeof(SharedBlock::RowGroupHeader) + sizeof(SharedBlock::SharedBlockHeader);
+    sharedBlock->mSize = sizeof(SharedBlock::SharedBlockHeader) + sizeof(uint32_t);
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_BAD_VALUE);
     sharedBlock->mSize = sizeof(SharedBlock::RowGroupHeader) + sizeof(SharedBlock::SharedBlockHeader) + 1;
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_OK);
@@ -725,5 +725,137 @@ HWTEST_F(SharedBlockTest, AllocTest001, TestSize.Level0)
     EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_OK);
     LOG_INFO("AllocTest001::End");
 }
+
+/**
+* @tc.name: RowDirectoryTest001
+* @tc.desc: Test rows spanning several pages of the row directory can be allocated, written and read back
+* @tc.type: FUNC
+* @tc.step:
+    1. Create a SharedBlock instance, call Clear() and set 2 columns
+    2. Allocate 3 pages of rows plus one, put the row index as long value into column 0 of each row
+    3. Free the last row and allocate it again, check the row page is reused
+    4. Read back column 0 of every row
+* @tc.expect:
+    - Clear() marks the block with the row directory layout
+    - All rows are allocated successfully and the row number matches
+    - Each row reads back its own row index
+*/
+HWTEST_F(SharedBlockTest, RowDirectoryTest001, TestSize.Level0)
+{
+    LOG_INFO("RowDirectoryTest001::Start");
+    AppDataFwk::SharedBlock *sharedBlock = nullptr;
+    EXPECT_EQ(SharedBlock::Create("name", 1024 * 1024, sharedBlock), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_NE(sharedBlock, nullptr);
+    EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->mHeader->layoutVersion, SharedBlock::LAYOUT_ROW_DIRECTORY);
+    EXPECT_EQ(sharedBlock->SetColumnNum(2), SharedBlock::SHARED_BLOCK_OK);
+    uint32_t rowNum = SharedBlock::ROW_PAGE_SIZE * 3 + 1;
+    for (uint32_t row = 0; row < rowNum; row++) {
+        EXPECT_EQ(sharedBlock->AllocRow(), SharedBlock::SHARED_BLOCK_OK);
+        EXPECT_EQ(sharedBlock->PutLong(row, 0, row), SharedBlock::SHARED_BLOCK_OK);
+    }
+    EXPECT_EQ(sharedBlock->mHeader->rowPageNums, 4);
+    EXPECT_EQ(sharedBlock->FreeLastRow(), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->AllocRow(), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->PutLong(rowNum - 1, 0, rowNum - 1), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->mHeader->rowPageNums, 4);
+    EXPECT_EQ(sharedBlock->GetRowNum(), rowNum);
+    for (uint32_t row = 0; row < rowNum; row++) {
+        SharedBlock::CellUnit *cellUnit = sharedBlock->GetCellUnit(row, 0);
+        ASSERT_NE(cellUnit, nullptr);
+        EXPECT_EQ(cellUnit->cell.longValue, row);
+    }
+    EXPECT_EQ(sharedBlock->GetCellUnit(rowNum, 0), nullptr);
+    delete sharedBlock;
+    LOG_INFO("RowDirectoryTest001::End");
+}
+
+/**
+* @tc.name: LegacyLayoutTest001
+* @tc.desc: Test a block written with the legacy row group layout can still be read
+* @tc.type: FUNC
+* @tc.step:
+    1. Create a SharedBlock instance and write a legacy header, one row group and one row of one long column
+    2. Read the cell of row 0, column 0
+    3. Allocate a row on the legacy block
+* @tc.expect:
+    - The block is not recognized as the row directory layout
+    - The cell reads back the long value written in the legacy layout
+    - AllocRow() returns SHARED_BLOCK_NO_MEMORY until the block is cleared
+*/
+HWTEST_F(SharedBlockTest, LegacyLayoutTest001, TestSize.Level0)
+{
+    LOG_INFO("LegacyLayoutTest001::Start");
+    AppDataFwk::SharedBlock *sharedBlock = nullptr;
+    EXPECT_EQ(SharedBlock::Create("name", 4096, sharedBlock), SharedBlock::SHARED_BLOCK_OK);
+    ASSERT_NE(sharedBlock, nullptr);
+    // The legacy header holds 7 fields, followed by the first row group.
+    uint32_t legacyHeaderSize = 7 * sizeof(uint32_t);
+    uint32_t rowOffset = legacyHeaderSize + static_cast<uint32_t>(sizeof(SharedBlock::RowGroupHeader));
+    uint8_t *data = static_cast<uint8_t *>(sharedBlock->mData);
+    uint32_t header[] = { rowOffset + static_cast<uint32_t>(sizeof(SharedBlock::CellUnit)), legacyHeaderSize, 1, 1,
+        0, 0, 0 };
+    EXPECT_EQ(memcpy_s(data, legacyHeaderSize, header, sizeof(header)), EOK);
+    SharedBlock::RowGroupHeader group = {};
+    group.rowOffsets[0] = rowOffset;
+    EXPECT_EQ(memcpy_s(data + legacyHeaderSize, sizeof(group), &group, sizeof(group)), EOK);
+    SharedBlock::CellUnit cell = {};
+    cell.type = SharedBlock::CELL_UNIT_TYPE_INTEGER;
+    cell.cell.longValue = 100;
+    EXPECT_EQ(memcpy_s(data + rowOffset, sizeof(cell), &cell, sizeof(cell)), EOK);
+
+    EXPECT_FALSE(sharedBlock->IsRowDirectoryLayout());
+    SharedBlock::CellUnit *cellUnit = sharedBlock->GetCellUnit(0, 0);
+    ASSERT_NE(cellUnit, nullptr);
+    EXPECT_EQ(cellUnit->type, SharedBlock::CELL_UNIT_TYPE_INTEGER);
+    EXPECT_EQ(cellUnit->cell.longValue, 100);
+    EXPECT_EQ(sharedBlock->AllocRow(), SharedBlock::SHARED_BLOCK_NO_MEMORY);
+    delete sharedBlock;
+    LOG_INFO("LegacyLayoutTest001::End");
+}
+
+/**
+* @tc.name: SealTest001
+* @tc.desc: Test a sealed block is only read through read-only mappings while its writer can still fill it
+* @tc.type: FUNC
+* @tc.step:
+    1. Create a SharedBlock instance with one row of one long column and seal it
+    2. Read the block from a parcel as a read-only block, then as a writable block
+    3. Write the row through the read-only block, then through the sealed block
+* @tc.expect:
+    - The read-only block reads the row, and reading the writable block returns SHARED_BLOCK_SET_PORT_ERROR
+    - The read-only block refuses the write with SHARED_BLOCK_INVALID_OPERATION
+    - The sealed block accepts the write, and the read-only block sees the new value
+*/
+HWTEST_F(SharedBlockTest, SealTest001, TestSize.Level0)
+{
+    LOG_INFO("SealTest001::Start");
+    SharedBlock *block = nullptr;
+    ASSERT_EQ(SharedBlock::Create("name", 4096, block), SharedBlock::SHARED_BLOCK_OK);
+    std::unique_ptr<SharedBlock> sharedBlock(block);
+    EXPECT_EQ(sharedBlock->Clear(), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->SetColumnNum(1), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->AllocRow(), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->PutLong(0, 0, 1), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(sharedBlock->Seal(), SharedBlock::SHARED_BLOCK_OK);
+
+    MessageParcel parcel;
+    EXPECT_TRUE(sharedBlock->WriteMessageParcel(parcel));
+    SharedBlock *reader = nullptr;
+    ASSERT_EQ(SharedBlock::ReadMessageParcel(parcel, reader), SharedBlock::SHARED_BLOCK_OK);
+    std::unique_ptr<SharedBlock> readOnlyBlock(reader);
+    EXPECT_EQ(readOnlyBlock->GetCellUnit(0, 0)->cell.longValue, 1);
+
+    MessageParcel writableParcel;
+    EXPECT_TRUE(sharedBlock->WriteMessageParcel(writableParcel));
+    SharedBlock *writer = nullptr;
+    EXPECT_EQ(SharedBlock::ReadMessageParcel(writableParcel, writer, false), SharedBlock::SHARED_BLOCK_SET_PORT_ERROR);
+    EXPECT_EQ(writer, nullptr);
+
+    EXPECT_EQ(readOnlyBlock->PutLong(0, 0, 2), SharedBlock::SHARED_BLOCK_INVALID_OPERATION);
+    EXPECT_EQ(sharedBlock->PutLong(0, 0, 3), SharedBlock::SHARED_BLOCK_OK);
+    EXPECT_EQ(readOnlyBlock->GetCellUnit(0, 0)->cell.longValue, 3);
+    LOG_INFO("SealTest001::End");
+}
 } // namespace DataShare
 } // namespace OHOS
\ No newline at end of file
@@ -56,6 +56,30 @@ void GeneralControllerProviderImplTest::TearDownTestCase(void) {}
 void GeneralControllerProviderImplTest::SetUp(void) {}
 void GeneralControllerProviderImplTest::TearDown(void) {}
 
+class ProxyConnectionTest : public DataShareConnectionBase {
+public:
+    std::shared_ptr<DataShareProxy> GetDataShareProxy(const Uri &uri, const sptr<IRemoteObject> &token) override
+    {
+        count_++;
+        return proxy_;
+    }
+    void UpdateObserverExtsProviderMap(const Uri &uri, const sptr<AAFwk::IDataAbilityObserver> &dataObserver,
+        bool isDescendants) override {}
+    void DeleteObserverExtsProviderMap(const Uri &uri,
+        const sptr<AAFwk::IDataAbilityObserver> &dataObserver) override
+    {
+        deleteCount_++;
+    }
+    void SetProxy(std::shared_ptr<DataShareProxy> proxy)
+    {
+        proxy_ = proxy;
+        UpdateProxyVersion();
+    }
+    int count_ = 0;
+    int deleteCount_ = 0;
+    std::shared_ptr<DataShareProxy> proxy_;
+};
+
 /**
  * @tc.name: ProviderImplInsertTest001
  * @tc.desc: Verify the Insert operation in GeneralControllerProviderImpl when the connection is null, focusing on
@@ -903,5 +927,87 @@ HWTEST_F(GeneralControllerProviderImplTest, UnregisterObserverExtProviderTest001
 
     LOG_INFO("GeneralControllerProviderImplTest UnregisterObserverExtProviderTest001::End");
 }
+
+/**
+ * @tc.name: ProviderImplProxyCacheTest001
+ * @tc.desc: Verify GeneralControllerProviderImpl looks the proxy up from the connection only when the proxy version
+ *           of the connection changes, never caches a null proxy, and stops caching once the proxy changed
+ *           MAX_PROXY_CACHES times.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a GeneralControllerProviderImpl with a connection handing out a proxy, get the proxy three times.
+    2. Replace the proxy of the connection and get the proxy twice.
+    3. Drop the proxy of the connection and get the proxy twice.
+    4. Replace the proxy until MAX_PROXY_CACHES proxies are cached, replace it once more and get it twice.
+ * @tc.expect:
+    1. The connection is asked once in step 1, and the same proxy is returned each time.
+    2. The new proxy is returned after one more lookup.
+    3. Both calls of step 3 return null and ask the connection.
+    4. Both calls of step 4 ask the connection.
+ */
+HWTEST_F(GeneralControllerProviderImplTest, ProviderImplProxyCacheTest001, TestSize.Level0)
+{
+    LOG_INFO("GeneralControllerProviderImplTest ProviderImplProxyCacheTest001::Start");
+    Uri uri("");
+    auto connection = std::make_shared<ProxyConnectionTest>();
+    auto proxy = std::make_shared<DataShareProxy>(nullptr);
+    connection->SetProxy(proxy);
+    GeneralControllerProviderImpl controller(connection, uri, nullptr);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(controller.GetDataShareProxy(connection), proxy);
+    }
+    EXPECT_EQ(connection->count_, 1);
+
+    auto newProxy = std::make_shared<DataShareProxy>(nullptr);
+    connection->SetProxy(newProxy);
+    EXPECT_EQ(controller.GetDataShareProxy(connection), newProxy);
+    EXPECT_EQ(controller.GetDataShareProxy(connection), newProxy);
+    EXPECT_EQ(connection->count_, 2);
+
+    connection->SetProxy(nullptr);
+    EXPECT_EQ(controller.GetDataShareProxy(connection), nullptr);
+    EXPECT_EQ(controller.GetDataShareProxy(connection), nullptr);
+    EXPECT_EQ(connection->count_, 4);
+
+    for (size_t i = controller.proxyCaches_.size(); i < GeneralControllerProviderImpl::MAX_PROXY_CACHES; i++) {
+        connection->SetProxy(std::make_shared<DataShareProxy>(nullptr));
+        EXPECT_NE(controller.GetDataShareProxy(connection), nullptr);
+    }
+    connection->SetProxy(proxy);
+    int count = connection->count_;
+    EXPECT_EQ(controller.GetDataShareProxy(connection), proxy);
+    EXPECT_EQ(controller.GetDataShareProxy(connection), proxy);
+    EXPECT_EQ(connection->count_, count + 2);
+    LOG_INFO("GeneralControllerProviderImplTest ProviderImplProxyCacheTest001::End");
+}
+
+/**
+ * @tc.name: ProviderImplObserverReleaseTest001
+ * @tc.desc: Verify a GeneralControllerProviderImpl removes the observers it registered and did not unregister from
+ *           the connection when it is destroyed, so a pooled connection does not register them again.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a GeneralControllerProviderImpl on a connection and record two observers as registered through it.
+    2. Destroy the controller.
+ * @tc.expect:
+    1. The connection is asked to remove both observers.
+ */
+HWTEST_F(GeneralControllerProviderImplTest, ProviderImplObserverReleaseTest001, TestSize.Level0)
+{
+    LOG_INFO("GeneralControllerProviderImplTest ProviderImplObserverReleaseTest001::Start");
+    Uri uri("datashare:///com.acts.datasharetest");
+    auto connection = std::make_shared<ProxyConnectionTest>();
+    auto controller = std::make_shared<GeneralControllerProviderImpl>(connection, uri, nullptr);
+    sptr<AAFwk::IDataAbilityObserver> dataObserver;
+    controller->observers_.emplace_back(uri, dataObserver);
+    controller->observers_.emplace_back(Uri("datashare:///com.acts.datasharetest/entry"), dataObserver);
+    controller = nullptr;
+    EXPECT_EQ(connection->deleteCount_, 2);
+    LOG_INFO("GeneralControllerProviderImplTest ProviderImplObserverReleaseTest001::End");
+}
 }
 }
\ No newline at end of file
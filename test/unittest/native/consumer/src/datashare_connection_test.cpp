@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include "datashare_connection_pool.h"
+
 #include "accesstoken_kit.h"
 #include "data_ability_observer_interface.h"
 #include "datashare_errno.h"
@@ -583,5 +585,92 @@ HWTEST_F(DataShareConnectionTest, DataShareConnection_ConcurrentOnAbilityConnect
     t4.join();
     LOG_INFO("DataShareConnection_ConcurrentOnAbilityConnectDone_Test_001::End");
 }
+/**
+ * @tc.name: DataShareConnectionPool_Acquire_Test_001
+ * @tc.desc: Verify the helpers of the same provider and token share one pooled connection, which is evicted once
+ *           the last of them is released.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Acquire two connections for different uris of the same provider with the same token.
+    2. Acquire connections for another provider, and for the same provider with another token.
+    3. Set the idle time to 0 and release the connections of the first provider one by one.
+ * @tc.expect:
+    1. The connections of step 1 are the same one, those of step 2 are different ones.
+    2. The connection is only evicted after both of its users are released.
+ */
+HWTEST_F(DataShareConnectionTest, DataShareConnectionPool_Acquire_Test_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareConnectionPool_Acquire_Test_001::Start");
+    auto &pool = DataShareConnectionPool::GetInstance();
+    std::u16string tokenString = u"OHOS.DataShare.IDataShare";
+    sptr<IRemoteObject> token = new (std::nothrow) RemoteObjectTest(tokenString);
+    ASSERT_NE(token, nullptr);
+    sptr<IRemoteObject> token1 = new (std::nothrow) RemoteObjectTest(tokenString);
+    ASSERT_NE(token1, nullptr);
+    auto idleTime = pool.idleTime_;
+    pool.idleTime_ = std::chrono::milliseconds(0);
+    auto before = pool.GetStatistics();
+
+    auto connection = pool.Acquire(Uri(DATA_SHARE_URI + "/entry/table1"), token, 2);
+    auto connection1 = pool.Acquire(Uri(DATA_SHARE_URI + "/entry/table2?user=100"), token, 2);
+    auto connection2 = pool.Acquire(Uri(DATA_SHARE_URI + "/entry/table1?user=100"), token, 2);
+    ASSERT_NE(connection, nullptr);
+    ASSERT_NE(connection1, nullptr);
+    EXPECT_NE(connection.get(), connection1.get());
+    EXPECT_EQ(connection1.get(), connection2.get());
+    auto otherProvider = pool.Acquire(Uri(DATA_SHARE_URI1 + "/entry/table1?user=100"), token, 2);
+    auto otherToken = pool.Acquire(Uri(DATA_SHARE_URI + "/entry/table1?user=100"), token1, 2);
+    EXPECT_NE(otherProvider.get(), connection1.get());
+    EXPECT_NE(otherToken.get(), connection1.get());
+    auto key = DataShareConnectionPool::GetKey(Uri(DATA_SHARE_URI + "/entry/table1?user=100"), token1);
+    auto it = pool.entries_.find(key);
+    ASSERT_NE(it, pool.entries_.end());
+    EXPECT_EQ(it->first.token, token1);
+    auto statistics = pool.GetStatistics();
+    EXPECT_EQ(statistics.created - before.created, 4);
+    EXPECT_EQ(statistics.reused - before.reused, 1);
+
+    connection1 = nullptr;
+    EXPECT_EQ(pool.GetStatistics().evicted, before.evicted);
+    connection2 = nullptr;
+    EXPECT_EQ(pool.GetStatistics().evicted, before.evicted + 1);
+    connection = nullptr;
+    otherProvider = nullptr;
+    otherToken = nullptr;
+    EXPECT_EQ(pool.GetStatistics().evicted, before.evicted + 4);
+    pool.idleTime_ = idleTime;
+    LOG_INFO("DataShareConnectionPool_Acquire_Test_001::End");
+}
+
+/**
+ * @tc.name: DataShareConnectionPool_ConnectTime_Test_001
+ * @tc.desc: Verify the connect time percentiles are computed over the recent connects only.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Record 1000ms once, then record 1ms to 128ms as many times as the pool keeps.
+    2. Get the statistics of the pool.
+ * @tc.expect: The 1000ms connect is dropped, p50, p90, p99 and max are 64ms, 116ms, 127ms and 128ms.
+ */
+HWTEST_F(DataShareConnectionTest, DataShareConnectionPool_ConnectTime_Test_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareConnectionPool_ConnectTime_Test_001::Start");
+    auto &pool = DataShareConnectionPool::GetInstance();
+    auto connects = pool.GetStatistics().connects;
+    pool.RecordConnectTime(1000);
+    for (size_t i = 1; i <= DataShareConnectionPool::CONNECT_TIME_NUM; i++) {
+        pool.RecordConnectTime(static_cast<int64_t>(i));
+    }
+    auto statistics = pool.GetStatistics();
+    EXPECT_EQ(statistics.connects - connects, DataShareConnectionPool::CONNECT_TIME_NUM + 1);
+    EXPECT_EQ(statistics.p50, 64);
+    EXPECT_EQ(statistics.p90, 116);
+    EXPECT_EQ(statistics.p99, 127);
+    EXPECT_EQ(statistics.max, 128);
+    LOG_INFO("DataShareConnectionPool_ConnectTime_Test_001::End");
+}
 }
 }
\ No newline at end of file
@@ -965,7 +965,8 @@ HWTEST_F(DataShareHelperProxyTest, RecoverRdbSubscribe_Test_001, TestSize.Level1
     auto observer = std::make_shared<RdbObserver>(callback);
     RdbSubscriberManager::ObserverNode obsNode(observer, &dataShareHelper);
     obsNode.enabled_ = false;
-    RdbSubscriberManager::GetInstance().callbacks_[key].emplace_back(obsNode);
+    RdbSubscriberManager::GetInstance().callbacks_[key] =
+        std::make_shared<RdbSubscriberManager::ObserverNodes>(1, obsNode);
 
     auto proxy = DataShareManagerImpl::GetServiceProxy();
     EXPECT_NE(proxy, nullptr);
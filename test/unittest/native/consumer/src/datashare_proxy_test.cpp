@@ -21,9 +21,11 @@
 
 #include "accesstoken_kit.h"
 #include "data_ability_observer_interface.h"
+#include "datashare_ashmem_parcel.h"
 #include "datashare_connection.h"
 #include "datashare_errno.h"
 #include "datashare_helper.h"
+#include "datashare_itypes_utils.h"
 #include "datashare_log.h"
 #include "extension_manager_proxy.h"
 #include "general_controller.h"
@@ -81,6 +83,39 @@ public:
     }
 };
 
+// Plays the provider side of Insert, restoring a request handed over in ashmem the way DataShareStub does.
+class InsertRemoteObjectTest : public RemoteObjectTest {
+public:
+    InsertRemoteObjectTest() : RemoteObjectTest(u"OHOS.DataShare.IDataShare") {}
+
+    int SendRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        sentCode = code;
+        MessageParcel restored;
+        MessageParcel *request = &data;
+        if (code == static_cast<uint32_t>(IDataShareInterfaceCode::CMD_ASHMEM_REQUEST)) {
+            data.ReadInterfaceToken();
+            if (!DataShareAshmemParcel::Unpack(data, code, restored)) {
+                return E_ERROR;
+            }
+            request = &restored;
+        }
+        Uri uri("");
+        DataShareValuesBucket value;
+        request->ReadInterfaceToken();
+        if (code != static_cast<uint32_t>(IDataShareInterfaceCode::CMD_INSERT) ||
+            !ITypesUtil::Unmarshal(*request, uri, value)) {
+            return E_ERROR;
+        }
+        bool isValid = false;
+        text = static_cast<std::string>(value.Get("data", isValid));
+        return ITypesUtil::Marshal(reply, 1) ? E_OK : E_ERROR;
+    }
+
+    uint32_t sentCode = 0;
+    std::string text;
+};
+
 std::string DATA_SHARE_URI = "datashare:///com.acts.datasharetest";
 
 void DataShareProxyTest::SetUpTestCase(void) {}
@@ -250,5 +285,42 @@ HWTEST_F(DataShareProxyTest, DataShareProxy_NotifyChangeExtProvider_Test_001, Te
 
     LOG_INFO("DataShareProxy_NotifyChangeExtProvider_Test_001::End");
 }
+
+/**
+ * @tc.name: DataShareProxy_Insert_Ashmem_Test_001
+ * @tc.desc: Verify Insert sends a request under the MTU as is, and hands a request over the MTU over in ashmem.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a DataShareProxy on a remote object playing the provider side of Insert.
+    2. Insert a row whose text leaves the request 1KB below the MTU.
+    3. Insert a row whose text is 1 byte over the MTU, then a row of 16MB.
+ * @tc.expect:
+    1. The first row is sent with CMD_INSERT.
+    2. The other rows are sent with CMD_ASHMEM_REQUEST, and the provider side receives the whole text.
+ */
+HWTEST_F(DataShareProxyTest, DataShareProxy_Insert_Ashmem_Test_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareProxy_Insert_Ashmem_Test_001::Start");
+    sptr<InsertRemoteObjectTest> remote = new (std::nothrow) InsertRemoteObjectTest();
+    ASSERT_NE(remote, nullptr);
+    DataShareProxy proxy(remote);
+    Uri uri(DATA_SHARE_URI);
+    constexpr size_t mtuSize = DataShareProxy::MTU_SIZE;
+    constexpr size_t bigSize = 16 * 1024 * 1024;
+
+    for (size_t size : { mtuSize - 1024, mtuSize + 1, bigSize }) {
+        DataShareValuesBucket value;
+        std::string text(size, static_cast<char>('a' + size % 26));
+        value.Put("data", text);
+        EXPECT_EQ(proxy.Insert(uri, value), 1);
+        auto expectedCode = size < mtuSize ? IDataShareInterfaceCode::CMD_INSERT :
+            IDataShareInterfaceCode::CMD_ASHMEM_REQUEST;
+        EXPECT_EQ(remote->sentCode, static_cast<uint32_t>(expectedCode));
+        EXPECT_EQ(remote->text, text);
+    }
+    LOG_INFO("DataShareProxy_Insert_Ashmem_Test_001::End");
+}
 }
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "data_share_lru_cache_test"
+
+#include "data_share_lru_cache.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+class DataShareLruCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+/**
+ * @tc.name: DataShareLruCache_Evict_001
+ * @tc.desc: Verify a full cache evicts only its least recently used entry and counts hits, misses and evictions.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a cache of one shard holding 3 entries and put keys 1, 2 and 3.
+    2. Find key 1, then put key 4.
+ * @tc.expect:
+    1. Key 2 is evicted, keys 1, 3 and 4 remain.
+    2. The statistics report the hits, misses and the eviction.
+ */
+HWTEST_F(DataShareLruCacheTest, DataShareLruCache_Evict_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareLruCache_Evict_001::Start");
+    DataShareLruCache<int, std::string> cache(3, 1);
+    cache.Emplace(1, "one");
+    cache.Emplace(2, "two");
+    cache.Emplace(3, "three");
+    auto [found, value] = cache.Find(1);
+    EXPECT_TRUE(found);
+    EXPECT_EQ(value, "one");
+
+    cache.Emplace(4, "four");
+    EXPECT_EQ(cache.Size(), 3);
+    EXPECT_FALSE(cache.Find(2).first);
+    EXPECT_TRUE(cache.Find(1).first);
+    EXPECT_TRUE(cache.Find(3).first);
+    EXPECT_TRUE(cache.Find(4).first);
+
+    auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits, 4);
+    EXPECT_EQ(statistics.misses, 1);
+    EXPECT_EQ(statistics.evictions, 1);
+    LOG_INFO("DataShareLruCache_Evict_001::End");
+}
+
+/**
+ * @tc.name: DataShareLruCache_EraseIf_001
+ * @tc.desc: Verify EraseIf removes exactly the matching entries of every shard.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Put 100 keys into a cache of 8 shards, the value tells whether the key is even.
+    2. Erase the even entries.
+ * @tc.expect: The 50 even keys are gone, the odd keys are still found.
+ */
+HWTEST_F(DataShareLruCacheTest, DataShareLruCache_EraseIf_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareLruCache_EraseIf_001::Start");
+    DataShareLruCache<int, std::string> cache(256, 8);
+    const int keyNum = 100;
+    for (int i = 0; i < keyNum; i++) {
+        cache.Emplace(i, i % 2 == 0 ? "even" : "odd");
+    }
+    EXPECT_EQ(cache.Size(), keyNum);
+    auto count = cache.EraseIf([](const int &key, std::string &value) { return value == "even"; });
+    EXPECT_EQ(count, keyNum / 2);
+    for (int i = 0; i < keyNum; i++) {
+        EXPECT_EQ(cache.Find(i).first, i % 2 != 0);
+    }
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0);
+    LOG_INFO("DataShareLruCache_EraseIf_001::End");
+}
+
+/**
+ * @tc.name: DataShareLruCache_Concurrent_001
+ * @tc.desc: Verify concurrent lookups and inserts keep the cache within its capacity.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step: Put and find 1000 different keys from 4 threads on a cache holding 64 entries.
+ * @tc.expect: The cache never holds more than its capacity and every lookup is counted.
+ */
+HWTEST_F(DataShareLruCacheTest, DataShareLruCache_Concurrent_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareLruCache_Concurrent_001::Start");
+    const size_t capacity = 64;
+    const int threadNum = 4;
+    const int keyNum = 1000;
+    DataShareLruCache<int, int> cache(capacity);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < keyNum; i++) {
+                int key = t * keyNum + i;
+                if (!cache.Find(key).first) {
+                    cache.Emplace(key, i);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(cache.Size(), capacity);
+    auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits + statistics.misses, threadNum * keyNum);
+    EXPECT_EQ(statistics.misses - statistics.evictions, cache.Size());
+    LOG_INFO("DataShareLruCache_Concurrent_001::End");
+}
+
+/**
+ * @tc.name: DataShareLruCache_Expire_001
+ * @tc.desc: Verify an entry older than the time to live is dropped by the next lookup.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a cache with a time to live of 50ms, put key 1 and find it.
+    2. Wait 100ms and find key 1 again, then put it again and find it.
+ * @tc.expect:
+    1. Key 1 is found before it expires.
+    2. Key 1 is missed once expired and counted as an expiration, and found again once put again.
+ */
+HWTEST_F(DataShareLruCacheTest, DataShareLruCache_Expire_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareLruCache_Expire_001::Start");
+    DataShareLruCache<int, std::string> cache(8, 1, std::chrono::milliseconds(50));
+    cache.Emplace(1, "one");
+    EXPECT_TRUE(cache.Find(1).first);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(cache.Find(1).first);
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(cache.GetStatistics().expirations, 1);
+    cache.Emplace(1, "one");
+    EXPECT_TRUE(cache.Find(1).first);
+    LOG_INFO("DataShareLruCache_Expire_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS
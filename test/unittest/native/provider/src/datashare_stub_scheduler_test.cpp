@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "datashare_stub_scheduler_test"
+
+#include "datashare_stub_scheduler.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "datashare_errno.h"
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+class DataShareStubSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+namespace {
+constexpr uint32_t CALLER_A = 1;
+constexpr uint32_t CALLER_B = 2;
+
+void WaitForWaiters(DataShareStubScheduler &scheduler, size_t count)
+{
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(scheduler.mutex_);
+            if (scheduler.waiterCount_ == count) {
+                return;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Runs one call on its own thread, records the call order and holds the call until it is released.
+std::thread RunCall(DataShareStubScheduler &scheduler, DataShareStubScheduler::CallType type, uint32_t callerId,
+    std::vector<uint32_t> &order, std::mutex &orderMutex)
+{
+    return std::thread([&scheduler, type, callerId, &order, &orderMutex]() {
+        int64_t waitTime = 0;
+        if (scheduler.Acquire(type, callerId, waitTime) != E_OK) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(callerId);
+        }
+        scheduler.Release(type);
+    });
+}
+} // namespace
+
+/**
+ * @tc.name: DataShareStubScheduler_Exclusive_001
+ * @tc.desc: Verify reads of a non reentrant extension run one after another and report their queue wait time.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a non reentrant scheduler and acquire a read.
+    2. Acquire a second read on another thread, release the first read after 50ms.
+ * @tc.expect:
+    1. The second read is admitted only after the first one is released.
+    2. The waited time of the second read is reported in its result and in the statistics.
+ */
+HWTEST_F(DataShareStubSchedulerTest, DataShareStubScheduler_Exclusive_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareStubScheduler_Exclusive_001::Start");
+    DataShareStubScheduler scheduler(false);
+    int64_t waitTime = -1;
+    ASSERT_EQ(scheduler.Acquire(DataShareStubScheduler::READ, CALLER_A, waitTime), E_OK);
+    EXPECT_EQ(waitTime, 0);
+
+    int64_t secondWaitTime = 0;
+    std::thread second([&scheduler, &secondWaitTime]() {
+        scheduler.Acquire(DataShareStubScheduler::READ, CALLER_B, secondWaitTime);
+        scheduler.Release(DataShareStubScheduler::READ);
+    });
+    WaitForWaiters(scheduler, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    scheduler.Release(DataShareStubScheduler::READ);
+    second.join();
+
+    EXPECT_GE(secondWaitTime, 50000);
+    auto statistics = scheduler.GetStatistics(DataShareStubScheduler::READ);
+    EXPECT_EQ(statistics.count, 2);
+    EXPECT_EQ(statistics.maxWaitTimeUs, static_cast<uint64_t>(secondWaitTime));
+    LOG_INFO("DataShareStubScheduler_Exclusive_001::End");
+}
+
+/**
+ * @tc.name: DataShareStubScheduler_Reentrant_001
+ * @tc.desc: Verify reads of a reentrant extension overlap, and a queued write is not overtaken by later reads.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a reentrant scheduler and acquire two reads at the same time.
+    2. Queue a write, then queue a read of another caller behind it.
+    3. Release both running reads.
+ * @tc.expect:
+    1. The two reads are admitted without waiting.
+    2. The write runs before the read queued after it.
+ */
+HWTEST_F(DataShareStubSchedulerTest, DataShareStubScheduler_Reentrant_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareStubScheduler_Reentrant_001::Start");
+    DataShareStubScheduler scheduler(true);
+    int64_t waitTime = -1;
+    ASSERT_EQ(scheduler.Acquire(DataShareStubScheduler::READ, CALLER_A, waitTime), E_OK);
+    ASSERT_EQ(scheduler.Acquire(DataShareStubScheduler::READ, CALLER_B, waitTime), E_OK);
+    EXPECT_EQ(waitTime, 0);
+
+    std::vector<uint32_t> order;
+    std::mutex orderMutex;
+    std::thread write = RunCall(scheduler, DataShareStubScheduler::WRITE, CALLER_A, order, orderMutex);
+    WaitForWaiters(scheduler, 1);
+    std::thread read = RunCall(scheduler, DataShareStubScheduler::READ, CALLER_B, order, orderMutex);
+    WaitForWaiters(scheduler, 2);
+
+    scheduler.Release(DataShareStubScheduler::READ);
+    scheduler.Release(DataShareStubScheduler::READ);
+    write.join();
+    read.join();
+    std::vector<uint32_t> expected = { CALLER_A, CALLER_B };
+    EXPECT_EQ(order, expected);
+    LOG_INFO("DataShareStubScheduler_Reentrant_001::End");
+}
+
+/**
+ * @tc.name: DataShareStubScheduler_Fairness_001
+ * @tc.desc: Verify waiting callers are served in turn instead of in arrival order.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Acquire a write, then queue three writes of caller A and one write of caller B.
+    2. Release the first write.
+ * @tc.expect: Caller B runs right after the first write of caller A.
+ */
+HWTEST_F(DataShareStubSchedulerTest, DataShareStubScheduler_Fairness_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareStubScheduler_Fairness_001::Start");
+    DataShareStubScheduler scheduler(false);
+    int64_t waitTime = 0;
+    ASSERT_EQ(scheduler.Acquire(DataShareStubScheduler::WRITE, CALLER_A, waitTime), E_OK);
+
+    std::vector<uint32_t> order;
+    std::mutex orderMutex;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 3; i++) {
+        threads.emplace_back(RunCall(scheduler, DataShareStubScheduler::WRITE, CALLER_A, order, orderMutex));
+        WaitForWaiters(scheduler, i + 1);
+    }
+    threads.emplace_back(RunCall(scheduler, DataShareStubScheduler::WRITE, CALLER_B, order, orderMutex));
+    WaitForWaiters(scheduler, 4);
+
+    scheduler.Release(DataShareStubScheduler::WRITE);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::vector<uint32_t> expected = { CALLER_A, CALLER_B, CALLER_A, CALLER_A };
+    EXPECT_EQ(order, expected);
+    LOG_INFO("DataShareStubScheduler_Fairness_001::End");
+}
+
+/**
+ * @tc.name: DataShareStubScheduler_QueueFull_001
+ * @tc.desc: Verify a call is rejected once the queue holds the maximum number of waiting calls.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a scheduler allowing one waiting call, acquire a write and queue another one.
+    2. Acquire a third call.
+ * @tc.expect: The third call fails with E_ERROR_OVER_LIMIT_TASK and is counted as rejected.
+ */
+HWTEST_F(DataShareStubSchedulerTest, DataShareStubScheduler_QueueFull_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareStubScheduler_QueueFull_001::Start");
+    DataShareStubScheduler scheduler(false, 1, 1);
+    int64_t waitTime = 0;
+    ASSERT_EQ(scheduler.Acquire(DataShareStubScheduler::WRITE, CALLER_A, waitTime), E_OK);
+    std::vector<uint32_t> order;
+    std::mutex orderMutex;
+    std::thread queued = RunCall(scheduler, DataShareStubScheduler::WRITE, CALLER_A, order, orderMutex);
+    WaitForWaiters(scheduler, 1);
+
+    EXPECT_EQ(scheduler.Acquire(DataShareStubScheduler::READ, CALLER_B, waitTime), E_ERROR_OVER_LIMIT_TASK);
+    EXPECT_EQ(scheduler.GetStatistics(DataShareStubScheduler::READ).rejected, 1);
+
+    scheduler.Release(DataShareStubScheduler::WRITE);
+    queued.join();
+    EXPECT_EQ(order.size(), 1);
+    EXPECT_EQ(scheduler.GetStatistics(DataShareStubScheduler::WRITE).count, 2);
+    LOG_INFO("DataShareStubScheduler_QueueFull_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "datashare_uv_queue_test"
+
+#include "datashare_uv_queue.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+#include "datashare_log.h"
+#include "datashare_result.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+using namespace std::chrono;
+class DataShareUvQueueTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+namespace {
+uint64_t CountCalls(DataShareUvQueue::ReplyType type)
+{
+    auto histogram = DataShareUvQueue::GetLatencyHistogram(type);
+    return std::accumulate(histogram.begin(), histogram.end(), static_cast<uint64_t>(0));
+}
+} // namespace
+
+/**
+ * @tc.name: DataShareUvQueue_CheckFuncAndExec_001
+ * @tc.desc: Verify the caller wakes up as soon as the async reply is set instead of polling for it.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Call CheckFuncAndExec with a ResultWrap that has no reply yet.
+    2. Set the reply from another thread after 20ms.
+ * @tc.expect:
+    1. CheckFuncAndExec returns well before the 2s timeout.
+    2. The call is counted as an async reply in the latency histogram.
+ */
+HWTEST_F(DataShareUvQueueTest, DataShareUvQueue_CheckFuncAndExec_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareUvQueue_CheckFuncAndExec_001::Start");
+    DataShareUvQueue uvQueue;
+    auto result = std::make_shared<ResultWrap>();
+    uint64_t asyncCount = CountCalls(DataShareUvQueue::ASYNC_REPLY);
+    std::thread reply([result]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        result->SetRecvReply();
+    });
+    auto start = steady_clock::now();
+    uvQueue.CheckFuncAndExec([result]() { return result->GetRecvReply(); },
+        [result](milliseconds timeout) { return result->WaitRecvReply(timeout); }, start);
+    auto cost = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    reply.join();
+
+    EXPECT_TRUE(result->GetRecvReply());
+    EXPECT_LT(cost, 1000);
+    EXPECT_EQ(CountCalls(DataShareUvQueue::ASYNC_REPLY), asyncCount + 1);
+    LOG_INFO("DataShareUvQueue_CheckFuncAndExec_001::End");
+}
+
+/**
+ * @tc.name: DataShareUvQueue_CheckFuncAndExec_002
+ * @tc.desc: Verify a reply set before the check is counted as a sync reply, and a missing reply times out.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Call CheckFuncAndExec with a ResultWrap that already has its reply.
+    2. Call CheckFuncAndExec with a ResultWrap that never gets a reply.
+ * @tc.expect:
+    1. The first call is counted as a sync reply.
+    2. The second call returns after the timeout and is not counted in the histogram.
+ */
+HWTEST_F(DataShareUvQueueTest, DataShareUvQueue_CheckFuncAndExec_002, TestSize.Level0)
+{
+    LOG_INFO("DataShareUvQueue_CheckFuncAndExec_002::Start");
+    DataShareUvQueue uvQueue;
+    uint64_t syncCount = CountCalls(DataShareUvQueue::SYNC_REPLY);
+    uint64_t asyncCount = CountCalls(DataShareUvQueue::ASYNC_REPLY);
+    auto replied = std::make_shared<ResultWrap>();
+    replied->SetRecvReply();
+    uvQueue.CheckFuncAndExec([replied]() { return replied->GetRecvReply(); },
+        [replied](milliseconds timeout) { return replied->WaitRecvReply(timeout); });
+    EXPECT_EQ(CountCalls(DataShareUvQueue::SYNC_REPLY), syncCount + 1);
+
+    auto result = std::make_shared<ResultWrap>();
+    auto start = steady_clock::now();
+    uvQueue.CheckFuncAndExec([result]() { return result->GetRecvReply(); },
+        [result](milliseconds timeout) { return result->WaitRecvReply(timeout); }, start);
+    auto cost = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    EXPECT_FALSE(result->GetRecvReply());
+    EXPECT_GE(cost, 2000);
+    EXPECT_EQ(CountCalls(DataShareUvQueue::SYNC_REPLY), syncCount + 1);
+    EXPECT_EQ(CountCalls(DataShareUvQueue::ASYNC_REPLY), asyncCount);
+    LOG_INFO("DataShareUvQueue_CheckFuncAndExec_002::End");
+}
+} // namespace DataShare
+} // namespace OHOS
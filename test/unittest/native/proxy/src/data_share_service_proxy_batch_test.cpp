@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "data_share_service_proxy_batch_test"
+
+#include <gtest/gtest.h>
+
+#include "data_share_service_loopback.h"
+#include "data_share_service_proxy.h"
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+class DataShareServiceProxyBatchTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+namespace {
+const std::string URI = "datashareproxy://com.acts.datasharetest/test";
+
+std::vector<DataShareValuesBucket> GetRows(size_t count, size_t blobSize)
+{
+    std::vector<DataShareValuesBucket> values(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i].Put("name", "row" + std::to_string(i));
+        values[i].Put("age", static_cast<int>(i));
+        values[i].Put("data", std::vector<uint8_t>(blobSize, static_cast<uint8_t>(i)));
+    }
+    return values;
+}
+
+OperationStatement GetStatement(Operation type, const DataShareValuesBucket &value)
+{
+    OperationStatement statement;
+    statement.operationType = type;
+    statement.uri = URI;
+    statement.valuesBucket = value;
+    return statement;
+}
+} // namespace
+
+/**
+ * @tc.name: DataShareServiceProxy_BatchInsert_001
+ * @tc.desc: Verify BatchInsert sends all rows in one request and returns the result of each row.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a DataShareServiceProxy on the loopback service.
+    2. Batch insert 3 rows, then 2000 rows of 1KB which are beyond the size kept in the parcel.
+ * @tc.expect:
+    1. Each batch succeeds with one request, and the results are the row ids in order.
+    2. All rows are stored by the service.
+ */
+HWTEST_F(DataShareServiceProxyBatchTest, DataShareServiceProxy_BatchInsert_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareServiceProxy_BatchInsert_001::Start");
+    sptr<DataShareServiceLoopback> service = new DataShareServiceLoopback();
+    DataShareServiceProxy proxy(service);
+    std::vector<int32_t> results;
+    EXPECT_EQ(proxy.BatchInsert(Uri(URI), Uri(""), GetRows(3, 1), results), E_OK);
+    std::vector<int32_t> expected = { 1, 2, 3 };
+    EXPECT_EQ(results, expected);
+    EXPECT_EQ(service->GetRequestCount(), 1);
+
+    results.clear();
+    EXPECT_EQ(proxy.BatchInsert(Uri(URI), Uri(""), GetRows(2000, 1024), results), E_OK);
+    ASSERT_EQ(results.size(), 2000);
+    EXPECT_EQ(results.back(), 2003);
+    EXPECT_EQ(service->GetRequestCount(), 2);
+    EXPECT_EQ(service->GetRowCount(), 2003);
+    LOG_INFO("DataShareServiceProxy_BatchInsert_001::End");
+}
+
+/**
+ * @tc.name: DataShareServiceProxy_BatchInsert_002
+ * @tc.desc: Verify a failing row of BatchInsert fails the whole batch and tells which row failed.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a DataShareServiceProxy on the loopback service.
+    2. Batch insert 5 rows of which the fourth one has no value.
+ * @tc.expect:
+    1. BatchInsert fails, and the results end with the fourth row.
+    2. None of the rows is stored by the service.
+ */
+HWTEST_F(DataShareServiceProxyBatchTest, DataShareServiceProxy_BatchInsert_002, TestSize.Level0)
+{
+    LOG_INFO("DataShareServiceProxy_BatchInsert_002::Start");
+    sptr<DataShareServiceLoopback> service = new DataShareServiceLoopback();
+    DataShareServiceProxy proxy(service);
+    auto values = GetRows(5, 1);
+    values[3] = DataShareValuesBucket();
+    std::vector<int32_t> results;
+    EXPECT_EQ(proxy.BatchInsert(Uri(URI), Uri(""), values, results), E_ERROR);
+    ASSERT_EQ(results.size(), 4);
+    EXPECT_EQ(results.back(), E_ERROR);
+    EXPECT_EQ(service->GetRowCount(), 0);
+    LOG_INFO("DataShareServiceProxy_BatchInsert_002::End");
+}
+
+/**
+ * @tc.name: DataShareServiceProxy_ExecuteBatch_001
+ * @tc.desc: Verify ExecuteBatch returns the result of each statement and applies the statements all or none.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a DataShareServiceProxy on the loopback service.
+    2. Execute two inserts and a delete, then an insert followed by an insert without value.
+ * @tc.expect:
+    1. The first batch succeeds with a result for each statement, and its two rows are stored.
+    2. The second batch fails with EXEC_FAILED, and its first row is not stored.
+ */
+HWTEST_F(DataShareServiceProxyBatchTest, DataShareServiceProxy_ExecuteBatch_001, TestSize.Level0)
+{
+    LOG_INFO("DataShareServiceProxy_ExecuteBatch_001::Start");
+    sptr<DataShareServiceLoopback> service = new DataShareServiceLoopback();
+    DataShareServiceProxy proxy(service);
+    auto values = GetRows(2, 1);
+    std::vector<OperationStatement> statements = { GetStatement(Operation::INSERT, values[0]),
+        GetStatement(Operation::INSERT, values[1]), GetStatement(Operation::DELETE, DataShareValuesBucket()) };
+    ExecResultSet result;
+    EXPECT_EQ(proxy.ExecuteBatch(Uri(""), statements, result), E_OK);
+    EXPECT_EQ(result.errorCode, ExecErrorCode::EXEC_SUCCESS);
+    ASSERT_EQ(result.results.size(), 3);
+    EXPECT_EQ(result.results[2].operationType, Operation::DELETE);
+    EXPECT_EQ(service->GetRowCount(), 2);
+
+    statements = { GetStatement(Operation::INSERT, values[0]),
+        GetStatement(Operation::INSERT, DataShareValuesBucket()) };
+    EXPECT_EQ(proxy.ExecuteBatch(Uri(""), statements, result), E_ERROR);
+    EXPECT_EQ(result.errorCode, ExecErrorCode::EXEC_FAILED);
+    ASSERT_EQ(result.results.size(), 2);
+    EXPECT_EQ(result.results[1].code, E_ERROR);
+    EXPECT_EQ(service->GetRowCount(), 2);
+    LOG_INFO("DataShareServiceProxy_ExecuteBatch_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "rdb_change_dispatcher_test"
+
+#include "rdb_change_dispatcher.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "datashare_errno.h"
+#include "datashare_log.h"
+
+namespace OHOS {
+namespace DataShare {
+using namespace testing::ext;
+class RdbChangeDispatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase(void){};
+    static void TearDownTestCase(void){};
+    void SetUp(){};
+    void TearDown(){};
+};
+
+namespace {
+RdbChangeNode CreateChangeNode(const std::string &uri, const std::string &data)
+{
+    RdbChangeNode changeNode;
+    changeNode.uri_ = uri;
+    changeNode.templateId_ = TemplateId { 1, "com.acts.datasharetest" };
+    changeNode.data_.emplace_back(data);
+    return changeNode;
+}
+
+// Records the delivered changes, the first delivery is held until Release.
+class Receiver {
+public:
+    void OnChange(const RdbChangeNode &changeNode)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        delivered_.push_back(changeNode.data_.empty() ? "" : changeNode.data_[0]);
+        cond_.notify_all();
+        cond_.wait(lock, [this] { return released_; });
+    }
+    void WaitFor(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this, count] { return delivered_.size() >= count; });
+    }
+    void Release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        cond_.notify_all();
+    }
+    std::vector<std::string> GetDelivered()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return delivered_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool released_ = false;
+    std::vector<std::string> delivered_;
+};
+} // namespace
+
+/**
+ * @tc.name: RdbChangeDispatcher_Coalesce_001
+ * @tc.desc: Verify pending changes of the same uri are coalesced so only the latest one is delivered.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Post a change of uri A and hold its delivery.
+    2. Post a change of uri B and two more changes of uri A, then release the delivery.
+ * @tc.expect:
+    1. The changes are delivered as A1, B1, A3.
+    2. One change is counted as coalesced and the queue is empty afterwards.
+ */
+HWTEST_F(RdbChangeDispatcherTest, RdbChangeDispatcher_Coalesce_001, TestSize.Level0)
+{
+    LOG_INFO("RdbChangeDispatcher_Coalesce_001::Start");
+    Receiver receiver;
+    {
+        RdbChangeDispatcher dispatcher([&receiver](const RdbChangeNode &node) { receiver.OnChange(node); });
+        dispatcher.Post(CreateChangeNode("uriA", "A1"));
+        receiver.WaitFor(1);
+        dispatcher.Post(CreateChangeNode("uriB", "B1"));
+        dispatcher.Post(CreateChangeNode("uriA", "A2"));
+        dispatcher.Post(CreateChangeNode("uriA", "A3"));
+        auto statistics = dispatcher.GetStatistics();
+        EXPECT_EQ(statistics.depth, 2);
+        EXPECT_EQ(statistics.coalesced, 1);
+        receiver.Release();
+        receiver.WaitFor(3);
+        while (dispatcher.GetStatistics().delivered < 3) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(dispatcher.GetStatistics().depth, 0);
+    }
+    std::vector<std::string> expected = { "A1", "B1", "A3" };
+    EXPECT_EQ(receiver.GetDelivered(), expected);
+    LOG_INFO("RdbChangeDispatcher_Coalesce_001::End");
+}
+
+/**
+ * @tc.name: RdbChangeDispatcher_DropOldest_001
+ * @tc.desc: Verify the oldest queued change is dropped when the queue is full with DROP_OLDEST.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a dispatcher with DROP_OLDEST and capacity 2, post a change and hold its delivery.
+    2. Post three changes of the same uri, then release the delivery.
+ * @tc.expect: The second change is dropped, the others are delivered in order and nothing is coalesced.
+ */
+HWTEST_F(RdbChangeDispatcherTest, RdbChangeDispatcher_DropOldest_001, TestSize.Level0)
+{
+    LOG_INFO("RdbChangeDispatcher_DropOldest_001::Start");
+    Receiver receiver;
+    {
+        RdbChangeDispatcher dispatcher([&receiver](const RdbChangeNode &node) { receiver.OnChange(node); },
+            RdbChangeDispatcher::DROP_OLDEST, 2);
+        dispatcher.Post(CreateChangeNode("uriA", "A1"));
+        receiver.WaitFor(1);
+        dispatcher.Post(CreateChangeNode("uriA", "A2"));
+        dispatcher.Post(CreateChangeNode("uriA", "A3"));
+        dispatcher.Post(CreateChangeNode("uriA", "A4"));
+        auto statistics = dispatcher.GetStatistics();
+        EXPECT_EQ(statistics.dropped, 1);
+        EXPECT_EQ(statistics.coalesced, 0);
+        EXPECT_EQ(statistics.maxDepth, 2);
+        receiver.Release();
+        receiver.WaitFor(3);
+    }
+    std::vector<std::string> expected = { "A1", "A3", "A4" };
+    EXPECT_EQ(receiver.GetDelivered(), expected);
+    LOG_INFO("RdbChangeDispatcher_DropOldest_001::End");
+}
+
+/**
+ * @tc.name: RdbChangeDispatcher_Block_001
+ * @tc.desc: Verify the sender waits while the queue is full with BLOCK, and no change is lost.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step:
+    1. Create a dispatcher with BLOCK and capacity 1, post a change and hold its delivery.
+    2. Post a second change, then post a third one on another thread.
+    3. Release the delivery.
+ * @tc.expect:
+    1. The third post does not return while the queue is full.
+    2. All changes are delivered in order and none is dropped.
+ */
+HWTEST_F(RdbChangeDispatcherTest, RdbChangeDispatcher_Block_001, TestSize.Level0)
+{
+    LOG_INFO("RdbChangeDispatcher_Block_001::Start");
+    Receiver receiver;
+    {
+        RdbChangeDispatcher dispatcher([&receiver](const RdbChangeNode &node) { receiver.OnChange(node); },
+            RdbChangeDispatcher::BLOCK, 1);
+        dispatcher.Post(CreateChangeNode("uriA", "A1"));
+        receiver.WaitFor(1);
+        dispatcher.Post(CreateChangeNode("uriA", "A2"));
+        std::atomic<bool> posted = false;
+        std::thread sender([&dispatcher, &posted]() {
+            dispatcher.Post(CreateChangeNode("uriA", "A3"));
+            posted = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(posted);
+        receiver.Release();
+        sender.join();
+        receiver.WaitFor(3);
+        EXPECT_EQ(dispatcher.GetStatistics().dropped, 0);
+    }
+    std::vector<std::string> expected = { "A1", "A2", "A3" };
+    EXPECT_EQ(receiver.GetDelivered(), expected);
+    LOG_INFO("RdbChangeDispatcher_Block_001::End");
+}
+
+/**
+ * @tc.name: RdbChangeDispatcher_SetPolicy_001
+ * @tc.desc: Verify an invalid policy or capacity is rejected.
+ * @tc.type: FUNC
+ * @tc.require: None
+ * @tc.precon: None
+ * @tc.step: Call SetPolicy with a zero capacity, an invalid policy and a valid policy.
+ * @tc.expect: Only the valid policy returns E_OK.
+ */
+HWTEST_F(RdbChangeDispatcherTest, RdbChangeDispatcher_SetPolicy_001, TestSize.Level0)
+{
+    LOG_INFO("RdbChangeDispatcher_SetPolicy_001::Start");
+    RdbChangeDispatcher dispatcher([](const RdbChangeNode &) {});
+    EXPECT_EQ(dispatcher.SetPolicy(RdbChangeDispatcher::COALESCE, 0), E_ERROR);
+    EXPECT_EQ(dispatcher.SetPolicy(RdbChangeDispatcher::POLICY_BUTT, 1), E_ERROR);
+    EXPECT_EQ(dispatcher.SetPolicy(RdbChangeDispatcher::BLOCK, 1), E_OK);
+    LOG_INFO("RdbChangeDispatcher_SetPolicy_001::End");
+}
+} // namespace DataShare
+} // namespace OHOS